@@ -57,6 +57,7 @@
 #include "rx/msp.h"
 #include "telemetry/telemetry.h"
 #include "flight/mixer.h"
+#include "sensors/esc_telemetry.h"
 #include "flight/altitudehold.h"
 #include "flight/failsafe.h"
 #include "flight/imu.h"
@@ -67,10 +68,16 @@
 #include "config/config_master.h"
 #include "blackbox.h"
 #include "blackbox_io.h"
+#include "blackbox_burst.h"
 #include "debug.h"
 #define BLACKBOX_I_INTERVAL 32
 #define BLACKBOX_SHUTDOWN_TIMEOUT_MILLIS 200
 #define SLOW_FRAME_INTERVAL 4096
+#ifdef STM32F10X
+#define BLACKBOX_CAPTURE_RING_SIZE 4
+#else
+#define BLACKBOX_CAPTURE_RING_SIZE 16
+#endif
 #define ARRAY_LENGTH(x) (sizeof((x))/sizeof((x)[0]))
 #define STATIC_ASSERT(condition,name) \
     typedef char assert_failed_ ## name [(condition) ? 1 : -1 ]
@@ -80,10 +87,12 @@
 #define UNSIGNED FLIGHT_LOG_FIELD_UNSIGNED
 #define SIGNED FLIGHT_LOG_FIELD_SIGNED
 uint32_t hidden_denom = 1;
-static const char blackboxHeader[] =
-    "H Product:Blackbox flight data recorder by Nicholas Sherlock\n"
-    "H Data version:2\n"
-    "H I interval:" STR(BLACKBOX_I_INTERVAL) "\n";
+#define BLACKBOX_HEADER(dataVersion) \
+    "H Product:Blackbox flight data recorder by Nicholas Sherlock\n" \
+    "H Data version:" dataVersion "\n" \
+    "H I interval:" STR(BLACKBOX_I_INTERVAL) "\n"
+static const char blackboxHeader[] = BLACKBOX_HEADER("2");
+static const char blackboxRiceHeader[] = BLACKBOX_HEADER("3");
 static const char* const blackboxFieldHeaderNames[] = {
     "name",
     "signed",
@@ -137,6 +146,9 @@ static const blackboxDeltaFieldDefinition_t blackboxMainFields[] = {
     {"axisD", 0, SIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(NONZERO_PID_D_0)},
     {"axisD", 1, SIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(NONZERO_PID_D_1)},
     {"axisD", 2, SIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(NONZERO_PID_D_2)},
+    {"axisF", 0, SIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(NONZERO_PID_F_0)},
+    {"axisF", 1, SIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(NONZERO_PID_F_1)},
+    {"axisF", 2, SIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(NONZERO_PID_F_2)},
     {"rcCommand", 0, SIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
     {"rcCommand", 1, SIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
     {"rcCommand", 2, SIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(TAG8_4S16), CONDITION(ALWAYS)},
@@ -172,7 +184,12 @@ static const blackboxDeltaFieldDefinition_t blackboxMainFields[] = {
     {"motor", 5, UNSIGNED, .Ipredict = PREDICT(MOTOR_0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(AVERAGE_2), .Pencode = ENCODING(SIGNED_VB), CONDITION(AT_LEAST_MOTORS_6)},
     {"motor", 6, UNSIGNED, .Ipredict = PREDICT(MOTOR_0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(AVERAGE_2), .Pencode = ENCODING(SIGNED_VB), CONDITION(AT_LEAST_MOTORS_7)},
     {"motor", 7, UNSIGNED, .Ipredict = PREDICT(MOTOR_0), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(AVERAGE_2), .Pencode = ENCODING(SIGNED_VB), CONDITION(AT_LEAST_MOTORS_8)},
-    {"servo", 5, UNSIGNED, .Ipredict = PREDICT(1500), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(TRICOPTER)}
+    {"escERPM", 0, UNSIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(ESC_ERPM_0)},
+    {"escERPM", 1, UNSIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(ESC_ERPM_1)},
+    {"escERPM", 2, UNSIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(ESC_ERPM_2)},
+    {"escERPM", 3, UNSIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(ESC_ERPM_3)},
+    {"servo", 5, UNSIGNED, .Ipredict = PREDICT(1500), .Iencode = ENCODING(SIGNED_VB), .Ppredict = PREDICT(PREVIOUS), .Pencode = ENCODING(SIGNED_VB), CONDITION(TRICOPTER)},
+    {"groupUpdated", -1, UNSIGNED, .Ipredict = PREDICT(0), .Iencode = ENCODING(UNSIGNED_VB), .Ppredict = PREDICT(0), .Pencode = ENCODING(UNSIGNED_VB), CONDITION(GROUP_RATES)}
 };
 #ifdef GPS
 static const blackboxConditionalFieldDefinition_t blackboxGpsGFields[] = {
@@ -194,7 +211,12 @@ static const blackboxSimpleFieldDefinition_t blackboxSlowFields[] = {
     {"stateFlags", -1, UNSIGNED, PREDICT(0), ENCODING(UNSIGNED_VB)},
     {"failsafePhase", -1, UNSIGNED, PREDICT(0), ENCODING(TAG2_3S32)},
     {"rxSignalReceived", -1, UNSIGNED, PREDICT(0), ENCODING(TAG2_3S32)},
-    {"rxFlightChannelsValid", -1, UNSIGNED, PREDICT(0), ENCODING(TAG2_3S32)}
+    {"rxFlightChannelsValid", -1, UNSIGNED, PREDICT(0), ENCODING(TAG2_3S32)},
+    {"rxFrameInterval", -1, UNSIGNED, PREDICT(0), ENCODING(UNSIGNED_VB)},
+    {"rxFrameJitter", -1, UNSIGNED, PREDICT(0), ENCODING(UNSIGNED_VB)},
+    {"rxFrameDrops", -1, UNSIGNED, PREDICT(0), ENCODING(UNSIGNED_VB)},
+    {"rxLatency", -1, UNSIGNED, PREDICT(0), ENCODING(UNSIGNED_VB)},
+    {"blackboxDrops", -1, UNSIGNED, PREDICT(0), ENCODING(UNSIGNED_VB)}
 };
 typedef enum BlackboxState {
     BLACKBOX_STATE_DISABLED = 0,
@@ -207,18 +229,21 @@ typedef enum BlackboxState {
     BLACKBOX_STATE_SEND_SYSINFO,
     BLACKBOX_STATE_PAUSED,
     BLACKBOX_STATE_RUNNING,
-    BLACKBOX_STATE_SHUTTING_DOWN
+    BLACKBOX_STATE_SHUTTING_DOWN,
+    BLACKBOX_STATE_SEND_BURST_HEADER,
+    BLACKBOX_STATE_SEND_BURST
 } BlackboxState;
 #define BLACKBOX_FIRST_HEADER_SENDING_STATE BLACKBOX_STATE_SEND_HEADER
 #define BLACKBOX_LAST_HEADER_SENDING_STATE BLACKBOX_STATE_SEND_SYSINFO
 typedef struct blackboxMainState_s {
     uint32_t time;
-    int32_t axisPID_P[XYZ_AXIS_COUNT], axisPID_I[XYZ_AXIS_COUNT], axisPID_D[XYZ_AXIS_COUNT];
+    int32_t axisPID_P[XYZ_AXIS_COUNT], axisPID_I[XYZ_AXIS_COUNT], axisPID_D[XYZ_AXIS_COUNT], axisPID_F[XYZ_AXIS_COUNT];
     int16_t rcCommand[4];
     int16_t gyroADC[XYZ_AXIS_COUNT];
     int16_t accSmooth[XYZ_AXIS_COUNT];
     int16_t debug[3];
     int16_t motor[MAX_SUPPORTED_MOTORS];
+    uint16_t escErpm[4];
     int16_t servo[MAX_SUPPORTED_SERVOS];
     uint16_t vbatLatest;
     uint16_t amperageLatest;
@@ -232,7 +257,21 @@ typedef struct blackboxMainState_s {
     int32_t sonarRaw;
 #endif
     uint16_t rssi;
+    uint8_t groupUpdated;
 } blackboxMainState_t;
+typedef struct blackboxCaptureEntry_s {
+    blackboxMainState_t state;
+    uint32_t iteration;
+    uint16_t pFrameIndex;
+    uint16_t iFrameIndex;
+    bool resync;
+} blackboxCaptureEntry_t;
+typedef enum {
+    BLACKBOX_GROUP_PID = 0,
+    BLACKBOX_GROUP_RC,
+    BLACKBOX_GROUP_BATTERY,
+    BLACKBOX_GROUP_COUNT
+} blackboxFieldGroup_e;
 typedef struct blackboxGpsState_s {
     int32_t GPS_home[2], GPS_coord[2];
     uint8_t GPS_numSat;
@@ -267,8 +306,19 @@ static blackboxSlowState_t slowHistory;
 static blackboxMainState_t blackboxHistoryRing[3];
 static blackboxMainState_t* blackboxHistory[3];
 static bool blackboxModeActivationConditionPresent = false;
+static bool blackboxLogAfterBurst = false;
+#define BLACKBOX_RICE_FIELD_COUNT (XYZ_AXIS_COUNT + XYZ_AXIS_COUNT + 3 + MAX_SUPPORTED_MOTORS)
+static blackboxRiceState_t blackboxRiceState[BLACKBOX_RICE_FIELD_COUNT];
+static bool blackboxEntropyCoded = false;
+static blackboxCaptureEntry_t blackboxCaptureRing[BLACKBOX_CAPTURE_RING_SIZE];
+static volatile uint8_t blackboxCaptureHead;
+static volatile uint8_t blackboxCaptureTail;
+static bool blackboxCaptureResync;
+uint32_t blackboxCaptureDrops;
+static uint32_t blackboxGroupNextDue[BLACKBOX_GROUP_COUNT];
+static blackboxMainState_t blackboxHeldState;
 static bool blackboxIsOnlyLoggingIntraframes() {
-    return masterConfig.blackbox_rate_num == 1 && masterConfig.blackbox_rate_denom == 32;
+    return (masterConfig.blackbox_rate_num == 1 && masterConfig.blackbox_rate_denom == 32) || hidden_denom >= BLACKBOX_I_INTERVAL;
 }
 static bool testBlackboxConditionUncached(FlightLogFieldCondition condition)
 {
@@ -294,6 +344,17 @@ static bool testBlackboxConditionUncached(FlightLogFieldCondition condition)
             } else {
                 return currentProfile->pidProfile.D8[condition - FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_D_0] != 0;
             }
+        case FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_F_0:
+        case FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_F_1:
+        case FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_F_2:
+            return currentProfile->pidProfile.F_f[condition - FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_F_0] != 0;
+        case FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_0:
+        case FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_1:
+        case FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_2:
+        case FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_3:
+            return escTelemetryIsEnabled() && motorCount > condition - FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_0;
+        case FLIGHT_LOG_FIELD_CONDITION_GROUP_RATES:
+            return masterConfig.blackbox_pid_hz || masterConfig.blackbox_rc_hz || masterConfig.blackbox_batt_hz;
         case FLIGHT_LOG_FIELD_CONDITION_MAG:
 #ifdef MAG
             return sensors(SENSOR_MAG);
@@ -356,6 +417,8 @@ static void blackboxSetState(BlackboxState newState)
             xmitState.u.fieldIndex = -1;
         break;
         case BLACKBOX_STATE_SEND_SYSINFO:
+        case BLACKBOX_STATE_SEND_BURST_HEADER:
+        case BLACKBOX_STATE_SEND_BURST:
             xmitState.headerIndex = 0;
         break;
         case BLACKBOX_STATE_RUNNING:
@@ -370,12 +433,15 @@ static void blackboxSetState(BlackboxState newState)
     }
     blackboxState = newState;
 }
-static void writeIntraframe(void)
+static void writeIntraframe(uint32_t iteration)
 {
     blackboxMainState_t *blackboxCurrent = blackboxHistory[0];
     int x;
     blackboxWrite('I');
-    blackboxWriteUnsignedVB(blackboxIteration);
+    if (blackboxEntropyCoded) {
+        blackboxRiceReset(blackboxRiceState, BLACKBOX_RICE_FIELD_COUNT);
+    }
+    blackboxWriteUnsignedVB(iteration);
     blackboxWriteUnsignedVB(blackboxCurrent->time);
     blackboxWriteSignedVBArray(blackboxCurrent->axisPID_P, XYZ_AXIS_COUNT);
     blackboxWriteSignedVBArray(blackboxCurrent->axisPID_I, XYZ_AXIS_COUNT);
@@ -384,6 +450,11 @@ static void writeIntraframe(void)
             blackboxWriteSignedVB(blackboxCurrent->axisPID_D[x]);
         }
     }
+    for (x = 0; x < XYZ_AXIS_COUNT; x++) {
+        if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_F_0 + x)) {
+            blackboxWriteSignedVB(blackboxCurrent->axisPID_F[x]);
+        }
+    }
     blackboxWriteSigned16VBArray(blackboxCurrent->rcCommand, 3);
     blackboxWriteUnsignedVB(blackboxCurrent->rcCommand[THROTTLE] - masterConfig.escAndServoConfig.minthrottle);
     if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_VBAT)) {
@@ -417,21 +488,33 @@ static void writeIntraframe(void)
     for (x = 1; x < motorCount; x++) {
         blackboxWriteSignedVB(blackboxCurrent->motor[x] - blackboxCurrent->motor[0]);
     }
+    for (x = 0; x < 4; x++) {
+        if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_0 + x)) {
+            blackboxWriteUnsignedVB(blackboxCurrent->escErpm[x]);
+        }
+    }
     if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_TRICOPTER)) {
         blackboxWriteSignedVB(blackboxCurrent->servo[5] - 1500);
     }
+    if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_GROUP_RATES)) {
+        blackboxWriteUnsignedVB(blackboxCurrent->groupUpdated);
+    }
     blackboxHistory[1] = blackboxHistory[0];
     blackboxHistory[2] = blackboxHistory[0];
     blackboxHistory[0] = ((blackboxHistory[0] - blackboxHistoryRing + 1) % 3) + blackboxHistoryRing;
 }
-static void blackboxWriteMainStateArrayUsingAveragePredictor(int arrOffsetInHistory, int count)
+static void blackboxWriteMainStateArrayUsingAveragePredictor(int arrOffsetInHistory, int count, blackboxRiceState_t *rice)
 {
     int16_t *curr = (int16_t*) ((char*) (blackboxHistory[0]) + arrOffsetInHistory);
     int16_t *prev1 = (int16_t*) ((char*) (blackboxHistory[1]) + arrOffsetInHistory);
     int16_t *prev2 = (int16_t*) ((char*) (blackboxHistory[2]) + arrOffsetInHistory);
     for (int i = 0; i < count; i++) {
         int32_t predictor = (prev1[i] + prev2[i]) / 2;
-        blackboxWriteSignedVB(curr[i] - predictor);
+        if (rice) {
+            blackboxWriteRiceSigned(curr[i] - predictor, &rice[i]);
+        } else {
+            blackboxWriteSignedVB(curr[i] - predictor);
+        }
     }
 }
 static void writeInterframe(void)
@@ -451,6 +534,11 @@ static void writeInterframe(void)
             blackboxWriteSignedVB(blackboxCurrent->axisPID_D[x] - blackboxLast->axisPID_D[x]);
         }
     }
+    for (x = 0; x < XYZ_AXIS_COUNT; x++) {
+        if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_F_0 + x)) {
+            blackboxWriteSignedVB(blackboxCurrent->axisPID_F[x] - blackboxLast->axisPID_F[x]);
+        }
+    }
     for (x = 0; x < 4; x++) {
         deltas[x] = blackboxCurrent->rcCommand[x] - blackboxLast->rcCommand[x];
     }
@@ -483,13 +571,25 @@ static void writeInterframe(void)
         deltas[optionalFieldCount++] = (int32_t) blackboxCurrent->rssi - blackboxLast->rssi;
     }
     blackboxWriteTag8_8SVB(deltas, optionalFieldCount);
-    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, gyroADC), XYZ_AXIS_COUNT);
-    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, accSmooth), XYZ_AXIS_COUNT);
-    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, debug), 3);
-    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, motor), motorCount);
+    blackboxRiceState_t *rice = blackboxEntropyCoded ? blackboxRiceState : NULL;
+    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, gyroADC), XYZ_AXIS_COUNT, rice);
+    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, accSmooth), XYZ_AXIS_COUNT, rice ? rice + 3 : NULL);
+    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, debug), 3, rice ? rice + 6 : NULL);
+    blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, motor), motorCount, rice ? rice + 9 : NULL);
+    if (rice) {
+        blackboxRiceFlush();
+    }
+    for (x = 0; x < 4; x++) {
+        if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_0 + x)) {
+            blackboxWriteSignedVB((int32_t) blackboxCurrent->escErpm[x] - blackboxLast->escErpm[x]);
+        }
+    }
     if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_TRICOPTER)) {
         blackboxWriteSignedVB(blackboxCurrent->servo[5] - blackboxLast->servo[5]);
     }
+    if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_GROUP_RATES)) {
+        blackboxWriteUnsignedVB(blackboxCurrent->groupUpdated);
+    }
     blackboxHistory[2] = blackboxHistory[1];
     blackboxHistory[1] = blackboxHistory[0];
     blackboxHistory[0] = ((blackboxHistory[0] - blackboxHistoryRing + 1) % 3) + blackboxHistoryRing;
@@ -504,6 +604,11 @@ static void writeSlowFrame(void)
     values[1] = slowHistory.rxSignalReceived ? 1 : 0;
     values[2] = slowHistory.rxFlightChannelsValid ? 1 : 0;
     blackboxWriteTag2_3S32(values);
+    blackboxWriteUnsignedVB(rxFrameStats.interval);
+    blackboxWriteUnsignedVB(rxFrameStats.jitter);
+    blackboxWriteUnsignedVB(rxFrameStats.droppedFrames);
+    blackboxWriteUnsignedVB(rxFrameStats.latency);
+    blackboxWriteUnsignedVB(blackboxCaptureDrops);
     blackboxSlowFrameIterationTimer = 0;
 }
 static void loadSlowState(blackboxSlowState_t *slow)
@@ -531,14 +636,19 @@ static void writeSlowFrameIfNeeded(bool allowPeriodicWrite)
         writeSlowFrame();
     }
 }
-static void validateBlackboxConfig()
+STATIC_UNIT_TESTED void validateBlackboxConfig(void)
 {
     if (masterConfig.blackbox_rate_num == 0 || masterConfig.blackbox_rate_denom == 0
             || masterConfig.blackbox_rate_num >= masterConfig.blackbox_rate_denom) {
         masterConfig.blackbox_rate_num = 1;
         masterConfig.blackbox_rate_denom = 1;
     }
-    hidden_denom = 8;
+    if (masterConfig.blackbox_rate_hz) {
+        const uint32_t period = masterConfig.blackbox_rate_hz * MAX(targetESCwritetime, 1);
+        hidden_denom = constrain((1000000 + period / 2) / period, 1, BLACKBOX_I_INTERVAL);
+    } else {
+        hidden_denom = 8;
+    }
     masterConfig.blackbox_rate_num = 1;
     if (masterConfig.blackbox_device >= BLACKBOX_DEVICE_END) {
         masterConfig.blackbox_device = BLACKBOX_DEVICE_SERIAL;
@@ -546,9 +656,10 @@ static void validateBlackboxConfig()
 }
 void startBlackbox(void)
 {
-    if (blackboxState == BLACKBOX_STATE_STOPPED) {
+    const bool burstInProgress = blackboxState == BLACKBOX_STATE_SEND_BURST_HEADER || blackboxState == BLACKBOX_STATE_SEND_BURST;
+    if (blackboxState == BLACKBOX_STATE_STOPPED || burstInProgress) {
         validateBlackboxConfig();
-        if (!blackboxDeviceOpen()) {
+        if (!burstInProgress && !blackboxDeviceOpen()) {
             blackboxSetState(BLACKBOX_STATE_DISABLED);
             return;
         }
@@ -558,16 +669,35 @@ void startBlackbox(void)
         blackboxHistory[2] = &blackboxHistoryRing[2];
         vbatReference = vbatLatestADC;
         blackboxBuildConditionCache();
+        blackboxEntropyCoded = masterConfig.blackbox_encoding == BLACKBOX_ENCODING_RICE;
         blackboxModeActivationConditionPresent = isModeActivationConditionPresent(currentProfile->modeActivationConditions, BOXBLACKBOX);
         blackboxIteration = 0;
         blackboxPFrameIndex = 0;
         blackboxIFrameIndex = 0;
+        blackboxCaptureHead = 0;
+        blackboxCaptureTail = 0;
+        blackboxCaptureResync = false;
+        blackboxCaptureDrops = 0;
+        for (int i = 0; i < BLACKBOX_GROUP_COUNT; i++) {
+            blackboxGroupNextDue[i] = micros();
+        }
         blackboxLastArmingBeep = getArmingBeepTimeMicros();
-        blackboxSetState(BLACKBOX_STATE_SEND_HEADER);
+        blackboxBurstTrigger(BLACKBOX_TRIGGER_ARM);
+        blackboxLogAfterBurst = true;
+        if (burstInProgress) {
+            return;
+        }
+        if (blackboxBurst.state == BLACKBOX_BURST_PENDING) {
+            blackboxHeaderBudget = 0;
+            blackboxSetState(BLACKBOX_STATE_SEND_BURST_HEADER);
+        } else {
+            blackboxSetState(BLACKBOX_STATE_SEND_HEADER);
+        }
     }
 }
 void finishBlackbox(void)
 {
+    blackboxBurstTrigger(BLACKBOX_TRIGGER_DISARM);
     if (blackboxState == BLACKBOX_STATE_RUNNING || blackboxState == BLACKBOX_STATE_PAUSED) {
         blackboxLogEvent(FLIGHT_LOG_EVENT_LOG_END, NULL);
         blackboxSetState(BLACKBOX_STATE_SHUTTING_DOWN);
@@ -603,9 +733,8 @@ static void writeGPSFrame()
     gpsHistory.GPS_coord[1] = GPS_coord[1];
 }
 #endif
-static void loadMainState(void)
+static void loadMainState(blackboxMainState_t *blackboxCurrent)
 {
-    blackboxMainState_t *blackboxCurrent = blackboxHistory[0];
     int i;
     blackboxCurrent->time = currentTime;
     for (i = 0; i < XYZ_AXIS_COUNT; i++) {
@@ -617,6 +746,9 @@ static void loadMainState(void)
     for (i = 0; i < XYZ_AXIS_COUNT; i++) {
         blackboxCurrent->axisPID_D[i] = axisPID_D[i];
     }
+    for (i = 0; i < XYZ_AXIS_COUNT; i++) {
+        blackboxCurrent->axisPID_F[i] = axisPID_F[i];
+    }
     if (masterConfig.rxConfig.rcSmoothing) {
   for (i = 0; i < 4; i++) {
    blackboxCurrent->rcCommand[i] = rcCommandUsed[i];
@@ -638,6 +770,9 @@ static void loadMainState(void)
     for (i = 0; i < motorCount; i++) {
         blackboxCurrent->motor[i] = motor[i];
     }
+    for (i = 0; i < 4 && i < motorCount; i++) {
+        blackboxCurrent->escErpm[i] = escTelemetry.esc[i].erpm;
+    }
     blackboxCurrent->vbatLatest = vbatLatestADC;
     blackboxCurrent->amperageLatest = amperageLatestADC;
 #ifdef MAG
@@ -706,7 +841,11 @@ static bool sendFieldDefinition(char mainFrameChar, char deltaFrameChar, const v
                     blackboxPrintf("[%d]", def->fieldNameIndex);
                 }
             } else {
-                blackboxPrintf("%d", def->arr[xmitState.headerIndex - 1]);
+                if (blackboxEntropyCoded && xmitState.headerIndex == 5 && def->arr[3] == PREDICT(AVERAGE_2)) {
+                    blackboxPrintf("%d", ENCODING(ADAPTIVE_RICE));
+                } else {
+                    blackboxPrintf("%d", def->arr[xmitState.headerIndex - 1]);
+                }
             }
         }
     }
@@ -734,7 +873,11 @@ static bool blackboxWriteSysinfo()
             blackboxPrintfHeaderLine("Firmware date:%s %s", buildDate, buildTime);
         break;
         case 3:
-            blackboxPrintfHeaderLine("P interval:%d/%d", masterConfig.blackbox_rate_num, masterConfig.blackbox_rate_denom);
+            if (masterConfig.blackbox_rate_hz) {
+                blackboxPrintfHeaderLine("P interval:1/%d", hidden_denom);
+            } else {
+                blackboxPrintfHeaderLine("P interval:%d/%d", masterConfig.blackbox_rate_num, masterConfig.blackbox_rate_denom);
+            }
         break;
         case 4:
             blackboxPrintfHeaderLine("rcRate:%d", 100);
@@ -770,12 +913,78 @@ static bool blackboxWriteSysinfo()
                 blackboxPrintfHeaderLine("currentMeter:%d,%d", masterConfig.batteryConfig.currentMeterOffset, masterConfig.batteryConfig.currentMeterScale);
             }
         break;
+        case 13:
+            if (masterConfig.blackbox_rate_hz || masterConfig.blackbox_pid_hz || masterConfig.blackbox_rc_hz || masterConfig.blackbox_batt_hz) {
+                blackboxPrintfHeaderLine("Log rate hz:%u,%u,%u,%u", masterConfig.blackbox_rate_hz, masterConfig.blackbox_pid_hz,
+                    masterConfig.blackbox_rc_hz, masterConfig.blackbox_batt_hz);
+            }
+        break;
         default:
             return true;
     }
     xmitState.headerIndex++;
     return false;
 }
+static bool blackboxWriteBurstHeader(void)
+{
+    if (blackboxDeviceReserveBufferSpace(64) != BLACKBOX_RESERVE_SUCCESS) {
+        return false;
+    }
+    switch (xmitState.headerIndex) {
+        case 0:
+            blackboxPrintfHeaderLine("Product:Blackbox burst capture");
+        break;
+        case 1:
+            blackboxPrintfHeaderLine("Firmware revision:%s", shortGitRevision);
+        break;
+        case 2:
+            blackboxPrintfHeaderLine("Burst trigger:0x%x", blackboxBurst.trigger);
+        break;
+        case 3:
+            blackboxPrintfHeaderLine("Burst samples:%u", blackboxBurst.samples);
+        break;
+        case 4:
+            blackboxPrintfHeaderLine("Burst duration:%u", blackboxBurst.duration);
+        break;
+        case 5:
+            blackboxPrintfHeaderLine("Burst pretrigger:%u", blackboxBurst.pretrigger);
+        break;
+        case 6:
+            blackboxPrintfHeaderLine("Burst fields:gyroRaw,gyroADC,motor,rcCommand,accSmooth");
+        break;
+        case 7:
+            blackboxPrintfHeaderLine("Burst motors:%u", blackboxBurst.motorCount);
+        break;
+        case 8:
+            blackboxPrintfHeaderLine("Burst keyframe interval:%u", BLACKBOX_BURST_KEYFRAME_INTERVAL);
+        break;
+        case 9:
+            blackboxPrintfHeaderLine("Burst length:%u", blackboxBurst.head - blackboxBurst.tail);
+        break;
+        case 10:
+            blackboxPrintfHeaderLine("gyro.scale:0x%x", castFloatBytesToInt(gyro.scale));
+        break;
+        case 11:
+            blackboxPrintfHeaderLine("acc_1G:%u", acc_1G);
+        break;
+        default:
+            return true;
+    }
+    xmitState.headerIndex++;
+    return false;
+}
+static void blackboxWriteBurst(void)
+{
+    const uint32_t length = blackboxBurst.head - blackboxBurst.tail;
+    while (blackboxHeaderBudget > 0 && xmitState.headerIndex < length) {
+        blackboxWrite(blackboxBurstRead(xmitState.headerIndex++));
+        blackboxHeaderBudget--;
+    }
+    if (xmitState.headerIndex >= length) {
+        blackboxBurstRelease();
+        blackboxSetState(blackboxLogAfterBurst ? BLACKBOX_STATE_SEND_HEADER : BLACKBOX_STATE_SHUTTING_DOWN);
+    }
+}
 void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data)
 {
     if (!(blackboxState == BLACKBOX_STATE_RUNNING || blackboxState == BLACKBOX_STATE_PAUSED)) {
@@ -826,6 +1035,47 @@ static bool blackboxShouldLogPFrame(uint32_t pFrameIndex)
 static bool blackboxShouldLogIFrame() {
     return blackboxPFrameIndex == 0;
 }
+STATIC_UNIT_TESTED bool blackboxGroupDue(uint32_t *nextDue, uint16_t hz, uint32_t now)
+{
+    if (hz == 0) {
+        return true;
+    }
+    if ((int32_t)(now - *nextDue) < 0) {
+        return false;
+    }
+    *nextDue += 1000000 / hz;
+    if ((int32_t)(now - *nextDue) >= 0) {
+        *nextDue = now + 1000000 / hz;
+    }
+    return true;
+}
+static void blackboxHoldField(void *field, void *held, size_t size, bool due)
+{
+    if (due) {
+        memcpy(held, field, size);
+    } else {
+        memcpy(field, held, size);
+    }
+}
+// Every frame still carries every group; a group that is not due repeats its held
+// values (a zero delta in P frames) and its bit in groupUpdated is left clear.
+static void blackboxApplyGroupRates(blackboxMainState_t *state)
+{
+    bool due = blackboxGroupDue(&blackboxGroupNextDue[BLACKBOX_GROUP_PID], masterConfig.blackbox_pid_hz, state->time);
+    state->groupUpdated = due << BLACKBOX_GROUP_PID;
+    blackboxHoldField(state->axisPID_P, blackboxHeldState.axisPID_P, sizeof(state->axisPID_P), due);
+    blackboxHoldField(state->axisPID_I, blackboxHeldState.axisPID_I, sizeof(state->axisPID_I), due);
+    blackboxHoldField(state->axisPID_D, blackboxHeldState.axisPID_D, sizeof(state->axisPID_D), due);
+    blackboxHoldField(state->axisPID_F, blackboxHeldState.axisPID_F, sizeof(state->axisPID_F), due);
+    due = blackboxGroupDue(&blackboxGroupNextDue[BLACKBOX_GROUP_RC], masterConfig.blackbox_rc_hz, state->time);
+    state->groupUpdated |= due << BLACKBOX_GROUP_RC;
+    blackboxHoldField(state->rcCommand, blackboxHeldState.rcCommand, sizeof(state->rcCommand), due);
+    due = blackboxGroupDue(&blackboxGroupNextDue[BLACKBOX_GROUP_BATTERY], masterConfig.blackbox_batt_hz, state->time);
+    state->groupUpdated |= due << BLACKBOX_GROUP_BATTERY;
+    blackboxHoldField(&state->vbatLatest, &blackboxHeldState.vbatLatest, sizeof(state->vbatLatest), due);
+    blackboxHoldField(&state->amperageLatest, &blackboxHeldState.amperageLatest, sizeof(state->amperageLatest), due);
+    blackboxHoldField(&state->rssi, &blackboxHeldState.rssi, sizeof(state->rssi), due);
+}
 static void blackboxAdvanceIterationTimers()
 {
     blackboxSlowFrameIterationTimer++;
@@ -836,23 +1086,21 @@ static void blackboxAdvanceIterationTimers()
         blackboxIFrameIndex++;
     }
 }
-static void blackboxLogIteration()
+static void blackboxLogIteration(const blackboxCaptureEntry_t *entry)
 {
-    if (blackboxShouldLogIFrame()) {
+    if (entry->pFrameIndex == 0 || entry->resync) {
         writeSlowFrameIfNeeded(blackboxIsOnlyLoggingIntraframes());
-        loadMainState();
-        writeIntraframe();
+        memcpy(blackboxHistory[0], &entry->state, sizeof(blackboxMainState_t));
+        writeIntraframe(entry->iteration);
     } else {
         blackboxCheckAndLogArmingBeep();
-        if (blackboxShouldLogPFrame(blackboxPFrameIndex)) {
-            writeSlowFrameIfNeeded(true);
-            loadMainState();
-            writeInterframe();
-        }
+        writeSlowFrameIfNeeded(true);
+        memcpy(blackboxHistory[0], &entry->state, sizeof(blackboxMainState_t));
+        writeInterframe();
 #ifdef GPS
         if (feature(FEATURE_GPS)) {
             if (GPS_home[0] != gpsHistory.GPS_home[0] || GPS_home[1] != gpsHistory.GPS_home[1]
-                || (blackboxPFrameIndex == BLACKBOX_I_INTERVAL / 2 && blackboxIFrameIndex % 128 == 0)) {
+                || (entry->pFrameIndex == BLACKBOX_I_INTERVAL / 2 && entry->iFrameIndex % 128 == 0)) {
                 writeGPSHomeFrame();
                 writeGPSFrame();
             } else if (GPS_numSat != gpsHistory.GPS_numSat || GPS_coord[0] != gpsHistory.GPS_coord[0]
@@ -864,21 +1112,78 @@ static void blackboxLogIteration()
     }
     blackboxDeviceFlush();
 }
+void blackboxCapture(void)
+{
+    if (blackboxState != BLACKBOX_STATE_RUNNING && blackboxState != BLACKBOX_STATE_PAUSED) {
+        return;
+    }
+    if (blackboxShouldLogIFrame() || blackboxShouldLogPFrame(blackboxPFrameIndex)) {
+        const uint8_t head = blackboxCaptureHead;
+        const uint8_t next = (head + 1) % BLACKBOX_CAPTURE_RING_SIZE;
+        if (next == blackboxCaptureTail) {
+            blackboxCaptureDrops++;
+            blackboxCaptureResync = true;
+        } else {
+            blackboxCaptureEntry_t *entry = &blackboxCaptureRing[head];
+            loadMainState(&entry->state);
+            blackboxApplyGroupRates(&entry->state);
+            entry->iteration = blackboxIteration;
+            entry->pFrameIndex = blackboxPFrameIndex;
+            entry->iFrameIndex = blackboxIFrameIndex;
+            entry->resync = blackboxCaptureResync;
+            blackboxCaptureResync = false;
+            __asm volatile ("" ::: "memory");
+            blackboxCaptureHead = next;
+        }
+    }
+    blackboxAdvanceIterationTimers();
+}
+static void blackboxDrainCaptureRing(void)
+{
+    while (blackboxCaptureTail != blackboxCaptureHead
+            && (blackboxState == BLACKBOX_STATE_RUNNING || blackboxState == BLACKBOX_STATE_PAUSED)) {
+        const blackboxCaptureEntry_t *entry = &blackboxCaptureRing[blackboxCaptureTail];
+        if (blackboxState == BLACKBOX_STATE_PAUSED) {
+            if (IS_RC_MODE_ACTIVE(BOXBLACKBOX) && entry->pFrameIndex == 0) {
+                flightLogEvent_loggingResume_t resume;
+                resume.logIteration = entry->iteration;
+                resume.currentTime = entry->state.time;
+                blackboxLogEvent(FLIGHT_LOG_EVENT_LOGGING_RESUME, (flightLogEventData_t *) &resume);
+                blackboxSetState(BLACKBOX_STATE_RUNNING);
+                blackboxLogIteration(entry);
+            }
+        } else if (blackboxModeActivationConditionPresent && !IS_RC_MODE_ACTIVE(BOXBLACKBOX)) {
+            blackboxSetState(BLACKBOX_STATE_PAUSED);
+        } else {
+            blackboxLogIteration(entry);
+        }
+        blackboxCaptureTail = (blackboxCaptureTail + 1) % BLACKBOX_CAPTURE_RING_SIZE;
+    }
+}
 void handleBlackbox(void)
 {
     int i;
-    if (blackboxState >= BLACKBOX_FIRST_HEADER_SENDING_STATE && blackboxState <= BLACKBOX_LAST_HEADER_SENDING_STATE) {
+    if ((blackboxState >= BLACKBOX_FIRST_HEADER_SENDING_STATE && blackboxState <= BLACKBOX_LAST_HEADER_SENDING_STATE)
+            || blackboxState >= BLACKBOX_STATE_SEND_BURST_HEADER) {
         blackboxReplenishHeaderBudget();
     }
     switch (blackboxState) {
+        case BLACKBOX_STATE_STOPPED:
+            if (blackboxBurst.state == BLACKBOX_BURST_PENDING && !ARMING_FLAG(ARMED) && blackboxDeviceOpen()) {
+                blackboxLogAfterBurst = false;
+                blackboxHeaderBudget = 0;
+                blackboxSetState(BLACKBOX_STATE_SEND_BURST_HEADER);
+            }
+        break;
         case BLACKBOX_STATE_SEND_HEADER:
             if (millis() > xmitState.u.startTime + 100) {
                 if (blackboxDeviceReserveBufferSpace(BLACKBOX_TARGET_HEADER_BUDGET_PER_ITERATION) == BLACKBOX_RESERVE_SUCCESS) {
-                    for (i = 0; i < BLACKBOX_TARGET_HEADER_BUDGET_PER_ITERATION && blackboxHeader[xmitState.headerIndex] != '\0'; i++, xmitState.headerIndex++) {
-                        blackboxWrite(blackboxHeader[xmitState.headerIndex]);
+                    const char *header = blackboxEntropyCoded ? blackboxRiceHeader : blackboxHeader;
+                    for (i = 0; i < BLACKBOX_TARGET_HEADER_BUDGET_PER_ITERATION && header[xmitState.headerIndex] != '\0'; i++, xmitState.headerIndex++) {
+                        blackboxWrite(header[xmitState.headerIndex]);
                         blackboxHeaderBudget--;
                     }
-                    if (blackboxHeader[xmitState.headerIndex] == '\0') {
+                    if (header[xmitState.headerIndex] == '\0') {
                         blackboxSetState(BLACKBOX_STATE_SEND_MAIN_FIELD_HEADER);
                     }
                 }
@@ -923,23 +1228,8 @@ void handleBlackbox(void)
             }
         break;
         case BLACKBOX_STATE_PAUSED:
-            if (IS_RC_MODE_ACTIVE(BOXBLACKBOX) && blackboxShouldLogIFrame()) {
-                flightLogEvent_loggingResume_t resume;
-                resume.logIteration = blackboxIteration;
-                resume.currentTime = currentTime;
-                blackboxLogEvent(FLIGHT_LOG_EVENT_LOGGING_RESUME, (flightLogEventData_t *) &resume);
-                blackboxSetState(BLACKBOX_STATE_RUNNING);
-                blackboxLogIteration();
-            }
-            blackboxAdvanceIterationTimers();
-        break;
         case BLACKBOX_STATE_RUNNING:
-            if (blackboxModeActivationConditionPresent && !IS_RC_MODE_ACTIVE(BOXBLACKBOX)) {
-                blackboxSetState(BLACKBOX_STATE_PAUSED);
-            } else {
-                blackboxLogIteration();
-            }
-            blackboxAdvanceIterationTimers();
+            blackboxDrainCaptureRing();
         break;
         case BLACKBOX_STATE_SHUTTING_DOWN:
             if (millis() > xmitState.u.startTime + BLACKBOX_SHUTDOWN_TIMEOUT_MILLIS || blackboxDeviceFlush()) {
@@ -947,9 +1237,18 @@ void handleBlackbox(void)
                 blackboxSetState(BLACKBOX_STATE_STOPPED);
             }
         break;
+        case BLACKBOX_STATE_SEND_BURST_HEADER:
+            if (blackboxWriteBurstHeader()) {
+                blackboxSetState(BLACKBOX_STATE_SEND_BURST);
+            }
+        break;
+        case BLACKBOX_STATE_SEND_BURST:
+            blackboxWriteBurst();
+        break;
         default:
         break;
     }
+    blackboxFrameFlush();
     if (isBlackboxDeviceFull()) {
         blackboxSetState(BLACKBOX_STATE_STOPPED);
     }
@@ -961,6 +1260,7 @@ static bool canUseBlackboxWithCurrentConfiguration(void)
 void initBlackbox(void)
 {
     if (canUseBlackboxWithCurrentConfiguration()) {
+        blackboxBurstInit();
         blackboxSetState(BLACKBOX_STATE_STOPPED);
     } else {
         blackboxSetState(BLACKBOX_STATE_DISABLED);
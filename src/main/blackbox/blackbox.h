@@ -22,5 +22,6 @@
 void blackboxLogEvent(FlightLogEvent event, flightLogEventData_t *data);
 void initBlackbox(void);
 void handleBlackbox(void);
+void blackboxCapture(void);
 void startBlackbox(void);
 void finishBlackbox(void);
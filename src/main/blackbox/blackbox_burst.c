@@ -0,0 +1,293 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "platform.h"
+#ifdef BLACKBOX
+#include "include.h"
+#include "blackbox_io.h"
+#include "blackbox_burst.h"
+blackboxBurst_t blackboxBurst;
+#ifdef BLACKBOX_BURST_BUFFER_SIZE
+typedef struct blackboxBurstKeyframe_s {
+    uint32_t offset;
+    uint32_t time;
+    uint32_t sample;
+} blackboxBurstKeyframe_t;
+extern uint8_t motorCount;
+extern uint16_t cycleTime;
+static uint8_t burstBuffer[BLACKBOX_BURST_BUFFER_SIZE];
+static blackboxBurstKeyframe_t burstKeyframes[BLACKBOX_BURST_KEYFRAME_SLOTS];
+static uint16_t burstKeyframeHead, burstKeyframeTail;
+static int16_t burstPrevious[BLACKBOX_BURST_FIELD_COUNT];
+static uint32_t burstSampleNumber;
+static uint32_t burstLastSampleTime;
+static uint32_t burstTriggerTime;
+static uint8_t burstSamplesSinceKeyframe;
+static uint8_t burstDenomCounter;
+static bool burstArmedAtTrigger;
+static int32_t burstCrashThreshold;
+static float burstHighGThresholdSq;
+static bool burstEnabled;
+#define BURST_BUFFER_MASK (BLACKBOX_BURST_BUFFER_SIZE - 1)
+#define BURST_KEYFRAME_MASK (BLACKBOX_BURST_KEYFRAME_SLOTS - 1)
+static void burstWriteSignedVB(int32_t value)
+{
+    uint32_t zigzag = (uint32_t)((value << 1) ^ (value >> 31));
+    while (zigzag > 127) {
+        burstBuffer[blackboxBurst.head++ & BURST_BUFFER_MASK] = (uint8_t)(zigzag | 0x80);
+        zigzag >>= 7;
+    }
+    burstBuffer[blackboxBurst.head++ & BURST_BUFFER_MASK] = zigzag;
+}
+static bool burstWriteGroup(const int16_t *values, int16_t *previous, int count)
+{
+    uint32_t maskPos = blackboxBurst.head++;
+    uint8_t mask = 0;
+    int i;
+    for (i = 0; i < count; i++) {
+        if (values[i] != previous[i]) {
+            mask |= 1 << i;
+            burstWriteSignedVB(values[i] - previous[i]);
+            previous[i] = values[i];
+        }
+    }
+    if (!mask) {
+        blackboxBurst.head--;
+        return false;
+    }
+    burstBuffer[maskPos & BURST_BUFFER_MASK] = mask;
+    return true;
+}
+static void blackboxBurstEncodeSample(uint32_t now)
+{
+    blackboxBurstKeyframe_t *keyframe;
+    int16_t rc[4];
+    uint32_t tagPos;
+    uint8_t tag = 0;
+    int i;
+    if (burstSamplesSinceKeyframe == 0) {
+        keyframe = &burstKeyframes[burstKeyframeHead++ & BURST_KEYFRAME_MASK];
+        keyframe->offset = blackboxBurst.head;
+        keyframe->time = now;
+        keyframe->sample = burstSampleNumber;
+        memset(burstPrevious, 0, sizeof(burstPrevious));
+        tag = BLACKBOX_BURST_KEYFRAME;
+    }
+    if (++burstSamplesSinceKeyframe >= BLACKBOX_BURST_KEYFRAME_INTERVAL) {
+        burstSamplesSinceKeyframe = 0;
+    }
+    for (i = 0; i < 4; i++) {
+        rc[i] = rcCommand[i];
+    }
+    tagPos = blackboxBurst.head++;
+    if (burstWriteGroup(gyroADCRaw, burstPrevious, XYZ_AXIS_COUNT)) {
+        tag |= 1 << 0;
+    }
+    if (burstWriteGroup(gyroADC, burstPrevious + XYZ_AXIS_COUNT, XYZ_AXIS_COUNT)) {
+        tag |= 1 << 1;
+    }
+    if (burstWriteGroup(motor, burstPrevious + XYZ_AXIS_COUNT * 2, blackboxBurst.motorCount)) {
+        tag |= 1 << 2;
+    }
+    if (burstWriteGroup(rc, burstPrevious + XYZ_AXIS_COUNT * 2 + BLACKBOX_BURST_MAX_MOTORS, 4)) {
+        tag |= 1 << 3;
+    }
+    if (burstWriteGroup(accSmooth, burstPrevious + XYZ_AXIS_COUNT * 2 + BLACKBOX_BURST_MAX_MOTORS + 4, XYZ_AXIS_COUNT)) {
+        tag |= 1 << 4;
+    }
+    burstBuffer[tagPos & BURST_BUFFER_MASK] = tag;
+    burstSampleNumber++;
+    burstLastSampleTime = now;
+}
+static void blackboxBurstReset(void)
+{
+    blackboxBurst.head = 0;
+    blackboxBurst.tail = 0;
+    blackboxBurst.samples = 0;
+    burstKeyframeHead = 0;
+    burstKeyframeTail = 0;
+    burstSampleNumber = 0;
+    burstSamplesSinceKeyframe = 0;
+}
+static void blackboxBurstDropOldest(void)
+{
+    burstKeyframeTail++;
+    blackboxBurst.tail = burstKeyframes[burstKeyframeTail & BURST_KEYFRAME_MASK].offset;
+}
+static uint32_t blackboxBurstFree(void)
+{
+    return BLACKBOX_BURST_BUFFER_SIZE - (blackboxBurst.head - blackboxBurst.tail);
+}
+static void blackboxBurstFinish(void)
+{
+    const blackboxBurstKeyframe_t *first = &burstKeyframes[burstKeyframeTail & BURST_KEYFRAME_MASK];
+    if (burstKeyframeHead == burstKeyframeTail) {
+        blackboxBurstRelease();
+        return;
+    }
+    blackboxBurst.samples = burstSampleNumber - first->sample;
+    blackboxBurst.duration = burstLastSampleTime - first->time;
+    blackboxBurst.pretrigger = cmp32(burstTriggerTime, first->time) > 0 ? burstTriggerTime - first->time : 0;
+    blackboxBurst.state = BLACKBOX_BURST_PENDING;
+}
+static bool blackboxBurstTrimWindow(uint32_t now)
+{
+    const uint32_t window = masterConfig.blackbox_pretrigger_ms * 1000;
+    while ((uint16_t)(burstKeyframeHead - burstKeyframeTail) > 1
+            && (blackboxBurstFree() < BLACKBOX_BURST_MAX_SAMPLE_SIZE
+            || (burstSamplesSinceKeyframe == 0 && (uint16_t)(burstKeyframeHead - burstKeyframeTail) >= BLACKBOX_BURST_KEYFRAME_SLOTS)
+            || now - burstKeyframes[(burstKeyframeTail + 1) & BURST_KEYFRAME_MASK].time > window)) {
+        blackboxBurstDropOldest();
+    }
+    return blackboxBurstFree() >= BLACKBOX_BURST_MAX_SAMPLE_SIZE;
+}
+static uint8_t blackboxBurstCheckTriggers(void)
+{
+    uint8_t triggers = 0;
+    int axis;
+    if (IS_RC_MODE_ACTIVE(BOXBLACKBOXBURST)) {
+        triggers |= BLACKBOX_TRIGGER_SWITCH;
+    }
+    if (burstCrashThreshold) {
+        for (axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            if (ABS(gyroADCRaw[axis]) >= burstCrashThreshold) {
+                triggers |= BLACKBOX_TRIGGER_CRASH;
+            }
+        }
+    }
+    if (burstHighGThresholdSq > 0.0f) {
+        float accSq = 0.0f;
+        for (axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            accSq += (float)accSmooth[axis] * accSmooth[axis];
+        }
+        if (accSq > burstHighGThresholdSq) {
+            triggers |= BLACKBOX_TRIGGER_HIGH_G;
+        }
+    }
+    if (cycleTime > targetLooptime * 3 / 2) {
+        triggers |= BLACKBOX_TRIGGER_OVERRUN;
+    }
+    if (failsafeIsActive()) {
+        triggers |= BLACKBOX_TRIGGER_FAILSAFE;
+    }
+    return triggers & masterConfig.blackbox_trigger;
+}
+void blackboxBurstInit(void)
+{
+    float highG = (float)masterConfig.blackbox_trigger_g * acc_1G;
+    burstCrashThreshold = 0;
+    if (masterConfig.blackbox_burst_crash_dps && gyro.scale > 0.0f) {
+        burstCrashThreshold = MIN(masterConfig.blackbox_burst_crash_dps / gyro.scale, INT16_MAX);
+    }
+    burstHighGThresholdSq = sensors(SENSOR_ACC) ? highG * highG : 0.0f;
+#ifdef USE_FLASHFS
+    burstEnabled = masterConfig.blackbox_device == BLACKBOX_DEVICE_FLASH
+        && masterConfig.blackbox_trigger
+        && (masterConfig.blackbox_burst_ms || masterConfig.blackbox_pretrigger_ms);
+#else
+    burstEnabled = false;
+#endif
+    blackboxBurst.motorCount = MIN(motorCount, BLACKBOX_BURST_MAX_MOTORS);
+    blackboxBurstRelease();
+}
+void blackboxBurstTrigger(uint8_t trigger)
+{
+    if (!burstEnabled || blackboxBurst.state != BLACKBOX_BURST_IDLE || !(trigger & masterConfig.blackbox_trigger)) {
+        return;
+    }
+    blackboxBurst.trigger = trigger;
+    burstTriggerTime = micros();
+    burstArmedAtTrigger = ARMING_FLAG(ARMED);
+    if ((trigger & (BLACKBOX_TRIGGER_ARM | BLACKBOX_TRIGGER_DISARM)) || !masterConfig.blackbox_burst_ms) {
+        blackboxBurstFinish();
+    } else {
+        blackboxBurst.state = BLACKBOX_BURST_RECORDING;
+    }
+}
+void blackboxBurstCapture(void)
+{
+    uint8_t trigger;
+    uint32_t now;
+    if (!burstEnabled || blackboxBurst.state == BLACKBOX_BURST_PENDING) {
+        return;
+    }
+    if (blackboxBurst.state == BLACKBOX_BURST_IDLE) {
+        if (!ARMING_FLAG(ARMED) && !(masterConfig.blackbox_trigger & BLACKBOX_TRIGGER_ARM)) {
+            if (blackboxBurst.head) {
+                blackboxBurstReset();
+            }
+            return;
+        }
+        if (ARMING_FLAG(ARMED) && (trigger = blackboxBurstCheckTriggers())) {
+            blackboxBurstTrigger(trigger);
+        }
+        if (blackboxBurst.state == BLACKBOX_BURST_IDLE && !masterConfig.blackbox_pretrigger_ms) {
+            return;
+        }
+    }
+    if (++burstDenomCounter < masterConfig.blackbox_burst_denom) {
+        return;
+    }
+    burstDenomCounter = 0;
+    now = micros();
+    if (blackboxBurst.state == BLACKBOX_BURST_RECORDING) {
+        if ((burstArmedAtTrigger && !ARMING_FLAG(ARMED))
+                || now - burstTriggerTime >= masterConfig.blackbox_burst_ms * 1000
+                || blackboxBurstFree() < BLACKBOX_BURST_MAX_SAMPLE_SIZE
+                || (burstSamplesSinceKeyframe == 0 && (uint16_t)(burstKeyframeHead - burstKeyframeTail) >= BLACKBOX_BURST_KEYFRAME_SLOTS)) {
+            blackboxBurstFinish();
+            return;
+        }
+    } else if (!blackboxBurstTrimWindow(now)) {
+        blackboxBurstReset();
+    }
+    blackboxBurstEncodeSample(now);
+}
+uint8_t blackboxBurstRead(uint32_t offset)
+{
+    return burstBuffer[(blackboxBurst.tail + offset) & BURST_BUFFER_MASK];
+}
+void blackboxBurstRelease(void)
+{
+    blackboxBurstReset();
+    blackboxBurst.state = BLACKBOX_BURST_IDLE;
+}
+#else
+void blackboxBurstInit(void)
+{
+}
+void blackboxBurstCapture(void)
+{
+}
+void blackboxBurstTrigger(uint8_t trigger)
+{
+    (void)trigger;
+}
+uint8_t blackboxBurstRead(uint32_t offset)
+{
+    (void)offset;
+    return 0;
+}
+void blackboxBurstRelease(void)
+{
+}
+#endif
+#endif
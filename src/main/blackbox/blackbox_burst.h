@@ -0,0 +1,88 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#pragma once 
+       
+#include <stdint.h>
+#include <stdbool.h>
+#if defined(STM32F40_41xxx) || defined (STM32F411xE) || defined(STM32F446xx)
+#define BLACKBOX_BURST_BUFFER_SIZE 32768
+#define BLACKBOX_BURST_KEYFRAME_SLOTS 128
+#elif !defined(STM32F10X)
+#define BLACKBOX_BURST_BUFFER_SIZE 4096
+#define BLACKBOX_BURST_KEYFRAME_SLOTS 32
+#endif
+/*
+ * Burst capture stream, written after the "H Burst ..." header lines of a
+ * burst log; "H Burst length" gives its size in bytes.
+ *
+ * The stream is a run of samples taken every blackbox_burst_denom loops with
+ * no timestamps; "H Burst duration" / "H Burst samples" gives the spacing.
+ * Each sample is:
+ *
+ *   tag     1 byte. Bit 7 (BLACKBOX_BURST_KEYFRAME) marks a keyframe, bits 0-4
+ *           flag which groups follow, in this order:
+ *             0 gyroRaw[3]  1 gyroADC[3]  2 motor["H Burst motors"]
+ *             3 rcCommand[4]  4 accSmooth[3]
+ *   groups  for each flagged group a mask byte (bit i set = field i changed)
+ *           followed by one zigzag LEB128 varint per changed field holding
+ *           the difference from that field's previous value.
+ *
+ * Groups and fields that did not change are left out. Every field's previous
+ * value is reset to 0 at a keyframe, so keyframes carry absolute values. A
+ * keyframe is written every BLACKBOX_BURST_KEYFRAME_INTERVAL samples and the
+ * stream always starts on one, older samples being dropped a keyframe block
+ * at a time.
+ */
+#define BLACKBOX_BURST_KEYFRAME_INTERVAL 32
+#define BLACKBOX_BURST_KEYFRAME 0x80
+#define BLACKBOX_BURST_GROUP_COUNT 5
+#define BLACKBOX_BURST_MAX_MOTORS 8
+#define BLACKBOX_BURST_FIELD_COUNT (XYZ_AXIS_COUNT * 3 + 4 + BLACKBOX_BURST_MAX_MOTORS)
+#define BLACKBOX_BURST_MAX_SAMPLE_SIZE (1 + BLACKBOX_BURST_GROUP_COUNT + 3 * BLACKBOX_BURST_FIELD_COUNT)
+typedef enum {
+    BLACKBOX_TRIGGER_SWITCH = 1 << 0,
+    BLACKBOX_TRIGGER_CRASH = 1 << 1,
+    BLACKBOX_TRIGGER_ARM = 1 << 2,
+    BLACKBOX_TRIGGER_DISARM = 1 << 3,
+    BLACKBOX_TRIGGER_HIGH_G = 1 << 4,
+    BLACKBOX_TRIGGER_OVERRUN = 1 << 5,
+    BLACKBOX_TRIGGER_FAILSAFE = 1 << 6
+} blackboxTrigger_e;
+#define BLACKBOX_TRIGGER_ALL 0x7F
+typedef enum {
+    BLACKBOX_BURST_IDLE = 0,
+    BLACKBOX_BURST_RECORDING,
+    BLACKBOX_BURST_PENDING
+} blackboxBurstState_e;
+typedef struct blackboxBurst_s {
+    blackboxBurstState_e state;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t samples;
+    uint32_t duration;
+    uint32_t pretrigger;
+    uint8_t motorCount;
+    uint8_t trigger;
+} blackboxBurst_t;
+extern blackboxBurst_t blackboxBurst;
+void blackboxBurstInit(void);
+void blackboxBurstCapture(void);
+void blackboxBurstTrigger(uint8_t trigger);
+uint8_t blackboxBurstRead(uint32_t offset);
+void blackboxBurstRelease(void);
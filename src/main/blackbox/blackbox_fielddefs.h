@@ -39,6 +39,14 @@ typedef enum FlightLogFieldCondition {
     FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_D_0,
     FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_D_1,
     FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_D_2,
+    FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_F_0,
+    FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_F_1,
+    FLIGHT_LOG_FIELD_CONDITION_NONZERO_PID_F_2,
+    FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_0,
+    FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_1,
+    FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_2,
+    FLIGHT_LOG_FIELD_CONDITION_ESC_ERPM_3,
+    FLIGHT_LOG_FIELD_CONDITION_GROUP_RATES,
     FLIGHT_LOG_FIELD_CONDITION_NOT_LOGGING_EVERY_FRAME,
     FLIGHT_LOG_FIELD_CONDITION_NEVER,
     FLIGHT_LOG_FIELD_CONDITION_FIRST = FLIGHT_LOG_FIELD_CONDITION_ALWAYS,
@@ -64,7 +72,8 @@ typedef enum FlightLogFieldEncoding {
     FLIGHT_LOG_FIELD_ENCODING_TAG8_8SVB = 6,
     FLIGHT_LOG_FIELD_ENCODING_TAG2_3S32 = 7,
     FLIGHT_LOG_FIELD_ENCODING_TAG8_4S16 = 8,
-    FLIGHT_LOG_FIELD_ENCODING_NULL = 9
+    FLIGHT_LOG_FIELD_ENCODING_NULL = 9,
+    FLIGHT_LOG_FIELD_ENCODING_ADAPTIVE_RICE = 10
 } FlightLogFieldEncoding;
 typedef enum FlightLogFieldSign {
     FLIGHT_LOG_FIELD_UNSIGNED = 0,
@@ -73,19 +73,45 @@ static uint8_t blackboxMaxHeaderBytesPerIteration;
 int32_t blackboxHeaderBudget;
 static serialPort_t *blackboxPort = NULL;
 static portSharing_e blackboxPortSharing;
-void blackboxWrite(uint8_t value)
+uint8_t blackboxFrameBuffer[BLACKBOX_FRAME_BUFFER_SIZE];
+uint32_t blackboxFrameLength = 0;
+static uint32_t riceBits;
+static uint8_t riceBitCount;
+#define BLACKBOX_RICE_ESCAPE 16
+#define BLACKBOX_RICE_RESET 32
+void blackboxFrameFlush(void)
 {
+    if (blackboxFrameLength == 0) {
+        return;
+    }
     switch (masterConfig.blackbox_device) {
 #ifdef USE_FLASHFS
         case BLACKBOX_DEVICE_FLASH:
-            flashfsWriteByte(value);
+            flashfsWrite(blackboxFrameBuffer, blackboxFrameLength, false);
         break;
 #endif
         case BLACKBOX_DEVICE_SERIAL:
         default:
-            serialWrite(blackboxPort, value);
+            if (blackboxPort) {
+                serialWriteBuf(blackboxPort, blackboxFrameBuffer, blackboxFrameLength);
+            }
         break;
     }
+    blackboxFrameLength = 0;
+}
+void blackboxWriteBuf(const uint8_t *data, int length)
+{
+    int chunk;
+    while (length > 0) {
+        if (blackboxFrameLength >= BLACKBOX_FRAME_BUFFER_SIZE) {
+            blackboxFrameFlush();
+        }
+        chunk = MIN(length, (int)(BLACKBOX_FRAME_BUFFER_SIZE - blackboxFrameLength));
+        memcpy(blackboxFrameBuffer + blackboxFrameLength, data, chunk);
+        blackboxFrameLength += chunk;
+        data += chunk;
+        length -= chunk;
+    }
 }
 static void _putc(void *p, char c)
 {
@@ -117,39 +143,10 @@ void blackboxPrintfHeaderLine(const char *fmt, ...)
 }
 int blackboxPrint(const char *s)
 {
-    int length;
-    const uint8_t *pos;
-    switch (masterConfig.blackbox_device) {
-#ifdef USE_FLASHFS
-        case BLACKBOX_DEVICE_FLASH:
-            length = strlen(s);
-            flashfsWrite((const uint8_t*) s, length, false);
-        break;
-#endif
-        case BLACKBOX_DEVICE_SERIAL:
-        default:
-            pos = (uint8_t*) s;
-            while (*pos) {
-                serialWrite(blackboxPort, *pos);
-                pos++;
-            }
-            length = pos - (uint8_t*) s;
-        break;
-    }
+    int length = strlen(s);
+    blackboxWriteBuf((const uint8_t*) s, length);
     return length;
 }
-void blackboxWriteUnsignedVB(uint32_t value)
-{
-    while (value > 127) {
-        blackboxWrite((uint8_t) (value | 0x80));
-        value >>= 7;
-    }
-    blackboxWrite(value);
-}
-void blackboxWriteSignedVB(int32_t value)
-{
-    blackboxWriteUnsignedVB(zigzagEncode(value));
-}
 void blackboxWriteSignedVBArray(int32_t *array, int count)
 {
     for (int i = 0; i < count; i++) {
@@ -349,8 +346,58 @@ void blackboxWriteFloat(float value)
 {
     blackboxWriteU32(castFloatBytesToInt(value));
 }
+static void blackboxWriteBits(uint32_t value, uint8_t count)
+{
+    riceBits = (riceBits << count) | (value & ((1 << count) - 1));
+    riceBitCount += count;
+    while (riceBitCount >= 8) {
+        riceBitCount -= 8;
+        blackboxWrite(riceBits >> riceBitCount);
+    }
+    riceBits &= (1 << riceBitCount) - 1;
+}
+void blackboxRiceReset(blackboxRiceState_t *state, int count)
+{
+    for (int i = 0; i < count; i++) {
+        state[i].sum = 4;
+        state[i].count = 1;
+    }
+}
+void blackboxWriteRiceSigned(int32_t value, blackboxRiceState_t *state)
+{
+    uint32_t unsignedValue = zigzagEncode(value);
+    uint8_t k = 0;
+    while (k < 24 && ((uint32_t)state->count << k) < state->sum) {
+        k++;
+    }
+    uint32_t quotient = unsignedValue >> k;
+    if (quotient < BLACKBOX_RICE_ESCAPE) {
+        blackboxWriteBits((1 << (quotient + 1)) - 2, quotient + 1);
+        if (k) {
+            blackboxWriteBits(unsignedValue, k);
+        }
+    } else {
+        blackboxWriteBits((1 << BLACKBOX_RICE_ESCAPE) - 1, BLACKBOX_RICE_ESCAPE);
+        blackboxWriteBits(unsignedValue >> 16, 16);
+        blackboxWriteBits(unsignedValue, 16);
+    }
+    state->sum += MIN(unsignedValue, 0xFFFF);
+    if (++state->count >= BLACKBOX_RICE_RESET) {
+        state->sum >>= 1;
+        state->count >>= 1;
+    }
+}
+void blackboxRiceFlush(void)
+{
+    if (riceBitCount) {
+        blackboxWrite(riceBits << (8 - riceBitCount));
+    }
+    riceBits = 0;
+    riceBitCount = 0;
+}
 bool blackboxDeviceFlush(void)
 {
+    blackboxFrameFlush();
     switch (masterConfig.blackbox_device) {
         case BLACKBOX_DEVICE_SERIAL:
             return isSerialTransmitBufferEmpty(blackboxPort);
@@ -401,6 +448,7 @@ bool blackboxDeviceOpen(void)
 }
 void blackboxDeviceClose(void)
 {
+    blackboxFrameFlush();
     switch (masterConfig.blackbox_device) {
         case BLACKBOX_DEVICE_SERIAL:
             closeSerialPort(blackboxPort);
@@ -431,6 +479,7 @@ bool isBlackboxDeviceFull(void)
 void blackboxReplenishHeaderBudget()
 {
     int32_t freeSpace;
+    blackboxFrameFlush();
     switch (masterConfig.blackbox_device) {
         case BLACKBOX_DEVICE_SERIAL:
             freeSpace = serialTxBytesFree(blackboxPort);
@@ -447,6 +496,7 @@ void blackboxReplenishHeaderBudget()
 }
 blackboxBufferReserveStatus_e blackboxDeviceReserveBufferSpace(int32_t bytes)
 {
+    blackboxFrameFlush();
     if (bytes <= blackboxHeaderBudget) {
         return BLACKBOX_RESERVE_SUCCESS;
     }
@@ -21,6 +21,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "platform.h"
+#include "common/encoding.h"
 typedef enum BlackboxDevice {
     BLACKBOX_DEVICE_SERIAL = 0,
 #ifdef USE_FLASHFS
@@ -33,15 +34,51 @@ typedef enum {
     BLACKBOX_RESERVE_TEMPORARY_FAILURE,
     BLACKBOX_RESERVE_PERMANENT_FAILURE
 } blackboxBufferReserveStatus_e;
+typedef enum {
+    BLACKBOX_ENCODING_VB = 0,
+    BLACKBOX_ENCODING_RICE
+} blackboxEncoding_e;
+typedef struct blackboxRiceState_s {
+    uint32_t sum;
+    uint8_t count;
+} blackboxRiceState_t;
 #define BLACKBOX_MAX_ACCUMULATED_HEADER_BUDGET 256
 #define BLACKBOX_TARGET_HEADER_BUDGET_PER_ITERATION 64
+#define BLACKBOX_FRAME_BUFFER_SIZE 128
+#define BLACKBOX_MAX_VB_SIZE 5
 extern int32_t blackboxHeaderBudget;
-void blackboxWrite(uint8_t value);
+extern uint8_t blackboxFrameBuffer[BLACKBOX_FRAME_BUFFER_SIZE];
+extern uint32_t blackboxFrameLength;
+void blackboxFrameFlush(void);
+static inline void blackboxWrite(uint8_t value)
+{
+    if (blackboxFrameLength >= BLACKBOX_FRAME_BUFFER_SIZE) {
+        blackboxFrameFlush();
+    }
+    blackboxFrameBuffer[blackboxFrameLength++] = value;
+}
+static inline void blackboxWriteUnsignedVB(uint32_t value)
+{
+    uint8_t *pos;
+    if (blackboxFrameLength > BLACKBOX_FRAME_BUFFER_SIZE - BLACKBOX_MAX_VB_SIZE) {
+        blackboxFrameFlush();
+    }
+    pos = blackboxFrameBuffer + blackboxFrameLength;
+    while (value > 127) {
+        *pos++ = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    *pos++ = value;
+    blackboxFrameLength = pos - blackboxFrameBuffer;
+}
+static inline void blackboxWriteSignedVB(int32_t value)
+{
+    blackboxWriteUnsignedVB(zigzagEncode(value));
+}
+void blackboxWriteBuf(const uint8_t *data, int length);
 int blackboxPrintf(const char *fmt, ...);
 void blackboxPrintfHeaderLine(const char *fmt, ...);
 int blackboxPrint(const char *s);
-void blackboxWriteUnsignedVB(uint32_t value);
-void blackboxWriteSignedVB(int32_t value);
 void blackboxWriteSignedVBArray(int32_t *array, int count);
 void blackboxWriteSigned16VBArray(int16_t *array, int count);
 void blackboxWriteS16(int16_t value);
@@ -50,6 +87,18 @@ void blackboxWriteTag8_4S16(int32_t *values);
 void blackboxWriteTag8_8SVB(int32_t *values, int valueCount);
 void blackboxWriteU32(int32_t value);
 void blackboxWriteFloat(float value);
+/*
+ * Adaptive Rice coding (Data version 3), MSB first. Each value is zigzagged
+ * to u; k is the smallest k <= 24 with (count << k) >= sum for that field's
+ * state. If u >> k < 16 the code is (u >> k) one bits, a zero, then the low
+ * k bits of u; otherwise sixteen one bits and then u as 32 raw bits. Then
+ * sum += MIN(u, 0xFFFF) and count++, and both are halved when count reaches
+ * 32. States start at sum 4, count 1 and are reset at every I frame. A
+ * P frame's block is zero-padded to a byte by blackboxRiceFlush.
+ */
+void blackboxRiceReset(blackboxRiceState_t *state, int count);
+void blackboxWriteRiceSigned(int32_t value, blackboxRiceState_t *state);
+void blackboxRiceFlush(void);
 bool blackboxDeviceFlush(void);
 bool blackboxDeviceOpen(void);
 void blackboxDeviceClose(void);
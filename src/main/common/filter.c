@@ -121,6 +121,41 @@ void BiQuadNewLpf2(uint16_t filterCutFreq, biquad2_t *newState, float refreshRat
     newState->x1 = newState->x2 = (double)0.0;
     newState->y1 = newState->y2 = (double)0.0;
 }
+#define SIN_LUT_SIZE 256
+static float sinLut[SIN_LUT_SIZE + 1];
+void initSinLut(void)
+{
+    int i;
+    for (i = 0; i <= SIN_LUT_SIZE; i++) {
+        sinLut[i] = sinf(i * M_PI_FLOAT / 2 / SIN_LUT_SIZE);
+    }
+}
+static float sinLutQuarter(float x)
+{
+    float index = x * (SIN_LUT_SIZE * 2 / M_PI_FLOAT);
+    int i = (int)index;
+    if (i >= SIN_LUT_SIZE) {
+        return sinLut[SIN_LUT_SIZE];
+    }
+    return sinLut[i] + (sinLut[i + 1] - sinLut[i]) * (index - i);
+}
+void notchFilterUpdate(notchCoeffs_t *coeffs, float centerFreq, float q, float samplingRate)
+{
+    float omega = 2 * M_PI_FLOAT * centerFreq / samplingRate;
+    float sn, cs, alpha, a0;
+    if (omega > M_PI_FLOAT / 2) {
+        sn = sinLutQuarter(M_PI_FLOAT - omega);
+        cs = -sinLutQuarter(omega - M_PI_FLOAT / 2);
+    } else {
+        sn = sinLutQuarter(omega);
+        cs = sinLutQuarter(M_PI_FLOAT / 2 - omega);
+    }
+    alpha = sn / (2 * q);
+    a0 = 1.0f / (1 + alpha);
+    coeffs->b0 = a0;
+    coeffs->b1 = -2 * cs * a0;
+    coeffs->a2 = (1 - alpha) * a0;
+}
 double applyBiQuadFilter2(double sample, biquad2_t *state)
 {
  double result;
@@ -40,8 +40,25 @@ typedef struct biquad2_s {
     double a0, a1, a2, a3, a4;
     double x1, x2, y1, y2;
 } biquad2_t;
+typedef struct notchCoeffs_s {
+    float b0, b1, a2;
+} notchCoeffs_t;
+typedef struct notchState_s {
+    float x1, x2, y1, y2;
+} notchState_t;
+static inline float applyNotchFilter(float sample, const notchCoeffs_t *coeffs, notchState_t *state)
+{
+    float result = coeffs->b0 * (sample + state->x2) + coeffs->b1 * (state->x1 - state->y1) - coeffs->a2 * state->y2;
+    state->x2 = state->x1;
+    state->x1 = sample;
+    state->y2 = state->y1;
+    state->y1 = result;
+    return result;
+}
 float filterApplyPt1(float input, filterStatePt1_t *filter, uint8_t f_cut, float dt);
 float applyBiQuadFilter(float sample, biquad_t *state);
 void BiQuadNewLpf(uint16_t filterCutFreq, biquad_t *newState, float refreshRate);
 double applyBiQuadFilter2(double sample, biquad2_t *state);
 void BiQuadNewLpf2(uint16_t filterCutFreq, biquad2_t *newState, float refreshRate);
+void initSinLut(void);
+void notchFilterUpdate(notchCoeffs_t *coeffs, float centerFreq, float q, float samplingRate);
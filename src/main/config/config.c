@@ -33,6 +33,7 @@
 #include "drivers/gpio.h"
 #include "drivers/timer.h"
 #include "drivers/pwm_rx.h"
+#include "drivers/pwm_mapping.h"
 #include "drivers/serial.h"
 #include "drivers/gyro_sync.h"
 #include "sensors/sensors.h"
@@ -52,6 +53,8 @@
 #include "io/gps.h"
 #include "rx/rx.h"
 #include "telemetry/telemetry.h"
+#include "blackbox/blackbox_burst.h"
+#include "blackbox/blackbox_io.h"
 #include "flight/mixer.h"
 #include "flight/pid.h"
 #include "flight/imu.h"
@@ -127,7 +130,7 @@ profile_t *currentProfile;
 static uint32_t activeFeaturesLatch = 0;
 static uint8_t currentControlRateProfileIndex = 0;
 controlRateConfig_t *currentControlRateProfile;
-static const uint8_t EEPROM_CONF_VERSION = 77;
+static const uint8_t EEPROM_CONF_VERSION = 88;
 static void resetAccelerometerTrims(flightDynamicsTrims_t *accelerometerTrims)
 {
     accelerometerTrims->values.pitch = 0;
@@ -177,6 +180,12 @@ static void resetPidProfile(pidProfile_t *pidProfile)
  pidProfile->yaw_pterm_cut_hz = 30;
  pidProfile->pitch_pterm_cut_hz = 0;
  pidProfile->witchcraft = 4;
+    pidProfile->F_f[ROLL] = 0.0f;
+    pidProfile->F_f[PITCH] = 0.0f;
+    pidProfile->F_f[YAW] = 0.0f;
+    pidProfile->ff_lpf_hz[ROLL] = 40;
+    pidProfile->ff_lpf_hz[PITCH] = 40;
+    pidProfile->ff_lpf_hz[YAW] = 30;
  pidProfile->P_f[ROLL] = 6.600f;
     pidProfile->I_f[ROLL] = 1.475f;
     pidProfile->D_f[ROLL] = 0.190f;
@@ -228,11 +237,15 @@ void resetSensorAlignment(sensorAlignmentConfig_t *sensorAlignmentConfig)
 }
 void resetEscAndServoConfig(escAndServoConfig_t *escAndServoConfig)
 {
+    uint8_t i;
     escAndServoConfig->minthrottle = 1065;
     escAndServoConfig->maxthrottle = 2000;
     escAndServoConfig->mincommand = 1000;
     escAndServoConfig->realmincommand = 990;
     escAndServoConfig->servoCenterPulse = 1500;
+    for (i = 0; i < THRUST_CURVE_POINTS; i++) {
+        escAndServoConfig->thrustCurve[i] = i * 100 / (THRUST_CURVE_POINTS - 1);
+    }
 }
 void resetFlight3DConfig(flight3DConfig_t *flight3DConfig)
 {
@@ -287,7 +300,9 @@ void resetSerialConfig(serialConfig_t *serialConfig)
 #endif
     serialConfig->reboot_character = 'R';
 }
+static const uint8_t defaultTpaCurve[TPA_CURVE_POINTS] = { 0, 0, 8, 16, 20, 26, 30, 30, 30 };
 static void resetControlRateConfig(controlRateConfig_t *controlRateConfig) {
+    memcpy(controlRateConfig->tpaCurve, defaultTpaCurve, sizeof(defaultTpaCurve));
     controlRateConfig->rcPitchExpo8 = 40.0f;
     controlRateConfig->rcRollExpo8 = 40.0f;
     controlRateConfig->rcYawExpo8 = 40.0f;
@@ -398,6 +413,9 @@ static void resetConf(void)
     masterConfig.max_angle_inclination = 700;
     masterConfig.yaw_control_direction = 1;
     masterConfig.gyroConfig.gyroMovementCalibrationThreshold = 16;
+    masterConfig.gyroConfig.rpm_notch_harmonics = 3;
+    masterConfig.gyroConfig.rpm_notch_q = 50;
+    masterConfig.gyroConfig.rpm_notch_min_hz = 100;
     masterConfig.mag_hardware = 1;
     masterConfig.baro_hardware = 1;
     resetBatteryConfig(&masterConfig.batteryConfig);
@@ -437,7 +455,7 @@ static void resetConf(void)
     masterConfig.rxConfig.rssi_channel = 0;
     masterConfig.rxConfig.rssi_scale = RSSI_SCALE_DEFAULT;
     masterConfig.rxConfig.rssi_ppm_invert = 0;
-    masterConfig.rxConfig.rcSmoothing = 1;
+    masterConfig.rxConfig.rcSmoothing = RC_SMOOTHING_LINEAR;
     masterConfig.rxConfig.fpvCamAngleDegrees = 0;
     resetAllRxChannelRangeConfigurations(masterConfig.rxConfig.channelRanges);
     masterConfig.inputFilteringMode = INPUT_FILTERING_DISABLED;
@@ -456,6 +474,9 @@ static void resetConf(void)
 #endif
     masterConfig.servo_pwm_rate = 50;
     masterConfig.use_fast_pwm = 0;
+    masterConfig.dshot_rate = DSHOT_RATE_600;
+    masterConfig.motor_poles = 14;
+    masterConfig.motor_skew_measure = 0;
 #ifdef CC3D
     masterConfig.use_buzzer_p6 = 0;
 #endif
@@ -519,6 +540,17 @@ static void resetConf(void)
 #endif
     masterConfig.blackbox_rate_num = 1;
     masterConfig.blackbox_rate_denom = 1;
+    masterConfig.blackbox_rate_hz = 0;
+    masterConfig.blackbox_pid_hz = 0;
+    masterConfig.blackbox_rc_hz = 0;
+    masterConfig.blackbox_batt_hz = 0;
+    masterConfig.blackbox_encoding = BLACKBOX_ENCODING_VB;
+    masterConfig.blackbox_burst_ms = 2000;
+    masterConfig.blackbox_burst_crash_dps = 0;
+    masterConfig.blackbox_pretrigger_ms = 0;
+    masterConfig.blackbox_burst_denom = 1;
+    masterConfig.blackbox_trigger = BLACKBOX_TRIGGER_SWITCH | BLACKBOX_TRIGGER_CRASH | BLACKBOX_TRIGGER_HIGH_G | BLACKBOX_TRIGGER_FAILSAFE;
+    masterConfig.blackbox_trigger_g = 0;
 #endif
 #ifdef CONFIG_FEATURE_RX_SERIAL
     featureSet(FEATURE_RX_SERIAL);
@@ -589,12 +621,15 @@ void activateControlRateConfig(void)
     generatePitchCurve(currentControlRateProfile);
     generateRollCurve(currentControlRateProfile);
     generateYawCurve(currentControlRateProfile);
+    generateRateCurves(currentControlRateProfile);
+    generateTpaCurve(currentControlRateProfile);
     generateThrottleCurve(currentControlRateProfile, &masterConfig.escAndServoConfig);
 }
 void activateConfig(void)
 {
     static imuRuntimeConfig_t imuRuntimeConfig;
     activateControlRateConfig();
+    generateThrustCurve(&masterConfig.escAndServoConfig);
     resetAdjustmentStates();
     useRcControlsConfig(
         currentProfile->modeActivationConditions,
@@ -855,6 +890,8 @@ void handleOneshotFeatureChangeOnRestart(void)
             delay(ONESHOT_FEATURE_CHANGED_DELAY_ON_BOOT_MS);
     } else if (feature(FEATURE_MULTISHOT) && !featureConfigured(FEATURE_MULTISHOT)) {
             delay(ONESHOT_FEATURE_CHANGED_DELAY_ON_BOOT_MS);
+    } else if (feature(FEATURE_DSHOT) && !featureConfigured(FEATURE_DSHOT)) {
+            delay(ONESHOT_FEATURE_CHANGED_DELAY_ON_BOOT_MS);
     }
 }
 void latchActiveFeatures()
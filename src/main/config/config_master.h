@@ -34,6 +34,9 @@ typedef struct master_t {
     uint16_t motor_pwm_rate;
     uint16_t servo_pwm_rate;
     uint8_t use_fast_pwm;
+    uint8_t dshot_rate;
+    uint8_t motor_poles;
+    uint8_t motor_skew_measure;
 #ifdef CC3D
     uint8_t use_buzzer_p6;
 #endif
@@ -86,7 +89,18 @@ typedef struct master_t {
 #ifdef BLACKBOX
     uint8_t blackbox_rate_num;
     uint8_t blackbox_rate_denom;
+    uint16_t blackbox_rate_hz;
+    uint16_t blackbox_pid_hz;
+    uint16_t blackbox_rc_hz;
+    uint16_t blackbox_batt_hz;
     uint8_t blackbox_device;
+    uint8_t blackbox_encoding;
+    uint16_t blackbox_burst_ms;
+    uint16_t blackbox_burst_crash_dps;
+    uint16_t blackbox_pretrigger_ms;
+    uint8_t blackbox_burst_denom;
+    uint8_t blackbox_trigger;
+    uint8_t blackbox_trigger_g;
 #endif
     beeperOffConditions_t beeper_off;
     uint8_t magic_ef;
@@ -0,0 +1,66 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "dma.h"
+typedef struct dmaReservation_s {
+    const void *dmaRef;
+    resourceOwner_t owner;
+} dmaReservation_t;
+static dmaReservation_t dmaReservations[DMA_MAX_RESERVATIONS];
+resourceOwner_t dmaGetOwner(const void *dmaRef)
+{
+    for (int i = 0; i < DMA_MAX_RESERVATIONS; i++) {
+        if (dmaReservations[i].dmaRef == dmaRef) {
+            return dmaReservations[i].owner;
+        }
+    }
+    return OWNER_FREE;
+}
+bool dmaReserve(const void *dmaRef, resourceOwner_t owner)
+{
+    dmaReservation_t *free = NULL;
+    if (!dmaRef) {
+        return false;
+    }
+    for (int i = 0; i < DMA_MAX_RESERVATIONS; i++) {
+        if (dmaReservations[i].dmaRef == dmaRef) {
+            return dmaReservations[i].owner == owner;
+        }
+        if (!free && !dmaReservations[i].dmaRef) {
+            free = &dmaReservations[i];
+        }
+    }
+    if (!free) {
+        return false;
+    }
+    free->dmaRef = dmaRef;
+    free->owner = owner;
+    return true;
+}
+void dmaRelease(const void *dmaRef, resourceOwner_t owner)
+{
+    for (int i = 0; i < DMA_MAX_RESERVATIONS; i++) {
+        if (dmaReservations[i].dmaRef == dmaRef && dmaReservations[i].owner == owner) {
+            dmaReservations[i].dmaRef = NULL;
+            dmaReservations[i].owner = OWNER_FREE;
+        }
+    }
+}
@@ -0,0 +1,27 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#pragma once 
+       
+#include <stdbool.h>
+#include <stdint.h>
+#include "resource.h"
+#define DMA_MAX_RESERVATIONS 16
+bool dmaReserve(const void *dmaRef, resourceOwner_t owner);
+void dmaRelease(const void *dmaRef, resourceOwner_t owner);
+resourceOwner_t dmaGetOwner(const void *dmaRef);
@@ -0,0 +1,43 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#include <stdbool.h>
+#include <stdint.h>
+#include "dshot.h"
+uint16_t dshotEncodeFrame(uint16_t value, bool requestTelemetry)
+{
+    uint16_t packet = (value << 1) | (requestTelemetry ? 1 : 0);
+    uint16_t csum = packet ^ (packet >> 4) ^ (packet >> 8);
+    return (packet << 4) | (csum & 0xf);
+}
+uint16_t dshotThrottle(uint16_t value)
+{
+    if (value <= 1000)
+        return 0;
+    if (value >= 2000)
+        return DSHOT_MAX_THROTTLE;
+    return DSHOT_MIN_THROTTLE + (uint32_t)(value - 1000) * (DSHOT_MAX_THROTTLE - DSHOT_MIN_THROTTLE) / 1000;
+}
+void dshotFillBuffer(uint32_t *buffer, uint8_t stride, uint16_t frame)
+{
+    uint8_t i;
+    for (i = 0; i < DSHOT_FRAME_BITS; i++) {
+        buffer[i * stride] = (frame & 0x8000) ? DSHOT_BIT_1 : DSHOT_BIT_0;
+        frame <<= 1;
+    }
+}
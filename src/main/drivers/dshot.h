@@ -0,0 +1,31 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#pragma once 
+       
+#include <stdbool.h>
+#include <stdint.h>
+#define DSHOT_BIT_PERIOD 20
+#define DSHOT_BIT_0 7
+#define DSHOT_BIT_1 15
+#define DSHOT_FRAME_BITS 16
+#define DSHOT_MIN_THROTTLE 48
+#define DSHOT_MAX_THROTTLE 2047
+uint16_t dshotEncodeFrame(uint16_t value, bool requestTelemetry);
+uint16_t dshotThrottle(uint16_t value);
+void dshotFillBuffer(uint32_t *buffer, uint8_t stride, uint16_t frame);
@@ -24,8 +24,13 @@
 #include "flash_m25p16.h"
 #include "bus_spi.h"
 #include "system.h"
+#include "dma.h"
+#ifdef M25P16_DMA
+#include "nvic.h"
+#endif
 #define M25P16_INSTRUCTION_RDID 0x9F
 #define M25P16_INSTRUCTION_READ_BYTES 0x03
+#define M25P16_INSTRUCTION_FAST_READ 0x0B
 #define M25P16_INSTRUCTION_READ_STATUS_REG 0x05
 #define M25P16_INSTRUCTION_WRITE_STATUS_REG 0x01
 #define M25P16_INSTRUCTION_WRITE_ENABLE 0x06
@@ -48,6 +53,96 @@
 static flashGeometry_t geometry = {.pageSize = M25P16_PAGESIZE};
 static IO_t flashSpim25p16CsPin = IO_NONE;
 static bool couldBeBusy = false;
+#ifdef M25P16_DMA
+static volatile bool dmaBusy = false;
+static bool dmaEnabled = false;
+static uint8_t dmaDummy;
+static void m25p16_dmaInit(void)
+{
+    DMA_InitTypeDef DMA_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+    if (!dmaReserve(M25P16_DMA_TX_ST, OWNER_FLASH)) {
+        return;
+    }
+    if (!dmaReserve(M25P16_DMA_RX_ST, OWNER_FLASH)) {
+        dmaRelease(M25P16_DMA_TX_ST, OWNER_FLASH);
+        return;
+    }
+    RCC_AHB1PeriphClockCmd(M25P16_DMA_PERIPH, ENABLE);
+    DMA_StructInit(&DMA_InitStructure);
+    DMA_InitStructure.DMA_Channel = M25P16_DMA_CH;
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&(M25P16_SPI_INSTANCE->DR);
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)&dmaDummy;
+    DMA_InitStructure.DMA_BufferSize = 1;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+    DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+    DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+    DMA_Cmd(M25P16_DMA_TX_ST, DISABLE);
+    DMA_DeInit(M25P16_DMA_TX_ST);
+    DMA_Init(M25P16_DMA_TX_ST, &DMA_InitStructure);
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    DMA_Cmd(M25P16_DMA_RX_ST, DISABLE);
+    DMA_DeInit(M25P16_DMA_RX_ST);
+    DMA_Init(M25P16_DMA_RX_ST, &DMA_InitStructure);
+    DMA_ITConfig(M25P16_DMA_RX_ST, DMA_IT_TC, ENABLE);
+    NVIC_InitStructure.NVIC_IRQChannel = M25P16_DMA_RX_IRQ;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = NVIC_PRIORITY_BASE(NVIC_PRIO_FLASH_DMA);
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = NVIC_PRIORITY_SUB(NVIC_PRIO_FLASH_DMA);
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+    dmaEnabled = true;
+}
+static void m25p16_dmaStart(uint8_t *in, const uint8_t *out, int length)
+{
+    (void)M25P16_SPI_INSTANCE->DR;
+    DMA_ClearFlag(M25P16_DMA_TX_ST, M25P16_DMA_TX_FLAGS);
+    DMA_ClearFlag(M25P16_DMA_RX_ST, M25P16_DMA_RX_FLAGS);
+    if (in) {
+        M25P16_DMA_RX_ST->CR |= DMA_SxCR_MINC;
+        DMA_MemoryTargetConfig(M25P16_DMA_RX_ST, (uint32_t)in, DMA_Memory_0);
+    } else {
+        M25P16_DMA_RX_ST->CR &= ~DMA_SxCR_MINC;
+        DMA_MemoryTargetConfig(M25P16_DMA_RX_ST, (uint32_t)&dmaDummy, DMA_Memory_0);
+    }
+    if (out) {
+        M25P16_DMA_TX_ST->CR |= DMA_SxCR_MINC;
+        DMA_MemoryTargetConfig(M25P16_DMA_TX_ST, (uint32_t)out, DMA_Memory_0);
+    } else {
+        dmaDummy = 0xFF;
+        M25P16_DMA_TX_ST->CR &= ~DMA_SxCR_MINC;
+        DMA_MemoryTargetConfig(M25P16_DMA_TX_ST, (uint32_t)&dmaDummy, DMA_Memory_0);
+    }
+    DMA_SetCurrDataCounter(M25P16_DMA_RX_ST, length);
+    DMA_SetCurrDataCounter(M25P16_DMA_TX_ST, length);
+    dmaBusy = true;
+    DMA_Cmd(M25P16_DMA_RX_ST, ENABLE);
+    DMA_Cmd(M25P16_DMA_TX_ST, ENABLE);
+    SPI_I2S_DMACmd(M25P16_SPI_INSTANCE, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE);
+}
+void M25P16_DMA_RX_IRQ_HANDLER(void)
+{
+    if (DMA_GetFlagStatus(M25P16_DMA_RX_ST, M25P16_DMA_RX_TC_FLAG)) {
+        SPI_I2S_DMACmd(M25P16_SPI_INSTANCE, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE);
+        DMA_Cmd(M25P16_DMA_TX_ST, DISABLE);
+        DMA_Cmd(M25P16_DMA_RX_ST, DISABLE);
+        DMA_ClearFlag(M25P16_DMA_TX_ST, M25P16_DMA_TX_FLAGS);
+        DMA_ClearFlag(M25P16_DMA_RX_ST, M25P16_DMA_RX_FLAGS);
+        DISABLE_M25P16;
+        dmaBusy = false;
+    }
+}
+bool m25p16_isTransferPending()
+{
+    return dmaBusy;
+}
+#endif
 static void m25p16_performOneByteCommand(uint8_t command)
 {
     ENABLE_M25P16;
@@ -70,6 +165,11 @@ static uint8_t m25p16_readStatus()
 }
 bool m25p16_isReady()
 {
+#ifdef M25P16_DMA
+    if (dmaBusy) {
+        return false;
+    }
+#endif
     couldBeBusy = couldBeBusy && ((m25p16_readStatus() & M25P16_STATUS_FLAG_WRITE_IN_PROGRESS) != 0);
     return !couldBeBusy;
 }
@@ -129,6 +229,9 @@ bool m25p16_init()
     IOInit(flashSpim25p16CsPin, OWNER_SYSTEM, RESOURCE_SPI);
  IOConfigGPIO(flashSpim25p16CsPin, SPI_IO_CS_CFG);
     spiSetDivisor(M25P16_SPI_INSTANCE, SPI_ULTRAFAST_CLOCK);
+#ifdef M25P16_DMA
+    m25p16_dmaInit();
+#endif
     return m25p16_readIdentification();
 }
 void m25p16_eraseSector(uint32_t address)
@@ -168,14 +271,33 @@ void m25p16_pageProgram(uint32_t address, const uint8_t *data, int length)
     m25p16_pageProgramContinue(data, length);
     m25p16_pageProgramFinish();
 }
+#ifdef M25P16_DMA
+void m25p16_pageProgramDMA(uint32_t address, const uint8_t *data, int length)
+{
+    if (!dmaEnabled) {
+        m25p16_pageProgram(address, data, length);
+        return;
+    }
+    m25p16_pageProgramBegin(address);
+    m25p16_dmaStart(NULL, data, length);
+}
+#endif
 int m25p16_readBytes(uint32_t address, uint8_t *buffer, int length)
 {
-    uint8_t command[] = { M25P16_INSTRUCTION_READ_BYTES, (address >> 16) & 0xFF, (address >> 8) & 0xFF, address & 0xFF};
+    uint8_t command[] = { M25P16_INSTRUCTION_FAST_READ, (address >> 16) & 0xFF, (address >> 8) & 0xFF, address & 0xFF, 0};
     if (!m25p16_waitForReady(DEFAULT_TIMEOUT_MILLIS)) {
         return 0;
     }
     ENABLE_M25P16;
     spiTransfer(M25P16_SPI_INSTANCE, NULL, command, sizeof(command));
+#ifdef M25P16_DMA
+    if (dmaEnabled) {
+        m25p16_dmaStart(buffer, NULL, length);
+        while (dmaBusy) {
+        }
+        return length;
+    }
+#endif
     spiTransfer(M25P16_SPI_INSTANCE, buffer, NULL, length);
     DISABLE_M25P16;
     return length;
@@ -28,6 +28,8 @@ void m25p16_pageProgram(uint32_t address, const uint8_t *data, int length);
 void m25p16_pageProgramBegin(uint32_t address);
 void m25p16_pageProgramContinue(const uint8_t *data, int length);
 void m25p16_pageProgramFinish();
+void m25p16_pageProgramDMA(uint32_t address, const uint8_t *data, int length);
+bool m25p16_isTransferPending();
 int m25p16_readBytes(uint32_t address, uint8_t *buffer, int length);
 bool m25p16_isReady();
 bool m25p16_waitForReady(uint32_t timeoutMillis);
@@ -26,6 +26,7 @@
 #include "drivers/light_ws2811strip.h"
 uint8_t ledStripDMABuffer[WS2811_DMA_BUFFER_SIZE];
 volatile uint8_t ws2811LedDataTransferInProgress = 0;
+static bool ws2811Initialised = false;
 static hsvColor_t ledColorBuffer[WS2811_LED_STRIP_LENGTH];
 void setLedHsv(uint16_t index, const hsvColor_t *color)
 {
@@ -60,12 +61,15 @@ void setStripColors(const hsvColor_t *colors)
 void ws2811LedStripInit(void)
 {
     memset(&ledStripDMABuffer, 0, WS2811_DMA_BUFFER_SIZE);
-    ws2811LedStripHardwareInit();
-    ws2811UpdateStrip();
+    ws2811Initialised = ws2811LedStripHardwareInit();
+    if (ws2811Initialised) {
+        setStripColor(&hsv_white);
+        ws2811UpdateStrip();
+    }
 }
 bool isWS2811LedStripReady(void)
 {
-    return !ws2811LedDataTransferInProgress;
+    return ws2811Initialised && !ws2811LedDataTransferInProgress;
 }
 STATIC_UNIT_TESTED uint16_t dmaBufferOffset;
 static int16_t ledIndex;
@@ -100,6 +104,9 @@ void ws2811UpdateStrip(void)
 {
     static uint32_t waitCounter = 0;
     static rgbColor24bpp_t *rgb24;
+    if (!ws2811Initialised) {
+        return;
+    }
     while(ws2811LedDataTransferInProgress) {
         waitCounter++;
     }
@@ -26,7 +26,7 @@
 #define BIT_COMPARE_1 17
 #define BIT_COMPARE_0 9
 void ws2811LedStripInit(void);
-void ws2811LedStripHardwareInit(void);
+bool ws2811LedStripHardwareInit(void);
 void ws2811LedStripDMAEnable(void);
 void ws2811UpdateStrip(void);
 void setLedHsv(uint16_t index, const hsvColor_t *color);
@@ -21,14 +21,18 @@
 #include "platform.h"
 #include "common/color.h"
 #include "drivers/light_ws2811strip.h"
+#include "drivers/dma.h"
 #include "nvic.h"
-void ws2811LedStripHardwareInit(void)
+bool ws2811LedStripHardwareInit(void)
 {
     TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
     TIM_OCInitTypeDef TIM_OCInitStructure;
     GPIO_InitTypeDef GPIO_InitStructure;
     DMA_InitTypeDef DMA_InitStructure;
     uint16_t prescalerValue;
+    if (!dmaReserve(DMA1_Channel6, OWNER_LED_STRIP)) {
+        return false;
+    }
 #ifdef CC3D
     RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB, ENABLE);
     GPIO_StructInit(&GPIO_InitStructure);
@@ -83,8 +87,7 @@ void ws2811LedStripHardwareInit(void)
     NVIC_InitStructure.NVIC_IRQChannelSubPriority = NVIC_PRIORITY_SUB(NVIC_PRIO_WS2811_DMA);
     NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStructure);
-    setStripColor(&hsv_white);
-    ws2811UpdateStrip();
+    return true;
 }
 void DMA1_Channel6_IRQHandler(void)
 {
@@ -23,6 +23,7 @@
 #include "nvic.h"
 #include "common/color.h"
 #include "drivers/light_ws2811strip.h"
+#include "drivers/dma.h"
 #ifndef WS2811_GPIO
 #define USE_LED_STRIP_ON_DMA1_CHANNEL3 
 #define WS2811_GPIO GPIOB
@@ -35,13 +36,16 @@
 #define WS2811_DMA_CHANNEL DMA1_Channel3
 #define WS2811_IRQ DMA1_Channel3_IRQn
 #endif
-void ws2811LedStripHardwareInit(void)
+bool ws2811LedStripHardwareInit(void)
 {
     TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
     TIM_OCInitTypeDef TIM_OCInitStructure;
     GPIO_InitTypeDef GPIO_InitStructure;
     DMA_InitTypeDef DMA_InitStructure;
     uint16_t prescalerValue;
+    if (!dmaReserve(WS2811_DMA_CHANNEL, OWNER_LED_STRIP)) {
+        return false;
+    }
     RCC_AHBPeriphClockCmd(WS2811_GPIO_AHB_PERIPHERAL, ENABLE);
     GPIO_PinAFConfig(WS2811_GPIO, WS2811_PIN_SOURCE, WS2811_GPIO_AF);
     GPIO_StructInit(&GPIO_InitStructure);
@@ -90,8 +94,7 @@ void ws2811LedStripHardwareInit(void)
     NVIC_InitStructure.NVIC_IRQChannelSubPriority = NVIC_PRIORITY_SUB(NVIC_PRIO_WS2811_DMA);
     NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStructure);
-    setStripColor(&hsv_white);
-    ws2811UpdateStrip();
+    return true;
 }
 #ifdef USE_LED_STRIP_ON_DMA1_CHANNEL3
 void DMA1_Channel3_IRQHandler(void)
@@ -19,13 +19,17 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "include.h"
-void ws2811LedStripHardwareInit(void)
+#include "drivers/dma.h"
+bool ws2811LedStripHardwareInit(void)
 {
     TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
     TIM_OCInitTypeDef TIM_OCInitStructure;
     GPIO_InitTypeDef GPIO_InitStructure;
     DMA_InitTypeDef DMA_InitStructure;
     uint16_t prescalerValue;
+    if (!dmaReserve(DMA1_Stream2, OWNER_LED_STRIP)) {
+        return false;
+    }
     RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOA, ENABLE);
     RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM5, ENABLE);
     RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_DMA1, ENABLE);
@@ -77,8 +81,7 @@ void ws2811LedStripHardwareInit(void)
     NVIC_InitStructure.NVIC_IRQChannelSubPriority = NVIC_PRIORITY_SUB(NVIC_PRIO_WS2811_DMA);
     NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
     NVIC_Init(&NVIC_InitStructure);
-    setStripColor(&hsv_white);
-    ws2811UpdateStrip();
+    return true;
 }
 void DMA1_Stream2_IRQHandler(void)
 {
@@ -27,6 +27,7 @@
 #define NVIC_PRIO_MPU_INT_EXTI NVIC_BUILD_PRIORITY(3, 3)
 #define NVIC_PRIO_MAG_INT_EXTI NVIC_BUILD_PRIORITY(8, 8)
 #define NVIC_PRIO_WS2811_DMA NVIC_BUILD_PRIORITY(4, 4)
+#define NVIC_PRIO_FLASH_DMA NVIC_BUILD_PRIORITY(5, 5)
 #define NVIC_PRIO_SERIALUART1_TXDMA NVIC_BUILD_PRIORITY(2, 2)
 #define NVIC_PRIO_SERIALUART1_RXDMA NVIC_BUILD_PRIORITY(2, 2)
 #define NVIC_PRIO_SERIALUART1 NVIC_BUILD_PRIORITY(2, 2)
@@ -33,6 +33,8 @@ void pwmOneshotPwmRateMotorConfig(const timerHardware_t *timerHardware, uint8_t
 void pwmOneshotMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex);
 void pwmMultiShotPwmRateMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, uint16_t motorPwmRate, uint16_t idlePulse);
 void pwmMultiShotMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex);
+bool pwmDshotMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, uint8_t dshotRate);
+void pwmDshotFallbackToMultiShot(uint8_t motorCount);
 void pwmServoConfig(const timerHardware_t *timerHardware, uint8_t servoIndex, uint16_t servoPwmRate, uint16_t servoCenterPulse);
 enum {
     MAP_TO_PPM_INPUT = 1,
@@ -1361,6 +1363,7 @@ pwmOutputConfiguration_t *pwmInit(drv_pwm_config_t *init)
     int i = 0;
     const uint16_t *setup;
     int channelIndex = 0;
+    bool dshotFailed = false;
     memset(&pwmOutputConfiguration, 0, sizeof(pwmOutputConfiguration));
     if (init->airplane)
         i = 2;
@@ -1498,38 +1501,38 @@ if (init->useBuzzerP6) {
 #endif
         if (type == MAP_TO_PPM_INPUT) {
 #if defined(REVO) || defined(DEMON) || defined(INVADER)
-            if (init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
+            if (init->useDshot || init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
                 ppmAvoidPWMTimerClash(timerHardwarePtr, TIM12);
                 ppmAvoidPWMTimerClash(timerHardwarePtr, TIM8);
             }
 #endif
 #ifdef REVONANO
-            if (init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
+            if (init->useDshot || init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
                 ppmAvoidPWMTimerClash(timerHardwarePtr, TIM2);
             }
 #endif
 #ifdef SPARKY2
-            if (init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
+            if (init->useDshot || init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
                 ppmAvoidPWMTimerClash(timerHardwarePtr, TIM8);
             }
 #endif
 #ifdef ALIENFLIGHTF4
-            if (init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
+            if (init->useDshot || init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
                 ppmAvoidPWMTimerClash(timerHardwarePtr, TIM1);
             }
 #endif
 #ifdef VRCORE
-            if (init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
+            if (init->useDshot || init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
                 ppmAvoidPWMTimerClash(timerHardwarePtr, TIM1);
             }
 #endif
 #ifdef CC3D
-            if (init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
+            if (init->useDshot || init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
                 ppmAvoidPWMTimerClash(timerHardwarePtr, TIM4);
             }
 #endif
 #ifdef SPARKY
-            if (init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
+            if (init->useDshot || init->useMultiShot || init->useOneshot || isMotorBrushed(init->motorPwmRate)) {
                 ppmAvoidPWMTimerClash(timerHardwarePtr, TIM2);
             }
 #endif
@@ -1538,7 +1541,16 @@ if (init->useBuzzerP6) {
             pwmInConfig(timerHardwarePtr, channelIndex);
             channelIndex++;
         } else if (type == MAP_TO_MOTOR_OUTPUT) {
-            if (init->useOneshot)
+            if (init->useDshot) {
+                if (pwmDshotMotorConfig(timerHardwarePtr, pwmOutputConfiguration.motorCount, init->dshotRate)) {
+                    pwmOutputConfiguration.portConfigurations[pwmOutputConfiguration.outputCount].flags = PWM_PF_MOTOR | PWM_PF_OUTPUT_PROTOCOL_DSHOT;
+                } else {
+                    dshotFailed = true;
+                    pwmMultiShotMotorConfig(timerHardwarePtr, pwmOutputConfiguration.motorCount);
+                    pwmOutputConfiguration.portConfigurations[pwmOutputConfiguration.outputCount].flags = PWM_PF_MOTOR | PWM_PF_OUTPUT_PROTOCOL_MULTISHOT|PWM_PF_OUTPUT_PROTOCOL_PWM ;
+                }
+            }
+            else if (init->useOneshot)
             {
                 if (init->useFastPWM)
                 {
@@ -1588,5 +1600,15 @@ if (init->useBuzzerP6) {
 #endif
         }
     }
+    if (dshotFailed) {
+        pwmDshotFallbackToMultiShot(pwmOutputConfiguration.motorCount);
+        for (i = 0; i < pwmOutputConfiguration.outputCount; i++) {
+            if (pwmOutputConfiguration.portConfigurations[i].flags & PWM_PF_OUTPUT_PROTOCOL_DSHOT) {
+                pwmOutputConfiguration.portConfigurations[i].flags = PWM_PF_MOTOR | PWM_PF_OUTPUT_PROTOCOL_MULTISHOT|PWM_PF_OUTPUT_PROTOCOL_PWM ;
+            }
+        }
+        pwmOutputConfiguration.dshotFallback = true;
+    }
+    ppmCaptureDmaInit();
     return &pwmOutputConfiguration;
 }
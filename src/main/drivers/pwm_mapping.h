@@ -38,6 +38,14 @@
 #define MULTISHOT_TIMER_MHZ 24
 #endif
 #define PWM_BRUSHED_TIMER_MHZ 8
+#if defined(STM32F40_41xxx) || defined(STM32F411xE) || defined(STM32F446xx) || defined(STM32F303)
+#define USE_DSHOT
+#endif
+typedef enum {
+    DSHOT_RATE_150 = 0,
+    DSHOT_RATE_300,
+    DSHOT_RATE_600
+} dshotRate_e;
 typedef struct sonarGPIOConfig_s {
     GPIO_TypeDef *gpio;
     uint16_t triggerPin;
@@ -64,6 +72,7 @@ typedef struct drv_pwm_config_s {
     bool useVbat;
  bool useOneshot;
  bool useMultiShot;
+ bool useDshot;
  bool usePwmRate;
     bool useFastPWM;
     bool useSoftSerial;
@@ -83,6 +92,7 @@ typedef struct drv_pwm_config_s {
     bool airplane;
     uint16_t motorPwmRate;
     uint16_t idlePulse;
+    uint8_t dshotRate;
     sonarGPIOConfig_t *sonarGPIOConfig;
 } drv_pwm_config_t;
 typedef enum {
@@ -92,7 +102,8 @@ typedef enum {
   PWM_PF_MOTOR_MODE_BRUSHED = (1 << 2),
   PWM_PF_OUTPUT_PROTOCOL_PWM = (1 << 3),
   PWM_PF_OUTPUT_PROTOCOL_ONESHOT = (1 << 4),
-  PWM_PF_OUTPUT_PROTOCOL_MULTISHOT = (1 << 5)
+  PWM_PF_OUTPUT_PROTOCOL_MULTISHOT = (1 << 5),
+  PWM_PF_OUTPUT_PROTOCOL_DSHOT = (1 << 6)
 } pwmPortFlags_e;
 typedef struct pwmPortConfiguration_s {
     uint8_t index;
@@ -103,6 +114,7 @@ typedef struct pwmOutputConfiguration_s {
     uint8_t servoCount;
     uint8_t motorCount;
     uint8_t outputCount;
+    bool dshotFallback;
     pwmPortConfiguration_t portConfigurations[MAX_PWM_OUTPUT_PORTS];
 } pwmOutputConfiguration_t;
 enum {
@@ -20,17 +20,73 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include "platform.h"
+#include "build_config.h"
 #include "gpio.h"
 #include "timer.h"
+#include "system.h"
+#include "dma.h"
+#include "dshot.h"
 #include "flight/failsafe.h"
 #include "pwm_mapping.h"
 #include "pwm_output.h"
-typedef void (*pwmWriteFuncPtr)(uint8_t index, uint16_t value);
+#define DSHOT_BUFFER_LENGTH (DSHOT_FRAME_BITS + 2)
+#define DSHOT_MAX_TIMERS 4
+#ifdef USE_DSHOT
+#if defined(STM32F40_41xxx) || defined(STM32F411xE) || defined(STM32F446xx)
+typedef DMA_Stream_TypeDef dshotDmaRef_t;
+#define DSHOT_DMA_FLAGS(n) (DMA_FLAG_FEIF##n | DMA_FLAG_DMEIF##n | DMA_FLAG_TEIF##n | DMA_FLAG_HTIF##n | DMA_FLAG_TCIF##n)
+#else
+typedef DMA_Channel_TypeDef dshotDmaRef_t;
+#endif
+typedef struct {
+    TIM_TypeDef *tim;
+    dshotDmaRef_t *dmaRef;
+    uint32_t dmaChannel;
+    uint32_t dmaFlags;
+} dshotDmaHardware_t;
+static const dshotDmaHardware_t dshotDmaHardware[] = {
+#if defined(STM32F40_41xxx) || defined(STM32F411xE) || defined(STM32F446xx)
+    { TIM1, DMA2_Stream5, DMA_Channel_6, DSHOT_DMA_FLAGS(5) },
+    { TIM2, DMA1_Stream7, DMA_Channel_3, DSHOT_DMA_FLAGS(7) },
+    { TIM3, DMA1_Stream2, DMA_Channel_5, DSHOT_DMA_FLAGS(2) },
+    { TIM4, DMA1_Stream6, DMA_Channel_2, DSHOT_DMA_FLAGS(6) },
+    { TIM5, DMA1_Stream0, DMA_Channel_6, DSHOT_DMA_FLAGS(0) },
+#if defined(STM32F40_41xxx) || defined(STM32F446xx)
+    { TIM8, DMA2_Stream1, DMA_Channel_7, DSHOT_DMA_FLAGS(1) },
+#endif
+#else
+    { TIM1, DMA1_Channel5, 0, DMA1_FLAG_GL5 },
+    { TIM2, DMA1_Channel2, 0, DMA1_FLAG_GL2 },
+    { TIM3, DMA1_Channel3, 0, DMA1_FLAG_GL3 },
+    { TIM4, DMA1_Channel7, 0, DMA1_FLAG_GL7 },
+    { TIM8, DMA2_Channel1, 0, DMA2_FLAG_GL1 },
+    { TIM15, DMA1_Channel5, 0, DMA1_FLAG_GL5 },
+    { TIM16, DMA1_Channel3, 0, DMA1_FLAG_GL3 },
+    { TIM17, DMA1_Channel1, 0, DMA1_FLAG_GL1 },
+#endif
+};
+typedef struct {
+    const dshotDmaHardware_t *dma;
+    uint8_t channelMask;
+    uint8_t firstChannel;
+    uint8_t channelCount;
+    uint32_t buffer[DSHOT_BUFFER_LENGTH * 4];
+} dshotTimer_t;
+static dshotTimer_t dshotTimers[DSHOT_MAX_TIMERS];
+static uint8_t dshotTimerCount = 0;
+static const uint8_t dshotTimerMhz[] = { 3, 6, 12 };
+#endif
 typedef struct {
     volatile timCCR_t *ccr;
     TIM_TypeDef *tim;
     uint16_t period;
-    pwmWriteFuncPtr pwmWritePtr;
+    uint32_t scale;
+    uint16_t offset;
+#ifdef USE_DSHOT
+    dshotTimer_t *dshotTimer;
+    uint8_t dshotChannel;
+    bool dshotTelemetryRequest;
+#endif
 } pwmOutputPort_t;
 static pwmOutputPort_t pwmOutputPorts[MAX_PWM_OUTPUT_PORTS];
 static pwmOutputPort_t *motors[MAX_PWM_MOTORS];
@@ -39,6 +95,12 @@ static pwmOutputPort_t *servos[MAX_PWM_SERVOS];
 #endif
 static uint8_t allocatedOutputPortCount = 0;
 static bool pwmMotorsEnabled = true;
+static TIM_TypeDef *motorTimers[MAX_PWM_MOTORS];
+static uint8_t motorTimerCount = 0;
+static uint8_t motorTimersBuiltFor = 0;
+static bool motorSkewMeasure = false;
+static uint32_t motorSkewCycles = 0;
+static uint32_t motorSkewMaxCycles = 0;
 #ifdef STM32F303
 static void pwmOCConfig(TIM_TypeDef *tim, uint8_t channel, uint16_t value, uint8_t ouputPolarity)
 #else
@@ -76,19 +138,19 @@ static void pwmOCConfig(TIM_TypeDef *tim, uint8_t channel, uint16_t value)
             break;
     }
 }
-static void pwmGPIOConfig(GPIO_TypeDef *gpio, uint32_t pin, GPIO_Mode mode)
+static void pwmGPIOConfig(GPIO_TypeDef *gpio, uint32_t pin, GPIO_Mode mode, GPIO_Speed speed)
 {
     gpio_config_t cfg;
     cfg.pin = pin;
     cfg.mode = mode;
-    cfg.speed = Speed_2MHz;
+    cfg.speed = speed;
     gpioInit(gpio, &cfg);
 }
 static pwmOutputPort_t *pwmOutConfig(const timerHardware_t *timerHardware, uint8_t mhz, uint16_t period, uint16_t value)
 {
     pwmOutputPort_t *p = &pwmOutputPorts[allocatedOutputPortCount++];
     configTimeBase(timerHardware->tim, period, mhz);
-    pwmGPIOConfig(timerHardware->gpio, timerHardware->pin, Mode_AF_PP);
+    pwmGPIOConfig(timerHardware->gpio, timerHardware->pin, Mode_AF_PP, Speed_2MHz);
 #ifdef STM32F303
     pwmOCConfig(timerHardware->tim, timerHardware->channel, value, timerHardware->outputInverted);
 #else
@@ -115,36 +177,227 @@ static pwmOutputPort_t *pwmOutConfig(const timerHardware_t *timerHardware, uint8
     p->tim = timerHardware->tim;
     return p;
 }
-static void pwmWriteBrushed(uint8_t index, uint16_t value)
+static void pwmMotorScale(pwmOutputPort_t *p, uint32_t mul, uint32_t div, uint16_t offset)
+{
+    p->scale = (mul << 16) / div;
+    p->offset = offset;
+}
+static inline uint16_t pwmMotorPulse(const pwmOutputPort_t *p, uint16_t value)
+{
+    int32_t pulse = ((((int32_t)value - 1000) * (int32_t)p->scale + 0x8000) >> 16) + p->offset;
+    return pulse > 0 ? pulse : 0;
+}
+static bool pwmIsDshotPort(const pwmOutputPort_t *p)
+{
+#ifdef USE_DSHOT
+    return p->dshotTimer != NULL;
+#else
+    UNUSED(p);
+    return false;
+#endif
+}
+static void pwmBuildMotorTimers(uint8_t motorCount)
 {
-    *motors[index]->ccr = (uint16_t)((float)((value - 1000) * motors[index]->period / 1000));
+    uint8_t index, i;
+    motorTimerCount = 0;
+    for (index = 0; index < motorCount; index++) {
+        if (!motors[index] || pwmIsDshotPort(motors[index]))
+            continue;
+        for (i = 0; i < motorTimerCount && motorTimers[i] != motors[index]->tim; i++);
+        if (i == motorTimerCount)
+            motorTimers[motorTimerCount++] = motors[index]->tim;
+    }
+    motorTimersBuiltFor = motorCount;
+}
+static void pwmRecordMotorSkew(uint32_t cycles)
+{
+    motorSkewCycles = cycles;
+    if (cycles > motorSkewMaxCycles)
+        motorSkewMaxCycles = cycles;
+}
+void pwmSetMotorSkewMeasurement(bool enabled)
+{
+    motorSkewMeasure = enabled;
+    motorSkewCycles = motorSkewMaxCycles = 0;
+    if (enabled)
+        enableCycleCounter();
 }
-static void pwmWriteStandard(uint8_t index, uint16_t value)
+bool pwmGetMotorSkew(uint32_t *skewNs, uint32_t *maxSkewNs)
 {
-    *motors[index]->ccr = value;
+    uint32_t cyclesPerUs = SystemCoreClock / 1000000;
+    *skewNs = motorSkewCycles * 1000 / cyclesPerUs;
+    *maxSkewNs = motorSkewMaxCycles * 1000 / cyclesPerUs;
+    return motorSkewMeasure;
+}
+#ifdef USE_DSHOT
+static bool dshotDmaBusy(const dshotTimer_t *dshotTimer)
+{
+#if defined(STM32F40_41xxx) || defined(STM32F411xE) || defined(STM32F446xx)
+    return (dshotTimer->dma->dmaRef->CR & DMA_SxCR_EN) && DMA_GetCurrDataCounter(dshotTimer->dma->dmaRef);
+#else
+    return (dshotTimer->dma->dmaRef->CCR & DMA_CCR_EN) && DMA_GetCurrDataCounter(dshotTimer->dma->dmaRef);
+#endif
 }
-static void pwmWriteOneshot(uint8_t index, uint16_t value)
+static void pwmWriteDshot(uint8_t index, uint16_t value)
 {
-    *motors[index]->ccr = (uint16_t)((float)value);
+    dshotTimer_t *dshotTimer = motors[index]->dshotTimer;
+    if (dshotDmaBusy(dshotTimer))
+        return;
+    uint16_t frame = dshotEncodeFrame(dshotThrottle(value), motors[index]->dshotTelemetryRequest);
+    motors[index]->dshotTelemetryRequest = false;
+    dshotFillBuffer(&dshotTimer->buffer[motors[index]->dshotChannel - dshotTimer->firstChannel], dshotTimer->channelCount, frame);
 }
-static void pwmWriteMultiShot(uint8_t index, uint16_t value)
+static void dshotDmaConfig(dshotTimer_t *dshotTimer)
 {
+    const dshotDmaHardware_t *dma = dshotTimer->dma;
+    DMA_InitTypeDef DMA_InitStructure;
+    uint8_t bufferLength = DSHOT_BUFFER_LENGTH * dshotTimer->channelCount;
+    uint8_t i;
+    for (i = 0; i < DSHOT_BUFFER_LENGTH * 4; i++)
+        dshotTimer->buffer[i] = 0;
+    DMA_Cmd(dma->dmaRef, DISABLE);
+    DMA_DeInit(dma->dmaRef);
+    DMA_StructInit(&DMA_InitStructure);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&dma->tim->DMAR;
+    DMA_InitStructure.DMA_BufferSize = bufferLength;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Word;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Word;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_VeryHigh;
 #if defined(STM32F40_41xxx) || defined(STM32F411xE) || defined(STM32F446xx)
-    *motors[index]->ccr = (uint16_t)((float)(value-1000) / 1.04166f)+ 240;
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_DMA1 | RCC_AHB1Periph_DMA2, ENABLE);
+    DMA_InitStructure.DMA_Channel = dma->dmaChannel;
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)dshotTimer->buffer;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+    DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Enable;
+    DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_1QuarterFull;
+    DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+    DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
 #else
-    *motors[index]->ccr = (uint16_t)((float)(value-1000) / 2.08333f)+ 120;
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1 | RCC_AHBPeriph_DMA2, ENABLE);
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)dshotTimer->buffer;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
 #endif
+    DMA_Init(dma->dmaRef, &DMA_InitStructure);
+    TIM_DMAConfig(dma->tim, TIM_DMABase_CCR1 + dshotTimer->firstChannel, (uint16_t)(dshotTimer->channelCount - 1) << 8);
+    TIM_DMACmd(dma->tim, TIM_DMA_Update, ENABLE);
+}
+static void dshotSyncTimers(void)
+{
+    uint8_t i;
+    for (i = 0; i < dshotTimerCount; i++)
+        dshotTimers[i].dma->tim->CR1 &= ~TIM_CR1_CEN;
+    for (i = 0; i < dshotTimerCount; i++)
+        dshotTimers[i].dma->tim->EGR = TIM_EGR_UG;
+    for (i = 0; i < dshotTimerCount; i++)
+        dshotTimers[i].dma->tim->CR1 |= TIM_CR1_CEN;
+}
+static dshotTimer_t *dshotTimerForTimer(TIM_TypeDef *tim)
+{
+    const dshotDmaHardware_t *dma = NULL;
+    uint8_t i;
+    for (i = 0; i < dshotTimerCount; i++) {
+        if (dshotTimers[i].dma->tim == tim)
+            return &dshotTimers[i];
+    }
+    if (dshotTimerCount >= DSHOT_MAX_TIMERS)
+        return NULL;
+    for (i = 0; i < sizeof(dshotDmaHardware) / sizeof(dshotDmaHardware[0]); i++) {
+        if (dshotDmaHardware[i].tim == tim) {
+            dma = &dshotDmaHardware[i];
+            break;
+        }
+    }
+    if (!dma)
+        return NULL;
+    for (i = 0; i < dshotTimerCount; i++) {
+        if (dshotTimers[i].dma->dmaRef == dma->dmaRef)
+            return NULL;
+    }
+    if (!dmaReserve(dma->dmaRef, OWNER_PWMOUTPUT_MOTOR))
+        return NULL;
+    dshotTimers[dshotTimerCount].dma = dma;
+    return &dshotTimers[dshotTimerCount++];
+}
+bool pwmDshotMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, uint8_t dshotRate)
+{
+    dshotTimer_t *dshotTimer = dshotTimerForTimer(timerHardware->tim);
+    uint8_t channel = timerHardware->channel >> 2;
+    uint8_t lastChannel = channel;
+    if (!dshotTimer)
+        return false;
+    motors[motorIndex] = pwmOutConfig(timerHardware, dshotTimerMhz[dshotRate], DSHOT_BIT_PERIOD, 0);
+    pwmGPIOConfig(timerHardware->gpio, timerHardware->pin, Mode_AF_PP, Speed_50MHz);
+    motors[motorIndex]->dshotTimer = dshotTimer;
+    motors[motorIndex]->dshotChannel = channel;
+    dshotTimer->channelMask |= 1 << channel;
+    dshotTimer->firstChannel = channel;
+    while (dshotTimer->firstChannel > 0 && (dshotTimer->channelMask & ((1 << dshotTimer->firstChannel) - 1)))
+        dshotTimer->firstChannel--;
+    while (dshotTimer->channelMask >> (lastChannel + 1))
+        lastChannel++;
+    dshotTimer->channelCount = lastChannel - dshotTimer->firstChannel + 1;
+    dshotDmaConfig(dshotTimer);
+    dshotSyncTimers();
+    return true;
+}
+void pwmRequestDshotTelemetry(uint8_t index)
+{
+    if (index < MAX_MOTORS && motors[index] && pwmIsDshotPort(motors[index]))
+        motors[index]->dshotTelemetryRequest = true;
+}
+#else
+void pwmRequestDshotTelemetry(uint8_t index)
+{
+    UNUSED(index);
+}
+bool pwmDshotMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, uint8_t dshotRate)
+{
+    UNUSED(timerHardware);
+    UNUSED(motorIndex);
+    UNUSED(dshotRate);
+    return false;
 }
+#endif
 void pwmWriteMotor(uint8_t index, uint16_t value)
 {
-    if (motors[index] && index < MAX_MOTORS && pwmMotorsEnabled)
-        motors[index]->pwmWritePtr(index, value);
+    if (motors[index] && index < MAX_MOTORS && pwmMotorsEnabled) {
+#ifdef USE_DSHOT
+        if (motors[index]->dshotTimer) {
+            pwmWriteDshot(index, value);
+            return;
+        }
+#endif
+        *motors[index]->ccr = pwmMotorPulse(motors[index], value);
+    }
+}
+void pwmWriteMotors(const int16_t *values, uint8_t motorCount)
+{
+    uint8_t index;
+    if (!pwmMotorsEnabled)
+        return;
+    for (index = 0; index < motorCount; index++) {
+        pwmOutputPort_t *p = motors[index];
+        if (!p)
+            continue;
+#ifdef USE_DSHOT
+        if (p->dshotTimer) {
+            pwmWriteDshot(index, values[index]);
+            continue;
+        }
+#endif
+        *p->ccr = pwmMotorPulse(p, values[index]);
+    }
 }
 void pwmShutdownPulsesForAllMotors(uint8_t motorCount)
 {
     uint8_t index;
     for(index = 0; index < motorCount; index++){
-        *motors[index]->ccr = 0;
+        if (motors[index])
+            *motors[index]->ccr = 0;
     }
 }
 void pwmDisableMotors(void)
@@ -158,60 +411,127 @@ void pwmEnableMotors(void)
 void pwmCompleteOneshotMotorUpdate(uint8_t motorCount)
 {
     uint8_t index;
-    TIM_TypeDef *lastTimerPtr = NULL;
+    uint32_t skew;
+    if (motorTimersBuiltFor != motorCount)
+        pwmBuildMotorTimers(motorCount);
+    if (!motorTimerCount)
+        return;
+    skew = timerForceOverflowSync(motorTimers, motorTimerCount, motorSkewMeasure);
+    if (motorSkewMeasure)
+        pwmRecordMotorSkew(skew);
     for(index = 0; index < motorCount; index++)
     {
-        if(motors[index]->tim != lastTimerPtr)
-        {
-            lastTimerPtr = motors[index]->tim;
-            timerForceOverflow(motors[index]->tim);
-        }
-        *motors[index]->ccr = 0;
+        if (motors[index] && !pwmIsDshotPort(motors[index]))
+            *motors[index]->ccr = 0;
+    }
+}
+void pwmCompleteDshotMotorUpdate(uint8_t motorCount)
+{
+#ifdef USE_DSHOT
+    dshotTimer_t *ready[DSHOT_MAX_TIMERS];
+    uint8_t readyCount = 0;
+    uint8_t index;
+    uint32_t start = 0;
+    for (index = 0; index < dshotTimerCount; index++) {
+        dshotTimer_t *dshotTimer = &dshotTimers[index];
+        if (dshotDmaBusy(dshotTimer))
+            continue;
+        DMA_Cmd(dshotTimer->dma->dmaRef, DISABLE);
+#if defined(STM32F40_41xxx) || defined(STM32F411xE) || defined(STM32F446xx)
+        DMA_ClearFlag(dshotTimer->dma->dmaRef, dshotTimer->dma->dmaFlags);
+#else
+        DMA_ClearFlag(dshotTimer->dma->dmaFlags);
+#endif
+        DMA_SetCurrDataCounter(dshotTimer->dma->dmaRef, DSHOT_BUFFER_LENGTH * dshotTimer->channelCount);
+        ready[readyCount++] = dshotTimer;
+    }
+    if (motorSkewMeasure)
+        start = cycleCount();
+    for (index = 0; index < readyCount; index++) {
+        DMA_Cmd(ready[index]->dma->dmaRef, ENABLE);
     }
+    if (motorSkewMeasure && readyCount)
+        pwmRecordMotorSkew(cycleCount() - start);
+#endif
+    pwmCompleteOneshotMotorUpdate(motorCount);
 }
 bool isMotorBrushed(uint16_t motorPwmRate)
 {
     return (motorPwmRate > 500);
 }
+static void pwmMultiShotScale(pwmOutputPort_t *p)
+{
+#if defined(STM32F40_41xxx) || defined(STM32F411xE) || defined(STM32F446xx)
+    pwmMotorScale(p, 24, 25, 240);
+#else
+    pwmMotorScale(p, 12, 25, 120);
+#endif
+}
 void pwmBrushedMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, uint16_t motorPwmRate, uint16_t idlePulse)
 {
     uint32_t hz = PWM_BRUSHED_TIMER_MHZ * 1000000;
     motors[motorIndex] = pwmOutConfig(timerHardware, PWM_BRUSHED_TIMER_MHZ, hz / motorPwmRate, idlePulse);
-    motors[motorIndex]->pwmWritePtr = pwmWriteBrushed;
+    pwmMotorScale(motors[motorIndex], motors[motorIndex]->period, 1000, 0);
 }
 void pwmBrushlessMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, uint16_t motorPwmRate, uint16_t idlePulse)
 {
     uint32_t hz = PWM_TIMER_MHZ * 1000000;
     motors[motorIndex] = pwmOutConfig(timerHardware, PWM_TIMER_MHZ, hz / motorPwmRate, idlePulse);
-    motors[motorIndex]->pwmWritePtr = pwmWriteStandard;
+    pwmMotorScale(motors[motorIndex], 1, 1, 1000);
 }
 void fastPWMMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, uint16_t motorPwmRate, uint16_t idlePulse)
 {
     uint32_t hz = PWM_BRUSHED_TIMER_MHZ * 1000000;
     motors[motorIndex] = pwmOutConfig(timerHardware, PWM_BRUSHED_TIMER_MHZ, hz / motorPwmRate, idlePulse);
-    motors[motorIndex]->pwmWritePtr = pwmWriteStandard;
+    pwmMotorScale(motors[motorIndex], 1, 1, 1000);
 }
 void pwmOneshotPwmRateMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, uint16_t motorPwmRate, uint16_t idlePulse)
 {
     uint32_t hz = ONESHOT125_TIMER_MHZ * 1000000;
     motors[motorIndex] = pwmOutConfig(timerHardware, ONESHOT125_TIMER_MHZ, hz / motorPwmRate, idlePulse);
-    motors[motorIndex]->pwmWritePtr = pwmWriteOneshot;
+    pwmMotorScale(motors[motorIndex], 1, 1, 1000);
 }
 void pwmOneshotMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex)
 {
     motors[motorIndex] = pwmOutConfig(timerHardware, ONESHOT125_TIMER_MHZ, 0xFFFF, 0);
-    motors[motorIndex]->pwmWritePtr = pwmWriteOneshot;
+    pwmMotorScale(motors[motorIndex], 1, 1, 1000);
 }
 void pwmMultiShotPwmRateMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex, uint16_t motorPwmRate, uint16_t idlePulse)
 {
     uint32_t hz = MULTISHOT_TIMER_MHZ * 1000000;
     motors[motorIndex] = pwmOutConfig(timerHardware, MULTISHOT_TIMER_MHZ, hz / motorPwmRate, idlePulse);
-    motors[motorIndex]->pwmWritePtr = pwmWriteMultiShot;
+    pwmMultiShotScale(motors[motorIndex]);
 }
 void pwmMultiShotMotorConfig(const timerHardware_t *timerHardware, uint8_t motorIndex)
 {
     motors[motorIndex] = pwmOutConfig(timerHardware, MULTISHOT_TIMER_MHZ, 0xFFFF, 0);
-    motors[motorIndex]->pwmWritePtr = pwmWriteMultiShot;
+    pwmMultiShotScale(motors[motorIndex]);
+}
+void pwmDshotFallbackToMultiShot(uint8_t motorCount)
+{
+#ifdef USE_DSHOT
+    uint8_t index;
+    for (index = 0; index < dshotTimerCount; index++) {
+        TIM_DMACmd(dshotTimers[index].dma->tim, TIM_DMA_Update, DISABLE);
+        DMA_Cmd(dshotTimers[index].dma->dmaRef, DISABLE);
+        dmaRelease(dshotTimers[index].dma->dmaRef, OWNER_PWMOUTPUT_MOTOR);
+        dshotTimers[index].channelMask = 0;
+    }
+    dshotTimerCount = 0;
+    for (index = 0; index < motorCount; index++) {
+        pwmOutputPort_t *p = motors[index];
+        if (!p || !p->dshotTimer)
+            continue;
+        p->dshotTimer = NULL;
+        p->period = 0xFFFF;
+        configTimeBase(p->tim, p->period, MULTISHOT_TIMER_MHZ);
+        *p->ccr = 0;
+        pwmMultiShotScale(p);
+    }
+    motorTimersBuiltFor = 0;
+#else
+    UNUSED(motorCount);
+#endif
 }
 #ifdef USE_SERVOS
 void pwmServoConfig(const timerHardware_t *timerHardware, uint8_t servoIndex, uint16_t servoPwmRate, uint16_t servoCenterPulse)
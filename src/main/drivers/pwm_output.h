@@ -19,8 +19,13 @@
 #pragma once 
        
 void pwmWriteMotor(uint8_t index, uint16_t value);
+void pwmWriteMotors(const int16_t *values, uint8_t motorCount);
 void pwmShutdownPulsesForAllMotors(uint8_t motorCount);
 void pwmCompleteOneshotMotorUpdate(uint8_t motorCount);
+void pwmCompleteDshotMotorUpdate(uint8_t motorCount);
+void pwmRequestDshotTelemetry(uint8_t index);
+void pwmSetMotorSkewMeasurement(bool enabled);
+bool pwmGetMotorSkew(uint32_t *skewNs, uint32_t *maxSkewNs);
 void pwmEnableMotors(void);
 void pwmDisableMotors(void);
 void pwmWriteServo(uint8_t index, uint16_t value);
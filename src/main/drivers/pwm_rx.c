@@ -28,6 +28,7 @@
 #include "timer.h"
 #include "pwm_mapping.h"
 #include "pwm_rx.h"
+#include "dma.h"
 #define PPM_CAPTURE_COUNT 12
 #define PWM_INPUT_PORT_COUNT 8
 #if PPM_CAPTURE_COUNT > MAX_PWM_INPUT_PORTS
@@ -74,6 +75,46 @@ typedef struct ppmDevice_s {
     bool tracking;
 } ppmDevice_t;
 ppmDevice_t ppmDev;
+#ifdef PPM_CAPTURE_DMA
+#define PPM_DMA_RING_SIZE 128
+typedef struct ppmDmaHardware_s {
+    TIM_TypeDef *tim;
+    uint16_t channel;
+    DMA_Stream_TypeDef *stream;
+    uint32_t dmaChannel;
+} ppmDmaHardware_t;
+static const ppmDmaHardware_t ppmDmaHardware[] = {
+    { TIM1, TIM_Channel_1, DMA2_Stream1, DMA_Channel_6 },
+    { TIM1, TIM_Channel_2, DMA2_Stream2, DMA_Channel_6 },
+    { TIM1, TIM_Channel_3, DMA2_Stream6, DMA_Channel_6 },
+    { TIM1, TIM_Channel_4, DMA2_Stream4, DMA_Channel_6 },
+    { TIM2, TIM_Channel_1, DMA1_Stream5, DMA_Channel_3 },
+    { TIM2, TIM_Channel_2, DMA1_Stream6, DMA_Channel_3 },
+    { TIM2, TIM_Channel_3, DMA1_Stream1, DMA_Channel_3 },
+    { TIM2, TIM_Channel_4, DMA1_Stream7, DMA_Channel_3 },
+    { TIM3, TIM_Channel_1, DMA1_Stream4, DMA_Channel_5 },
+    { TIM3, TIM_Channel_2, DMA1_Stream5, DMA_Channel_5 },
+    { TIM3, TIM_Channel_3, DMA1_Stream7, DMA_Channel_5 },
+    { TIM3, TIM_Channel_4, DMA1_Stream2, DMA_Channel_5 },
+    { TIM4, TIM_Channel_1, DMA1_Stream0, DMA_Channel_2 },
+    { TIM4, TIM_Channel_2, DMA1_Stream3, DMA_Channel_2 },
+    { TIM4, TIM_Channel_3, DMA1_Stream7, DMA_Channel_2 },
+    { TIM5, TIM_Channel_1, DMA1_Stream2, DMA_Channel_6 },
+    { TIM5, TIM_Channel_2, DMA1_Stream4, DMA_Channel_6 },
+    { TIM5, TIM_Channel_3, DMA1_Stream0, DMA_Channel_6 },
+    { TIM5, TIM_Channel_4, DMA1_Stream1, DMA_Channel_6 },
+    { TIM8, TIM_Channel_1, DMA2_Stream2, DMA_Channel_7 },
+    { TIM8, TIM_Channel_2, DMA2_Stream3, DMA_Channel_7 },
+    { TIM8, TIM_Channel_3, DMA2_Stream4, DMA_Channel_7 },
+    { TIM8, TIM_Channel_4, DMA2_Stream7, DMA_Channel_7 },
+};
+static const timerHardware_t *ppmDmaTimerHardware = NULL;
+static DMA_Stream_TypeDef *ppmDmaStream = NULL;
+STATIC_UNIT_TESTED volatile uint16_t ppmDmaRing[PPM_DMA_RING_SIZE];
+static uint16_t ppmDmaTail = 0;
+static uint16_t ppmDmaLastCapture = 0;
+static uint32_t ppmDmaTime = 0;
+#endif
 #define PPM_IN_MIN_SYNC_PULSE_US 2700
 #define PPM_IN_MIN_CHANNEL_PULSE_US 750
 #define PPM_IN_MAX_CHANNEL_PULSE_US 2250
@@ -110,16 +151,11 @@ static void ppmOverflowCallback(timerOvrHandlerRec_t* cbRec, captureCompare_t ca
     UNUSED(cbRec);
     ppmDev.largeCounter += capture + 1;
 }
-static void ppmEdgeCallback(timerCCHandlerRec_t* cbRec, captureCompare_t capture)
+STATIC_UNIT_TESTED void ppmProcessEdge(uint32_t currentTime)
 {
-    UNUSED(cbRec);
     int32_t i;
     ppmDev.previousTime = ppmDev.currentTime;
-    ppmDev.currentTime = capture;
-    ppmDev.currentTime += ppmDev.largeCounter;
-    if (ppmCountShift > 1) {
-     ppmDev.currentTime = ppmDev.currentTime / ppmCountShift;
-    }
+    ppmDev.currentTime = currentTime;
     ppmDev.deltaTime = ppmDev.currentTime - ppmDev.previousTime;
     ppmDev.previousTime = ppmDev.currentTime;
 #if 0
@@ -166,6 +202,67 @@ static void ppmEdgeCallback(timerCCHandlerRec_t* cbRec, captureCompare_t capture
         }
     }
 }
+static void ppmEdgeCallback(timerCCHandlerRec_t* cbRec, captureCompare_t capture)
+{
+    UNUSED(cbRec);
+    uint32_t currentTime = capture + ppmDev.largeCounter;
+    if (ppmCountShift > 1) {
+     currentTime = currentTime / ppmCountShift;
+    }
+    ppmProcessEdge(currentTime);
+}
+void ppmCaptureProcess(void)
+{
+#ifdef PPM_CAPTURE_DMA
+    if (!ppmDmaStream) {
+        return;
+    }
+    const uint16_t head = (PPM_DMA_RING_SIZE - DMA_GetCurrDataCounter(ppmDmaStream)) % PPM_DMA_RING_SIZE;
+    while (ppmDmaTail != head) {
+        const uint16_t capture = ppmDmaRing[ppmDmaTail];
+        ppmDmaTail = (ppmDmaTail + 1) % PPM_DMA_RING_SIZE;
+        ppmDmaTime += (uint16_t)(capture - ppmDmaLastCapture);
+        ppmDmaLastCapture = capture;
+        ppmProcessEdge(ppmDmaTime);
+    }
+#endif
+}
+#ifdef PPM_CAPTURE_DMA
+static bool ppmDmaConfig(const timerHardware_t *timerHardwarePtr)
+{
+    const ppmDmaHardware_t *dma = NULL;
+    DMA_InitTypeDef DMA_InitStructure;
+    for (uint8_t i = 0; i < ARRAYLEN(ppmDmaHardware); i++) {
+        if (ppmDmaHardware[i].tim == timerHardwarePtr->tim && ppmDmaHardware[i].channel == timerHardwarePtr->channel) {
+            dma = &ppmDmaHardware[i];
+            break;
+        }
+    }
+    if (!dma || !dmaReserve(dma->stream, OWNER_PPMINPUT)) {
+        return false;
+    }
+    RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_DMA1 | RCC_AHB1Periph_DMA2, ENABLE);
+    DMA_DeInit(dma->stream);
+    DMA_StructInit(&DMA_InitStructure);
+    DMA_InitStructure.DMA_Channel = dma->dmaChannel;
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)timerChCCR(timerHardwarePtr);
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)ppmDmaRing;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
+    DMA_InitStructure.DMA_BufferSize = PPM_DMA_RING_SIZE;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Low;
+    DMA_Init(dma->stream, &DMA_InitStructure);
+    DMA_Cmd(dma->stream, ENABLE);
+    TIM_DMACmd(timerHardwarePtr->tim, TIM_DMA_CC1 << (timerHardwarePtr->channel / 4), ENABLE);
+    ppmDmaTail = 0;
+    ppmDmaStream = dma->stream;
+    return true;
+}
+#endif
 #define MAX_MISSED_PWM_EVENTS 10
 bool isPWMDataBeingReceived(void)
 {
@@ -261,6 +358,21 @@ void ppmInConfig(const timerHardware_t *timerHardwarePtr)
     timerChCCHandlerInit(&self->edgeCb, ppmEdgeCallback);
     timerChOvrHandlerInit(&self->overflowCb, ppmOverflowCallback);
     timerChConfigCallbacks(timerHardwarePtr, &self->edgeCb, &self->overflowCb);
+#ifdef PPM_CAPTURE_DMA
+    if (ppmCountShift == 1) {
+        ppmDmaTimerHardware = timerHardwarePtr;
+    }
+#endif
+}
+void ppmCaptureDmaInit(void)
+{
+#ifdef PPM_CAPTURE_DMA
+    pwmInputPort_t *self = &pwmInputPorts[FIRST_PWM_PORT];
+    if (!ppmDmaTimerHardware || ppmDmaStream || !ppmDmaConfig(ppmDmaTimerHardware)) {
+        return;
+    }
+    timerChConfigCallbacks(ppmDmaTimerHardware, NULL, &self->overflowCb);
+#endif
 }
 uint16_t ppmRead(uint8_t channel)
 {
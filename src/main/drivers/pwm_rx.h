@@ -23,12 +23,17 @@ typedef enum {
     INPUT_FILTERING_ENABLED
 } inputFilteringMode_e;
 #define PPM_RCVR_TIMEOUT 0
+#if defined(STM32F40_41xxx) || defined (STM32F411xE) || defined(STM32F446xx)
+#define PPM_CAPTURE_DMA
+#endif
 void ppmInConfig(const timerHardware_t *timerHardwarePtr);
 void ppmAvoidPWMTimerClash(const timerHardware_t *timerHardwarePtr, TIM_TypeDef *sharedPwmTimer);
 void pwmInConfig(const timerHardware_t *timerHardwarePtr, uint8_t channel);
 uint16_t pwmRead(uint8_t channel);
 uint16_t ppmRead(uint8_t channel);
 bool isPPMDataBeingReceived(void);
+void ppmCaptureProcess(void);
+void ppmCaptureDmaInit(void);
 void resetPPMDataReceivedState(void);
 void pwmRxInit(inputFilteringMode_e initialInputFilteringMode);
 bool isPWMDataBeingReceived(void);
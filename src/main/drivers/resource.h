@@ -38,6 +38,8 @@ typedef enum {
  OWNER_TIMER,
  OWNER_SONAR,
  OWNER_SYSTEM,
+ OWNER_LED_STRIP,
+ OWNER_FLASH,
 } resourceOwner_t;
 typedef enum {
  RESOURCE_INPUT = 1 << 0,
@@ -27,6 +27,15 @@ void serialPrint(serialPort_t *instance, const char *str)
         serialWrite(instance, ch);
     }
 }
+void serialWriteBuf(serialPort_t *instance, const uint8_t *data, int count)
+{
+    void (*writeFn)(serialPort_t *instance, uint8_t ch) = instance->vTable->serialWrite;
+    serialBeginWrite(instance);
+    while (count-- > 0) {
+        writeFn(instance, *data++);
+    }
+    serialEndWrite(instance);
+}
 uint32_t serialGetBaudRate(serialPort_t *instance)
 {
     return instance->baudRate;
@@ -69,6 +69,7 @@ void serialSetBaudRate(serialPort_t *instance, uint32_t baudRate);
 void serialSetMode(serialPort_t *instance, portMode_t mode);
 bool isSerialTransmitBufferEmpty(serialPort_t *instance);
 void serialPrint(serialPort_t *instance, const char *str);
+void serialWriteBuf(serialPort_t *instance, const uint8_t *data, int count);
 uint32_t serialGetBaudRate(serialPort_t *instance);
 void serialBeginWrite(serialPort_t *instance);
 void serialEndWrite(serialPort_t *instance);
@@ -24,6 +24,7 @@
 #include "common/utils.h"
 #include "gpio.h"
 #include "inverter.h"
+#include "dma.h"
 #include "serial.h"
 #include "serial_uart.h"
 #include "serial_uart_impl.h"
@@ -109,6 +110,10 @@ serialPort_t *uartOpen(USART_TypeDef *USARTx, serialPortFunction_e function, ser
         return (serialPort_t *)s;
     }
     s->txDMAEmpty = true;
+#ifdef UART_RX_FRAME_IDLE
+    s->rxFrameCallback = NULL;
+    s->rxFramePos = 0;
+#endif
     s->port.rxBufferHead = s->port.rxBufferTail = 0;
     s->port.txBufferHead = s->port.txBufferTail = 0;
     s->port.callback = callback;
@@ -116,6 +121,21 @@ serialPort_t *uartOpen(USART_TypeDef *USARTx, serialPortFunction_e function, ser
     s->port.baudRate = baudRate;
     s->port.options = options;
     uartReconfigure(s);
+#if defined(STM32F40_41xxx) || defined (STM32F411xE) || defined(STM32F446xx)
+    if (s->rxDMAStream && function == FUNCTION_RX_SERIAL && !dmaReserve(s->rxDMAStream, OWNER_SERIAL_RX)) {
+        s->rxDMAStream = NULL;
+    }
+    if (s->txDMAStream && !dmaReserve(s->txDMAStream, OWNER_SERIAL_TX)) {
+        s->txDMAStream = NULL;
+    }
+#else
+    if (s->rxDMAChannel && !dmaReserve(s->rxDMAChannel, OWNER_SERIAL_RX)) {
+        s->rxDMAChannel = NULL;
+    }
+    if (s->txDMAChannel && !dmaReserve(s->txDMAChannel, OWNER_SERIAL_TX)) {
+        s->txDMAChannel = NULL;
+    }
+#endif
     DMA_InitTypeDef DMA_InitStructure;
     if (mode & MODE_RX) {
 #if defined(STM32F40_41xxx) || defined (STM32F411xE) || defined(STM32F446xx)
@@ -146,15 +166,13 @@ serialPort_t *uartOpen(USART_TypeDef *USARTx, serialPortFunction_e function, ser
 #if defined(STM32F40_41xxx) || defined (STM32F411xE) || defined(STM32F446xx)
             DMA_InitStructure.DMA_Channel = s->rxDMAChannel;
             DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
-            DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+            DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
             DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)s->port.rxBuffer;
             DMA_DeInit(s->rxDMAStream);
             DMA_Init(s->rxDMAStream, &DMA_InitStructure);
             DMA_Cmd(s->rxDMAStream, ENABLE);
             USART_DMACmd(s->USARTx, USART_DMAReq_Rx, ENABLE);
             s->rxDMAPos = DMA_GetCurrDataCounter(s->rxDMAStream);
-         USART_ClearITPendingBit(s->USARTx, USART_IT_IDLE);
-         USART_ITConfig(s->USARTx, USART_IT_IDLE, ENABLE);
 #else
             DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
             DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
@@ -260,6 +278,64 @@ void uartStartTxDMA(uartPort_t *s)
     DMA_Cmd(s->txDMAChannel, ENABLE);
 #endif
 }
+#ifdef UART_RX_FRAME_IDLE
+static uint32_t uartRxDMAHead(uartPort_t *s)
+{
+#if defined(STM32F40_41xxx) || defined (STM32F411xE) || defined(STM32F446xx)
+    return s->port.rxBufferSize - s->rxDMAStream->NDTR;
+#else
+    return s->port.rxBufferSize - s->rxDMAChannel->CNDTR;
+#endif
+}
+#endif
+bool uartSetRxFrameCallback(serialPort_t *instance, serialReceiveFrameCallbackPtr callback)
+{
+#ifdef UART_RX_FRAME_IDLE
+    uartPort_t *s = (uartPort_t *)instance;
+    if (!instance || instance->vTable != uartVTable) {
+        return false;
+    }
+#if defined(STM32F40_41xxx) || defined (STM32F411xE) || defined(STM32F446xx)
+    if (!s->rxDMAStream) {
+#else
+    if (!s->rxDMAChannel) {
+#endif
+        return false;
+    }
+    s->rxFramePos = uartRxDMAHead(s);
+    s->rxFrameCallback = callback;
+    USART_ClearITPendingBit(s->USARTx, USART_IT_IDLE);
+    USART_ITConfig(s->USARTx, USART_IT_IDLE, callback ? ENABLE : DISABLE);
+    return true;
+#else
+    UNUSED(instance);
+    UNUSED(callback);
+    return false;
+#endif
+}
+#ifdef UART_RX_FRAME_IDLE
+void uartRxFrameIdle(uartPort_t *s)
+{
+    const uint32_t size = s->port.rxBufferSize;
+    const uint32_t head = uartRxDMAHead(s);
+    uint32_t length = (head >= s->rxFramePos) ? head - s->rxFramePos : size + head - s->rxFramePos;
+    uint32_t i;
+    if (length > UART_RX_FRAME_SIZE) {
+        s->rxFramePos = (head >= UART_RX_FRAME_SIZE) ? head - UART_RX_FRAME_SIZE : size + head - UART_RX_FRAME_SIZE;
+        length = UART_RX_FRAME_SIZE;
+    }
+    for (i = 0; i < length; i++) {
+        s->rxFrame[i] = s->port.rxBuffer[s->rxFramePos];
+        if (++s->rxFramePos >= size) {
+            s->rxFramePos = 0;
+        }
+    }
+    s->rxDMAPos = size - head;
+    if (length && s->rxFrameCallback) {
+        s->rxFrameCallback(s->rxFrame, length);
+    }
+}
+#endif
 uint32_t uartTotalRxBytesWaiting(serialPort_t *instance)
 {
     uartPort_t *s = (uartPort_t*)instance;
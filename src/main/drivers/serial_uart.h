@@ -46,6 +46,11 @@
 #define UART6_RX_BUFFER_SIZE 256
 #define UART6_TX_BUFFER_SIZE 256
 #endif
+#if defined(STM32F40_41xxx) || defined (STM32F411xE) || defined(STM32F446xx) || defined(STM32F303xC)
+#define UART_RX_FRAME_IDLE
+#endif
+#define UART_RX_FRAME_SIZE 64
+typedef void (*serialReceiveFrameCallbackPtr)(const uint8_t *frame, uint16_t length);
 typedef struct {
     serialPort_t port;
 #if defined(STM32F40_41xxx) || defined (STM32F411xE) || defined(STM32F446xx)
@@ -69,6 +74,11 @@ typedef struct {
  uint32_t rxTEIF;
  uint32_t rxFEIF;
  uint32_t rxDMEIF;
+#ifdef UART_RX_FRAME_IDLE
+    serialReceiveFrameCallbackPtr rxFrameCallback;
+    uint32_t rxFramePos;
+    uint8_t rxFrame[UART_RX_FRAME_SIZE];
+#endif
 } uartPort_t;
 serialPort_t *uartOpen(USART_TypeDef *USARTx, serialPortFunction_e function, serialReceiveCallbackPtr callback, uint32_t baudRate, portMode_t mode, portOptions_t options);
 void uartWrite(serialPort_t *instance, uint8_t ch);
@@ -77,3 +87,4 @@ uint8_t uartTotalTxBytesFree(serialPort_t *instance);
 uint8_t uartRead(serialPort_t *instance);
 void uartSetBaudRate(serialPort_t *s, uint32_t baudRate);
 bool isUartTransmitBufferEmpty(serialPort_t *s);
+bool uartSetRxFrameCallback(serialPort_t *instance, serialReceiveFrameCallbackPtr callback);
@@ -20,6 +20,7 @@
        
 extern const struct serialPortVTable uartVTable[];
 void uartStartTxDMA(uartPort_t *s);
+void uartRxFrameIdle(uartPort_t *s);
 uartPort_t *serialUSART1(uint32_t baudRate, portMode_t mode, portOptions_t options);
 uartPort_t *serialUSART2(uint32_t baudRate, portMode_t mode, portOptions_t options);
 uartPort_t *serialUSART3(uint32_t baudRate, portMode_t mode, portOptions_t options);
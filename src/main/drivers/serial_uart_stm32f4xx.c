@@ -282,37 +282,15 @@ void usartIrqHandler(uartPort_t *s)
  FLAG_TXE = USART_GetFlagStatus(s->USARTx, USART_FLAG_TXE);
  if (USART_GetITStatus(s->USARTx, USART_FLAG_NE | USART_FLAG_FE | USART_FLAG_PE | USART_FLAG_ORE))
  {
-  if (s->rxDMAStream)
+  if (s->rxDMAStream && !(s->rxDMAStream->CR & DMA_SxCR_EN))
   {
-   USART_DMACmd(s->USARTx, USART_DMAReq_Rx, DISABLE);
-   if (DMA_GetFlagStatus(s->rxDMAStream, s->rxTCIF))
-   {
-    DMA_ClearFlag(s->rxDMAStream, s->rxTCIF);
-    DMA_ClearFlag(s->rxDMAStream, s->rxHTIF);
-    if (DMA_GetFlagStatus(s->rxDMAStream, s->rxFEIF) == SET)
-    {
-     DMA_ClearFlag(s->rxDMAStream, s->rxFEIF);
-    }
-    DMA_Cmd(s->rxDMAStream, DISABLE);
-   }
-   if (DMA_GetFlagStatus(s->rxDMAStream, s->rxTEIF) == SET)
-   {
-    DMA_ClearFlag(s->rxDMAStream, s->rxTEIF);
-   }
-   if (DMA_GetFlagStatus(s->rxDMAStream, s->rxDMEIF) == SET)
-   {
-    DMA_ClearFlag(s->rxDMAStream, s->rxDMEIF);
-   }
+   DMA_ClearFlag(s->rxDMAStream, s->rxTCIF | s->rxHTIF | s->rxTEIF | s->rxFEIF | s->rxDMEIF);
+   DMA_Cmd(s->rxDMAStream, ENABLE);
+   s->rxFramePos = 0;
+   s->rxDMAPos = s->port.rxBufferSize;
   }
   USART_ReceiveData(s->USARTx);
   USART_ClearITPendingBit(s->USARTx, USART_FLAG_NE | USART_FLAG_FE | USART_FLAG_PE | USART_FLAG_ORE);
-  if (s->rxDMAStream)
-  {
-   DMA_SetCurrDataCounter(s->rxDMAStream, 16);
-   USART_DMACmd(s->USARTx, USART_DMAReq_Rx, ENABLE);
-   DMA_Cmd(s->rxDMAStream, ENABLE);
-  }
-  USART_ClearITPendingBit(s->USARTx, USART_IT_IDLE);
  }
  else
  {
@@ -335,14 +313,9 @@ void usartIrqHandler(uartPort_t *s)
    }
   }
   if ((USART_GetITStatus(s->USARTx, USART_IT_IDLE) == SET)) {
-   USART_GetITStatus(s->USARTx, USART_IT_IDLE);
    USART_ReceiveData(s->USARTx);
-   if (s->port.callback) {
-    s->port.callback((uint32_t)s->port.rxBuffer);
-   }
-   else {
-    s->port.rxBuffer[s->port.rxBufferHead] = s->USARTx->DR;
-    s->port.rxBufferHead = (s->port.rxBufferHead + 1) % s->port.rxBufferSize;
+   if (s->rxFrameCallback) {
+    uartRxFrameIdle(s);
    }
   }
  }
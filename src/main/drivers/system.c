@@ -40,6 +40,12 @@ static void cycleCounterInit(void)
  RCC_GetClocksFreq(&clocks);
  usTicks = SystemCoreClock / 1000000;
 }
+void enableCycleCounter(void)
+{
+ SYS_DEMCR |= 1 << 24;
+ SYS_DWT_CYCCNT = 0;
+ SYS_DWT_CTRL |= 1;
+}
 void SysTick_Handler(void)
 {
  Millis++;
@@ -23,6 +23,11 @@ void delayMicroseconds(uint32_t us);
 void delay(uint32_t ms);
 uint32_t micros(void);
 uint32_t millis(void);
+#define SYS_DWT_CTRL (*(volatile uint32_t *)0xE0001000)
+#define SYS_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004)
+#define SYS_DEMCR (*(volatile uint32_t *)0xE000EDFC)
+void enableCycleCounter(void);
+static inline uint32_t cycleCount(void) { return SYS_DWT_CYCCNT; }
 void failureMode(uint8_t mode);
 void systemReset(void);
 void systemResetToBootloader(void);
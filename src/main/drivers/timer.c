@@ -1140,3 +1140,21 @@ void timerForceOverflow(TIM_TypeDef *tim)
         tim->EGR |= TIM_EGR_UG;
     }
 }
+uint32_t timerForceOverflowSync(TIM_TypeDef * const *tims, uint8_t count, bool measure)
+{
+    uint8_t i;
+    uint32_t start = 0, end = 0;
+    ATOMIC_BLOCK(NVIC_PRIO_TIMER) {
+        for (i = 0; i < count; i++) {
+            timerConfig[lookupTimerIndex(tims[i])].forcedOverflowTimerValue = tims[i]->CNT + 1;
+        }
+        if (measure)
+            start = cycleCount();
+        for (i = 0; i < count; i++) {
+            tims[i]->EGR = TIM_EGR_UG;
+        }
+        if (measure)
+            end = cycleCount();
+    }
+    return end - start;
+}
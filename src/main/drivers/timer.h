@@ -112,4 +112,5 @@ void timerChInit(const timerHardware_t *timHw, channelType_t type, int irqPriori
 void timerInit(void);
 void timerStart(void);
 void timerForceOverflow(TIM_TypeDef *tim);
+uint32_t timerForceOverflowSync(TIM_TypeDef * const *tims, uint8_t count, bool measure);
 void configTimeBase(TIM_TypeDef *tim, uint16_t period, uint8_t mhz);
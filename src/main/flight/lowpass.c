@@ -52,6 +52,29 @@ void generateLowpassCoeffs2(int16_t freq, lowpass_t *filter)
     }
     filter->freq = freq;
 }
+float lowpassFloat(lowpass_t *filter, float in, int16_t freq)
+{
+    int16_t coefIdx;
+    float out;
+    if (freq != filter->freq) {
+        filter->init = false;
+    }
+    if (!filter->init) {
+        generateLowpassCoeffs2(freq, filter);
+        for (coefIdx = 0; coefIdx < LOWPASS_NUM_COEF; coefIdx++) {
+            filter->xf[coefIdx] = in;
+            filter->yf[coefIdx] = in;
+        }
+        filter->init = true;
+    }
+    out = filter->bf[0] * in + filter->bf[1] * filter->xf[0] + filter->bf[2] * filter->xf[1]
+        - filter->af[1] * filter->yf[0] - filter->af[2] * filter->yf[1];
+    filter->xf[1] = filter->xf[0];
+    filter->xf[0] = in;
+    filter->yf[1] = filter->yf[0];
+    filter->yf[0] = out;
+    return out;
+}
 int32_t lowpassFixed(lowpass_t *filter, int32_t in, int16_t freq)
 {
     int16_t coefIdx;
@@ -20,6 +20,9 @@
        
 #define LOWPASS_NUM_COEF 3
 #define LPF_ROUND(x) (x < 0 ? (x - 0.5f) : (x + 0.5f))
+#if defined(__FPU_PRESENT) && (__FPU_PRESENT == 1)
+#define USE_LOWPASS_FLOAT
+#endif
 typedef struct lowpass_s {
     bool init;
     int16_t freq;
@@ -37,3 +40,4 @@ typedef struct lowpass_s {
 } lowpass_t;
 void generateLowpassCoeffs2(int16_t freq, lowpass_t *filter);
 int32_t lowpassFixed(lowpass_t *filter, int32_t in, int16_t freq);
+float lowpassFloat(lowpass_t *filter, float in, int16_t freq);
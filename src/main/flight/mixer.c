@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include "platform.h"
 #include "build_config.h"
 #include "common/axis.h"
@@ -34,9 +35,11 @@
 #include "io/gimbal.h"
 #include "io/escservo.h"
 #include "io/rc_controls.h"
+#include "io/rc_curves.h"
 #include "sensors/sensors.h"
 #include "sensors/acceleration.h"
 #include "flight/mixer.h"
+#include "flight/mixer_matrix.h"
 #include "flight/failsafe.h"
 #include "flight/pid.h"
 #include "flight/imu.h"
@@ -55,6 +58,10 @@ static airplaneConfig_t *airplaneConfig;
 static rxConfig_t *rxConfig;
 static mixerMode_e currentMixerMode;
 static motorMixer_t currentMixer[MAX_SUPPORTED_MOTORS];
+static uint8_t mixerFixer;
+static bool motorsUseDshot;
+static bool motorsUseOneshot;
+static mixerMatrixRow_t mixerMatrix[MAX_SUPPORTED_MOTORS];
 bool motorLimitReached = false;
 #ifdef USE_SERVOS
 static uint8_t servoRuleCount = 0;
@@ -65,6 +72,9 @@ static int useServo;
 STATIC_UNIT_TESTED uint8_t servoCount;
 static servoParam_t *servoConf;
 static lowpass_t lowpassFilters[MAX_SUPPORTED_SERVOS];
+static volatile uint32_t servoInputSequence;
+static volatile int16_t servoInputPID[XYZ_AXIS_COUNT];
+static volatile int16_t servoInputThrottle;
 #endif
 static const motorMixer_t mixerQuadXL[] = {
     { 1.0f, -1.0f, 1.0f, -1.0f },
@@ -321,6 +331,24 @@ const mixerRules_t servoMixers[] = {
 static servoMixer_t *customServoMixers;
 #endif
 static motorMixer_t *customMixers;
+static uint8_t mixerFixerForMode(mixerMode_e mixerMode)
+{
+    switch (mixerMode) {
+        case MIXER_QUADXL:
+        case MIXER_QUADX1:
+        case MIXER_QUADX2:
+            return 1;
+        case MIXER_QUADX_1234:
+            return 2;
+        default:
+            return 0;
+    }
+}
+static void mixerBuildMatrix(void)
+{
+    mixerMatrixBuild(mixerMatrix, currentMixer, mixerFixer, mixerConfig->foreAftMixerFixerStrength,
+        mixerConfig->yaw_motor_direction, escAndServoConfig->minthrottle, escAndServoConfig->maxthrottle);
+}
 void mixerUseConfigs(
 #ifdef USE_SERVOS
         servoParam_t *servoConfToUse,
@@ -359,6 +387,15 @@ int servoDirection(int servoIndex, int inputSource)
         return 1;
 }
 #endif
+static void mixerLatchMotorProtocol(const pwmOutputConfiguration_t *pwmOutputConfiguration)
+{
+    motorsUseDshot = feature(FEATURE_DSHOT) && !pwmOutputConfiguration->dshotFallback;
+    motorsUseOneshot = feature(FEATURE_MULTISHOT) || feature(FEATURE_ONESHOT125) || pwmOutputConfiguration->dshotFallback;
+}
+bool mixerMotorsUseDshot(void)
+{
+    return motorsUseDshot;
+}
 #ifndef USE_QUAD_MIXER_ONLY
 void loadCustomServoMixer(void)
 {
@@ -375,6 +412,7 @@ void loadCustomServoMixer(void)
 void mixerInit(mixerMode_e mixerMode, motorMixer_t *initialCustomMotorMixers, servoMixer_t *initialCustomServoMixers)
 {
     currentMixerMode = mixerMode;
+    mixerFixer = mixerFixerForMode(mixerMode);
     customMixers = initialCustomMotorMixers;
     customServoMixers = initialCustomServoMixers;
     useServo = mixers[currentMixerMode].useServo;
@@ -387,6 +425,7 @@ void mixerInit(mixerMode_e mixerMode, motorMixer_t *initialCustomMotorMixers, se
 void mixerUsePWMOutputConfiguration(pwmOutputConfiguration_t *pwmOutputConfiguration)
 {
     int i;
+    mixerLatchMotorProtocol(pwmOutputConfiguration);
     motorCount = 0;
     servoCount = pwmOutputConfiguration->servoCount;
     if (currentMixerMode == MIXER_CUSTOM || currentMixerMode == MIXER_CUSTOM_TRI || currentMixerMode == MIXER_CUSTOM_AIRPLANE) {
@@ -433,6 +472,7 @@ void mixerUsePWMOutputConfiguration(pwmOutputConfiguration_t *pwmOutputConfigura
             loadCustomServoMixer();
         }
     }
+    mixerBuildMatrix();
     mixerResetDisarmedMotors();
 }
 void servoMixerLoadMix(int index, servoMixer_t *customServoMixers)
@@ -459,11 +499,12 @@ void mixerLoadMix(int index, motorMixer_t *customMixers)
 void mixerInit(mixerMode_e mixerMode, motorMixer_t *initialCustomMixers)
 {
     currentMixerMode = mixerMode;
+    mixerFixer = mixerFixerForMode(mixerMode);
     customMixers = initialCustomMixers;
 }
 void mixerUsePWMOutputConfiguration(pwmOutputConfiguration_t *pwmOutputConfiguration)
 {
-    UNUSED(pwmOutputConfiguration);
+    mixerLatchMotorProtocol(pwmOutputConfiguration);
     motorCount = 4;
 #ifdef USE_SERVOS
     servoCount = 0;
@@ -472,6 +513,7 @@ void mixerUsePWMOutputConfiguration(pwmOutputConfiguration_t *pwmOutputConfigura
     for (i = 0; i < motorCount; i++) {
         currentMixer[i] = mixerQuadXL[i];
     }
+    mixerBuildMatrix();
     mixerResetDisarmedMotors();
 }
 #endif
@@ -548,10 +590,10 @@ void writeServos(void)
 #endif
 void writeMotors(void)
 {
-    uint8_t i;
-    for (i = 0; i < motorCount; i++)
-        pwmWriteMotor(i, motor[i]);
-    if (feature(FEATURE_MULTISHOT) || (feature(FEATURE_ONESHOT125))) {
+    pwmWriteMotors(motor, motorCount);
+    if (motorsUseDshot) {
+        pwmCompleteDshotMotorUpdate(motorCount);
+    } else if (motorsUseOneshot) {
      if (!feature(FEATURE_USE_PWM_RATE)) {
       pwmCompleteOneshotMotorUpdate(motorCount);
      }
@@ -582,22 +624,32 @@ STATIC_UNIT_TESTED void servoMixer(void)
 {
     int16_t input[INPUT_SOURCE_COUNT];
     static int16_t currentOutput[MAX_SERVO_RULES];
+    int16_t pid[XYZ_AXIS_COUNT];
+    int16_t throttle;
+    uint32_t sequence;
     uint8_t i;
+    do {
+        sequence = servoInputSequence;
+        pid[ROLL] = servoInputPID[ROLL];
+        pid[PITCH] = servoInputPID[PITCH];
+        pid[YAW] = servoInputPID[YAW];
+        throttle = servoInputThrottle;
+    } while ((sequence & 1) || sequence != servoInputSequence);
     if (FLIGHT_MODE(PASSTHRU_MODE)) {
         input[INPUT_STABILIZED_ROLL] = rcCommandUsed[ROLL];
         input[INPUT_STABILIZED_PITCH] = rcCommandUsed[PITCH];
         input[INPUT_STABILIZED_YAW] = rcCommandUsed[YAW];
     } else {
-        input[INPUT_STABILIZED_ROLL] = axisPID[ROLL];
-        input[INPUT_STABILIZED_PITCH] = axisPID[PITCH];
-        input[INPUT_STABILIZED_YAW] = axisPID[YAW];
+        input[INPUT_STABILIZED_ROLL] = pid[ROLL];
+        input[INPUT_STABILIZED_PITCH] = pid[PITCH];
+        input[INPUT_STABILIZED_YAW] = pid[YAW];
         if (feature(FEATURE_3D) && (rcData[THROTTLE] < rxConfig->midrc)) {
             input[INPUT_STABILIZED_YAW] *= -1;
         }
     }
     input[INPUT_GIMBAL_PITCH] = scaleRange(attitude.values.pitch, -1800, 1800, -500, +500);
     input[INPUT_GIMBAL_ROLL] = scaleRange(attitude.values.roll, -1800, 1800, -500, +500);
-    input[INPUT_STABILIZED_THROTTLE] = motor[0] - 1000 - 500;
+    input[INPUT_STABILIZED_THROTTLE] = throttle - 1000 - 500;
     input[INPUT_RC_ROLL] = rcData[ROLL] - rxConfig->midrc;
     input[INPUT_RC_PITCH] = rcData[PITCH] - rxConfig->midrc;
     input[INPUT_RC_YAW] = rcData[YAW] - rxConfig->midrc;
@@ -634,51 +686,26 @@ STATIC_UNIT_TESTED void servoMixer(void)
     }
 }
 #endif
-void mixTable(void)
+static inline void __attribute__((always_inline)) mixTableCore(const uint8_t mixerMotorCount)
 {
- static int32_t throttleToKiAverage[11] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
  uint32_t i;
- static int16_t mixReduction;
  bool isFailsafeActive = failsafeIsActive();
- int16_t rollPitchYawMix[MAX_SUPPORTED_MOTORS];
- int16_t currentStabilizerThrottle[MAX_SUPPORTED_MOTORS];
- int16_t rollPitchYawMixMax = 0;
- int16_t rollPitchYawMixMin = 0;
- float OldRange, OldValue, NewRange, OldMax, OldMin, NewMax, NewMin;
- uint8_t mixerFixer = 0;
- switch (masterConfig.mixerMode) {
-  case MIXER_QUADXL:
-  case MIXER_QUADX1:
-  case MIXER_QUADX2:
-   mixerFixer = 1;
-   break;
-  case MIXER_QUADX_1234:
-   mixerFixer = 2;
-   break;
- }
- for (i = 0; i < motorCount; i++) {
-  currentStabilizerThrottle[i] = applyTPA( (float)((motor[i] - 1000) / 2000) );
-   uint8_t throttleTen = (uint8_t)(Throttle_p*10.0f);
-   throttleToKiAverage[throttleTen] = (int32_t)((throttleToKiAverage[throttleTen]+axisPID_I[PITCH]) / 2);
-  rollPitchYawMix[i] =
-      ( ( (currentStabilizerThrottle[i] * (axisPID_P[PITCH] + axisPID_D[PITCH]) / 100 ) + axisPID_I[PITCH]) ) * currentMixer[i].pitch +
-   ( ( (currentStabilizerThrottle[i] * (axisPID_P[ROLL] + axisPID_D[ROLL]) / 100 ) + axisPID_I[ROLL]) ) * currentMixer[i].roll +
-      -mixerConfig->yaw_motor_direction * (axisPID_P[YAW] + axisPID_D[YAW] + axisPID_I[YAW] ) * currentMixer[i].yaw;
-  if (rollPitchYawMix[i] > rollPitchYawMixMax) rollPitchYawMixMax = rollPitchYawMix[i];
-  if (rollPitchYawMix[i] < rollPitchYawMixMin) rollPitchYawMixMin = rollPitchYawMix[i];
- }
- int16_t rollPitchYawMixRange = rollPitchYawMixMax - rollPitchYawMixMin;
- int16_t throttleRange, throttle;
- int16_t throttleMin, throttleMax;
+ const bool use3D = feature(FEATURE_3D);
+ const bool useMotorStop = feature(FEATURE_MOTOR_STOP);
+ const float tpaScale = lookupTpaRC[(uint8_t)(Throttle_p * (TPA_LOOKUP_LENGTH - 1) + 0.5f)] * 0.01f;
+ const float rollInput = tpaScale * (axisPID_P[ROLL] + axisPID_D[ROLL]) + axisPID_I[ROLL];
+ const float pitchInput = tpaScale * (axisPID_P[PITCH] + axisPID_D[PITCH]) + axisPID_I[PITCH];
+ const float yawInput = axisPID_P[YAW] + axisPID_D[YAW] + axisPID_I[YAW];
+ int16_t throttle;
+ float throttleMin, throttleMax;
  static int16_t throttlePrevious = 0;
- if (feature(FEATURE_3D)) {
+ if (use3D) {
   if (!ARMING_FLAG(ARMED)) throttlePrevious = rxConfig->midrc;
   if ((rcCommandUsed[THROTTLE] <= (rxConfig->midrc - flight3DConfig->deadband3d_throttle))) {
    throttleMax = flight3DConfig->deadband3d_low;
    throttleMin = escAndServoConfig->minthrottle;
    throttlePrevious = throttle = rcCommandUsed[THROTTLE];
   } else if (rcCommandUsed[THROTTLE] >= (rxConfig->midrc + flight3DConfig->deadband3d_throttle)) {
-   escAndServoConfig->maxthrottle = 2000;
    throttleMax = escAndServoConfig->maxthrottle;
    throttleMin = flight3DConfig->deadband3d_high;
    throttlePrevious = throttle = rcCommandUsed[THROTTLE];
@@ -686,81 +713,82 @@ void mixTable(void)
    throttle = throttleMax = flight3DConfig->deadband3d_low;
    throttleMin = escAndServoConfig->minthrottle;
   } else {
-   escAndServoConfig->maxthrottle = 2000;
    throttleMax = escAndServoConfig->maxthrottle;
    throttle = throttleMin = flight3DConfig->deadband3d_high;
   }
  } else {
   throttle = rcCommandUsed[THROTTLE];
   throttleMin = escAndServoConfig->minthrottle;
-  escAndServoConfig->maxthrottle = 2000;
   throttleMax = escAndServoConfig->maxthrottle;
  }
- throttleRange = throttleMax - throttleMin;
- if (rollPitchYawMixRange > throttleRange) {
-  motorLimitReached = true;
-  mixReduction = (throttleRange << 12) / rollPitchYawMixRange;
-  for (i = 0; i < motorCount; i++) {
-   rollPitchYawMix[i] = ((mixReduction * rollPitchYawMix[i]) >> 12);
-  }
-  throttleMin = throttleMax = throttleMin + (throttleRange / 2);
- } else {
-  motorLimitReached = false;
-  throttleMin = throttleMin + (rollPitchYawMixRange / 2);
-  throttleMax = throttleMax - (rollPitchYawMixRange / 2);
- }
- for (i = 0; i < motorCount; i++) {
-  uint16_t currentMixerThrottle = throttle;
-  if (mixerFixer == 1) {
-   if ( (i == 1) || (i == 3) ) {
-    OldMax = escAndServoConfig->maxthrottle;
-    OldMin = escAndServoConfig->minthrottle;
-    NewMax = (uint16_t)((float)escAndServoConfig->maxthrottle * mixerConfig->foreAftMixerFixerStrength);
-    NewMin = escAndServoConfig->minthrottle;
-    OldValue = throttle;
-    OldRange = (OldMax - OldMin);
-    NewRange = (NewMax - NewMin);
-    currentMixerThrottle = (((OldValue - OldMin) * NewRange) / OldRange) + NewMin;
-   }
-  } else if (mixerFixer == 2) {
-   if ( (i == 0) || (i == 1) ) {
-    OldMax = escAndServoConfig->maxthrottle;
-    OldMin = escAndServoConfig->minthrottle;
-    NewMax = (uint16_t)((float)escAndServoConfig->maxthrottle * mixerConfig->foreAftMixerFixerStrength);
-    NewMin = escAndServoConfig->minthrottle;
-    OldValue = throttle;
-    OldRange = (OldMax - OldMin);
-    NewRange = (NewMax - NewMin);
-    currentMixerThrottle = (((OldValue - OldMin) * NewRange) / OldRange) + NewMin;
-   }
-  }
-  motor[i] = rollPitchYawMix[i] + constrain(currentMixerThrottle * currentMixer[i].throttle, throttleMin, throttleMax);
+ motorLimitReached = mixerMatrixApply(motor, mixerMatrix, mixerMotorCount, rollInput, pitchInput, yawInput, throttle, throttleMin, throttleMax);
+ for (i = 0; i < mixerMotorCount; i++) {
   if (isFailsafeActive) {
-   escAndServoConfig->maxthrottle = 2000;
    motor[i] = constrain(motor[i], escAndServoConfig->mincommand, escAndServoConfig->maxthrottle);
-  } else if (feature(FEATURE_3D)) {
+  } else if (use3D) {
    if (throttlePrevious <= (rxConfig->midrc - flight3DConfig->deadband3d_throttle)) {
     motor[i] = constrain(motor[i], escAndServoConfig->minthrottle, flight3DConfig->deadband3d_low);
    } else {
-    escAndServoConfig->maxthrottle = 2000;
     motor[i] = constrain(motor[i], flight3DConfig->deadband3d_high, escAndServoConfig->maxthrottle);
    }
   } else {
-   escAndServoConfig->maxthrottle = 2000;
    motor[i] = constrain(motor[i], escAndServoConfig->minthrottle, escAndServoConfig->maxthrottle);
+   if (thrustCurveActive) {
+    motor[i] = thrustCurveLookup(motor[i]);
+   }
   }
-  if (feature(FEATURE_MOTOR_STOP) && ARMING_FLAG(ARMED) && !feature(FEATURE_3D)) {
+  if (useMotorStop && ARMING_FLAG(ARMED) && !use3D) {
    if (((rcData[THROTTLE]) < rxConfig->mincheck)) {
     motor[i] = escAndServoConfig->realmincommand;
    }
   }
  }
  if (!ARMING_FLAG(ARMED)) {
-  for (i = 0; i < motorCount; i++) {
+  for (i = 0; i < mixerMotorCount; i++) {
    motor[i] = motor_disarmed[i];
   }
  }
-#if !defined(USE_QUAD_MIXER_ONLY) || defined(USE_SERVOS)
+#ifdef USE_SERVOS
+    servoInputSequence++;
+    servoInputPID[ROLL] = axisPID[ROLL];
+    servoInputPID[PITCH] = axisPID[PITCH];
+    servoInputPID[YAW] = axisPID[YAW];
+    servoInputThrottle = motor[0];
+    servoInputSequence++;
+#endif
+}
+#define MIX_TABLE_VARIANT(name, mixerMotorCount) \
+static void name(void) \
+{ \
+    mixTableCore(mixerMotorCount); \
+}
+MIX_TABLE_VARIANT(mixTableGeneric, motorCount)
+MIX_TABLE_VARIANT(mixTable4, 4)
+MIX_TABLE_VARIANT(mixTable6, 6)
+MIX_TABLE_VARIANT(mixTable8, 8)
+mixTableFuncPtr mix_table = mixTableGeneric;
+void mixerSelectMotorCountVariant(void)
+{
+    mixerBuildMatrix();
+    switch (motorCount) {
+        case 4:
+            mix_table = mixTable4;
+            break;
+        case 6:
+            mix_table = mixTable6;
+            break;
+        case 8:
+            mix_table = mixTable8;
+            break;
+        default:
+            mix_table = mixTableGeneric;
+            break;
+    }
+}
+#ifdef USE_SERVOS
+void mixServos(void)
+{
+    uint8_t i;
     switch (currentMixerMode) {
         case MIXER_CUSTOM_AIRPLANE:
         case MIXER_FLYING_WING:
@@ -792,24 +820,38 @@ void mixTable(void)
     for (i = 0; i < MAX_SUPPORTED_SERVOS; i++) {
         servo[i] = constrain(servo[i], servoConf[i].min, servoConf[i].max);
     }
-#endif
 }
-#ifdef USE_SERVOS
 bool isMixerUsingServos(void)
 {
     return useServo;
 }
 #endif
+#ifdef USE_SERVOS
+#define SERVO_LOWPASS_MAX_FREQ 900
+static int16_t servoLowpassFreq(void)
+{
+    uint32_t freq;
+    if (!targetESCwritetime || !masterConfig.servo_pwm_rate)
+        return mixerConfig->servo_lowpass_freq;
+    freq = (uint32_t)mixerConfig->servo_lowpass_freq * (1000000 / targetESCwritetime) / masterConfig.servo_pwm_rate;
+    return MIN(freq, INT16_MAX);
+}
+#endif
 void filterServos(void)
 {
 #ifdef USE_SERVOS
     int16_t servoIdx;
+    int16_t freq = servoLowpassFreq();
 #if defined(MIXER_DEBUG)
     uint32_t startTime = micros();
 #endif
-    if (mixerConfig->servo_lowpass_enable) {
+    if (mixerConfig->servo_lowpass_enable && freq <= SERVO_LOWPASS_MAX_FREQ) {
         for (servoIdx = 0; servoIdx < MAX_SUPPORTED_SERVOS; servoIdx++) {
-            servo[servoIdx] = (int16_t)lowpassFixed(&lowpassFilters[servoIdx], servo[servoIdx], mixerConfig->servo_lowpass_freq);
+#ifdef USE_LOWPASS_FLOAT
+            servo[servoIdx] = (int16_t)lrintf(lowpassFloat(&lowpassFilters[servoIdx], servo[servoIdx], freq));
+#else
+            servo[servoIdx] = (int16_t)lowpassFixed(&lowpassFilters[servoIdx], servo[servoIdx], freq);
+#endif
             servo[servoIdx] = constrain(servo[servoIdx], servoConf[servoIdx].min, servoConf[servoIdx].max);
         }
     }
@@ -160,8 +160,11 @@ typedef struct servoParam_s {
 struct gimbalConfig_s;
 struct escAndServoConfig_s;
 struct rxConfig_s;
+#define SERVO_PULSE_MIN 500
+#define SERVO_PULSE_MAX 2250
 extern int16_t servo[MAX_SUPPORTED_SERVOS];
 bool isMixerUsingServos(void);
+void mixServos(void);
 void writeServos(void);
 void filterServos(void);
 #endif
@@ -187,7 +190,10 @@ void loadCustomServoMixer(void);
 int servoDirection(int servoIndex, int fromChannel);
 #endif
 void mixerResetDisarmedMotors(void);
-void mixTable(void);
+bool mixerMotorsUseDshot(void);
+typedef void (*mixTableFuncPtr)(void);
+extern mixTableFuncPtr mix_table;
+void mixerSelectMotorCountVariant(void);
 void writeMotors(void);
 void stopMotors(void);
 void stopMotorsNoDelay(void);
@@ -0,0 +1,39 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#include <stdbool.h>
+#include <stdint.h>
+#include "common/maths.h"
+#include "flight/mixer.h"
+#include "flight/mixer_matrix.h"
+void mixerMatrixBuild(mixerMatrixRow_t *matrix, const motorMixer_t *mixer, uint8_t mixerFixer, float fixerStrength, int8_t yawMotorDirection, float minThrottle, float maxThrottle)
+{
+    uint8_t i;
+    const float fixerScale = ((float)(uint16_t)(maxThrottle * fixerStrength) - minThrottle) / (maxThrottle - minThrottle);
+    for (i = 0; i < MAX_SUPPORTED_MOTORS; i++) {
+        float throttleScale = 1.0f;
+        if ((mixerFixer == 1 && (i == 1 || i == 3)) || (mixerFixer == 2 && (i == 0 || i == 1))) {
+            throttleScale = fixerScale;
+        }
+        matrix[i].throttle = mixer[i].throttle * throttleScale;
+        matrix[i].throttleOffset = mixer[i].throttle * minThrottle * (1.0f - throttleScale);
+        matrix[i].roll = mixer[i].roll;
+        matrix[i].pitch = mixer[i].pitch;
+        matrix[i].yaw = -yawMotorDirection * mixer[i].yaw;
+    }
+}
@@ -0,0 +1,60 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#pragma once 
+       
+typedef struct mixerMatrixRow_s {
+    float throttle;
+    float throttleOffset;
+    float roll;
+    float pitch;
+    float yaw;
+} mixerMatrixRow_t;
+void mixerMatrixBuild(mixerMatrixRow_t *matrix, const motorMixer_t *mixer, uint8_t mixerFixer, float fixerStrength, int8_t yawMotorDirection, float minThrottle, float maxThrottle);
+static inline bool mixerMatrixApply(int16_t *motors, const mixerMatrixRow_t *matrix, const uint8_t motorCount,
+    float rollInput, float pitchInput, float yawInput, float throttle, float throttleMin, float throttleMax)
+{
+    uint8_t i;
+    float rollPitchYawMix[MAX_SUPPORTED_MOTORS];
+    float rollPitchYawMixMax = 0;
+    float rollPitchYawMixMin = 0;
+    float rollPitchYawMixRange, throttleRange;
+    float mixReduction = 1.0f;
+    bool motorLimitReached = false;
+    for (i = 0; i < motorCount; i++) {
+        const float mix = rollInput * matrix[i].roll + pitchInput * matrix[i].pitch + yawInput * matrix[i].yaw;
+        rollPitchYawMix[i] = mix;
+        if (mix > rollPitchYawMixMax) rollPitchYawMixMax = mix;
+        if (mix < rollPitchYawMixMin) rollPitchYawMixMin = mix;
+    }
+    rollPitchYawMixRange = rollPitchYawMixMax - rollPitchYawMixMin;
+    throttleRange = throttleMax - throttleMin;
+    if (rollPitchYawMixRange > throttleRange) {
+        motorLimitReached = true;
+        mixReduction = throttleRange / rollPitchYawMixRange;
+        throttleMin = throttleMax = throttleMin + (throttleRange / 2);
+    } else {
+        throttleMin = throttleMin + (rollPitchYawMixRange / 2);
+        throttleMax = throttleMax - (rollPitchYawMixRange / 2);
+    }
+    for (i = 0; i < motorCount; i++) {
+        const float mixerThrottle = constrainf(throttle * matrix[i].throttle + matrix[i].throttleOffset, throttleMin, throttleMax);
+        motors[i] = (int16_t)(rollPitchYawMix[i] * mixReduction + mixerThrottle + 0.5f);
+    }
+    return motorLimitReached;
+}
@@ -33,6 +33,8 @@
 #include "sensors/acceleration.h"
 #include "rx/rx.h"
 #include "io/rc_controls.h"
+#include "io/escservo.h"
+#include "io/rc_curves.h"
 #include "io/gps.h"
 #include "flight/pid.h"
 #include "flight/imu.h"
@@ -45,8 +47,6 @@ extern bool FullKiLatched;
 extern bool motorLimitReached;
 extern bool allowITermShrinkOnly;
 int16_t axisPID[3];
-float factor;
-float wow_factor;
 #define KD_RING_BUFFER_SIZE 512
 float kd_ring_buffer_p[KD_RING_BUFFER_SIZE];
 float kd_ring_buffer_p_sum = 0;
@@ -58,7 +58,7 @@ float kd_ring_buffer_y[KD_RING_BUFFER_SIZE];
 float kd_ring_buffer_y_sum = 0;
 uint32_t kd_ring_buffer_y_pointer = 0;
 #ifdef BLACKBOX
-int32_t axisPID_P[3], axisPID_I[3], axisPID_D[3];
+int32_t axisPID_P[3], axisPID_I[3], axisPID_D[3], axisPID_F[3];
 #endif
 static int32_t errorGyroI[3] = { 0, 0, 0 };
 static float errorGyroIf[3] = { 0.0f, 0.0f, 0.0f };
@@ -80,16 +80,18 @@ void pidResetErrorGyro(void)
 const angle_index_t rcAliasToAngleIndexMap[] = { AI_ROLL, AI_PITCH };
 static biquad_t deltaBiQuadState[3];
 static filterStatePt1_t yawPTermState;
+static filterStatePt1_t feedForwardState[3];
 static bool deltaStateIsSet;
 static uint16_t currentLPF;
 static bool onlyUseErrorMethodForKd, onlyUseMeasureMethodForKd;
-static void pidLuxFloat(pidProfile_t *pidProfile, controlRateConfig_t *controlRateConfig,
-        uint16_t max_angle_inclination, rollAndPitchTrims_t *angleTrim, rxConfig_t *rxConfig)
+static inline void __attribute__((always_inline)) pidLuxFloatCore(pidProfile_t *pidProfile, controlRateConfig_t *controlRateConfig,
+        uint16_t max_angle_inclination, rollAndPitchTrims_t *angleTrim, rxConfig_t *rxConfig, const uint32_t escWriteTime)
 {
  float RateError, AngleRate, gyroRate;
- float ITerm, PTerm, DTerm;
- float pidMultiplier=1;
+ float ITerm, PTerm, DTerm, FTerm;
+ const float pidMultiplier = (escWriteTime >= 250) ? 0.5f : 1.0f;
  static float lastRate[3] = { 0, 0, 0 }, lastError[3] = { 0, 0, 0 }, InputUsed[3] = { 0, 0, 0 }, LastInput[3] = { 0, 0, 0 };
+ static float lastSetpoint[3] = { 0, 0, 0 };
  float delta;
  static float lastRcCommand[3] = { 0, 0, 0 };
  int axis;
@@ -98,17 +100,10 @@ static void pidLuxFloat(pidProfile_t *pidProfile, controlRateConfig_t *controlRa
     static uint32_t countErrorUhoh[3] = {0, 0, 0};
     static bool uhOhRecover = false;
     static uint32_t uhOhRecoverCounter = 0;
- static uint16_t uhohNumber = 4000;
+ const uint16_t uhohNumber = (escWriteTime < 125) ? 8000 : 4000;
  static uint8_t yawCounter = 0;
- static uint8_t witchcraftMultiplier = 1;
+ const uint8_t witchcraftMultiplier = (escWriteTime < 125) ? 3 : 1;
  static uint8_t usedWitchcraft = 0;
- if (targetESCwritetime < 125) {
-  uhohNumber = 8000;
-  witchcraftMultiplier = 3;
- }
- if (targetESCwritetime >= 250) {
-  pidMultiplier = .5;
- }
  usedWitchcraft = (pidProfile->witchcraft * witchcraftMultiplier);
     if (IS_RC_MODE_ACTIVE(BOXBRAINDRAIN)) {
      onlyUseErrorMethodForKd = true;
@@ -146,34 +141,11 @@ static void pidLuxFloat(pidProfile_t *pidProfile, controlRateConfig_t *controlRa
         }
     }
     for (axis = 0; axis < 3; axis++) {
-        float rate = controlRateConfig->rates[axis];
-  if (axis == FD_YAW) {
-   if (controlRateConfig->YawAcroPlusFactor) {
-    wow_factor = fabsf(rcCommandUsed[axis] / 500.0f) * (controlRateConfig->YawAcroPlusFactor / 100.0f);
-    factor = wow_factor * rcCommandUsed[axis] + rcCommandUsed[axis];
-   } else {
-    factor = rcCommandUsed[axis];
-   }
-   AngleRate = (float)((rate) * factor) / 500.0f;
-   AngleRate = constrainf(AngleRate, -1500, 1500);
-         } else {
-          if (axis == FD_PITCH) {
-              if (controlRateConfig->PitchAcroPlusFactor) {
-               wow_factor = fabsf(rcCommandUsed[axis] / 500.0f) * ((float)controlRateConfig->PitchAcroPlusFactor / 100.0f);
-               factor = (int16_t)(wow_factor * (float)rcCommandUsed[axis]) + rcCommandUsed[axis];
-              } else {
-               factor = rcCommandUsed[axis];
-              }
-          } else {
-              if (controlRateConfig->RollAcroPlusFactor) {
-               wow_factor = fabsf(rcCommandUsed[axis] / 500.0f) * ((float)controlRateConfig->RollAcroPlusFactor / 100.0f);
-               factor = (int16_t)(wow_factor * (float)rcCommandUsed[axis]) + rcCommandUsed[axis];
-              } else {
-               factor = rcCommandUsed[axis];
-              }
-          }
-       AngleRate = (float)((rate) * factor) / 500.0f;
-       AngleRate = constrainf(AngleRate, -1500, 1500);
+        AngleRate = rcCurveLookup(lookupRateRC[axis], ABS(rcCommandUsed[axis]));
+        if (rcCommandUsed[axis] < 0) {
+            AngleRate = -AngleRate;
+        }
+        if (axis != FD_YAW) {
              if (FLIGHT_MODE(ANGLE_MODE) || FLIGHT_MODE(HORIZON_MODE)) {
 #ifdef GPS
                 const float errorAngle = (constrain(rcCommandUsed[axis] + GPS_angle[axis], -((int) max_angle_inclination),
@@ -305,20 +277,30 @@ static void pidLuxFloat(pidProfile_t *pidProfile, controlRateConfig_t *controlRa
       }
      }
      float D_f = pidProfile->D_f[axis] * pidMultiplier;
-     if (targetESCwritetime == 31) {
+     if (escWriteTime == 31) {
       D_f *= 0.33f;
      }
      DTerm = constrainf(delta * (D_f / 10), -350.0f, 350.0f);
+     FTerm = 0;
+     if (pidProfile->F_f[axis] && !FLIGHT_MODE(ANGLE_MODE)) {
+      float setpointDelta = (AngleRate - lastSetpoint[axis]) * (1.0f / dT);
+      if (pidProfile->ff_lpf_hz[axis]) {
+       setpointDelta = filterApplyPt1(setpointDelta, &feedForwardState[axis], pidProfile->ff_lpf_hz[axis], dT);
+      }
+      FTerm = constrainf(setpointDelta * (pidProfile->F_f[axis] * pidMultiplier / 10), -350.0f, 350.0f);
+     }
+     lastSetpoint[axis] = AngleRate;
      if (!FullKiLatched) {
-   axisPID[axis] = constrain(lrintf(PTerm + ITerm + DTerm), -200, 200);
+   axisPID[axis] = constrain(lrintf(PTerm + ITerm + DTerm + FTerm), -200, 200);
      } else {
-      axisPID[axis] = constrain(lrintf(PTerm + ITerm + DTerm), -1000, 1000);
+      axisPID[axis] = constrain(lrintf(PTerm + ITerm + DTerm + FTerm), -1000, 1000);
      }
      if (uhOhRecoverCounter > 0) {
       axisPID[axis] = 0;
       PTerm = 0;
       ITerm = 0;
       DTerm = 0;
+      FTerm = 0;
      }
 #ifdef GTUNE
         if (FLIGHT_MODE(GTUNE_MODE) && ARMING_FLAG(ARMED)) {
@@ -328,8 +310,20 @@ static void pidLuxFloat(pidProfile_t *pidProfile, controlRateConfig_t *controlRa
         axisPID_P[axis] = PTerm;
         axisPID_I[axis] = ITerm;
         axisPID_D[axis] = DTerm;
+        axisPID_F[axis] = FTerm;
     }
 }
+#define PID_LUX_FLOAT_VARIANT(name, escWriteTime) \
+static void name(pidProfile_t *pidProfile, controlRateConfig_t *controlRateConfig, \
+        uint16_t max_angle_inclination, rollAndPitchTrims_t *angleTrim, rxConfig_t *rxConfig) \
+{ \
+    pidLuxFloatCore(pidProfile, controlRateConfig, max_angle_inclination, angleTrim, rxConfig, escWriteTime); \
+}
+PID_LUX_FLOAT_VARIANT(pidLuxFloat, targetESCwritetime)
+PID_LUX_FLOAT_VARIANT(pidLuxFloat32k, 31)
+PID_LUX_FLOAT_VARIANT(pidLuxFloatFast, 62)
+PID_LUX_FLOAT_VARIANT(pidLuxFloat8k, 125)
+PID_LUX_FLOAT_VARIANT(pidLuxFloatSlow, 250)
 static void pidRewrite(pidProfile_t *pidProfile, controlRateConfig_t *controlRateConfig, uint16_t max_angle_inclination,
         rollAndPitchTrims_t *angleTrim, rxConfig_t *rxConfig)
 {
@@ -344,6 +338,7 @@ static void pidRewrite(pidProfile_t *pidProfile, controlRateConfig_t *controlRat
         axisPID_P[axis] = 0;
         axisPID_I[axis] = 0;
         axisPID_D[axis] = 0;
+        axisPID_F[axis] = 0;
     }
 }
 void pidSetController(pidControllerType_e type)
@@ -356,3 +351,18 @@ void pidSetController(pidControllerType_e type)
             break;
     }
 }
+void pidSelectLoopRateVariant(void)
+{
+    if (pid_controller == pidRewrite) {
+        return;
+    }
+    if (targetESCwritetime == 31) {
+        pid_controller = pidLuxFloat32k;
+    } else if (targetESCwritetime < 125) {
+        pid_controller = pidLuxFloatFast;
+    } else if (targetESCwritetime < 250) {
+        pid_controller = pidLuxFloat8k;
+    } else {
+        pid_controller = pidLuxFloatSlow;
+    }
+}
@@ -67,6 +67,8 @@ typedef struct pidProfile_s {
  uint16_t yaw_pterm_cut_hz;
  uint8_t pitch_pterm_cut_hz;
  uint16_t witchcraft;
+    float F_f[3];
+    uint8_t ff_lpf_hz[3];
 #ifdef GTUNE
     uint8_t gtune_lolimP[3];
     uint8_t gtune_hilimP[3];
@@ -76,7 +78,7 @@ typedef struct pidProfile_s {
 #endif
 } pidProfile_t;
 extern int16_t axisPID[XYZ_AXIS_COUNT];
-extern int32_t axisPID_P[3], axisPID_I[3], axisPID_D[3];
+extern int32_t axisPID_P[3], axisPID_I[3], axisPID_D[3], axisPID_F[3];
 extern float factor0;
 extern float factor1;
 extern float wow_factor0;
@@ -84,3 +86,4 @@ extern float wow_factor1;
 extern float Throttle_p;
 void pidSetController(pidControllerType_e type);
 void pidResetErrorGyro(void);
+void pidSelectLoopRateVariant(void);
@@ -64,6 +64,7 @@
 #include "telemetry/telemetry.h"
 #include "blackbox/blackbox.h"
 #include "flight/mixer.h"
+#include "sensors/esc_telemetry.h"
 #include "flight/pid.h"
 #include "flight/imu.h"
 #include "flight/altitudehold.h"
@@ -18,10 +18,12 @@
  */ 
 #pragma once 
        
+#define THRUST_CURVE_POINTS 11
 typedef struct escAndServoConfig_s {
     uint16_t minthrottle;
     uint16_t maxthrottle;
     uint16_t mincommand;
     uint16_t realmincommand;
     uint16_t servoCenterPulse;
+    uint8_t thrustCurve[THRUST_CURVE_POINTS];
 } escAndServoConfig_t;
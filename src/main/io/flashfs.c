@@ -26,9 +26,15 @@
 static uint8_t flashWriteBuffer[FLASHFS_WRITE_BUFFER_SIZE];
 static uint8_t bufferHead = 0, bufferTail = 0;
 static uint32_t tailAddress = 0;
+#ifdef M25P16_DMA
+static uint32_t pendingBytes = 0;
+#endif
 static void flashfsClearBuffer()
 {
     bufferTail = bufferHead = 0;
+#ifdef M25P16_DMA
+    pendingBytes = 0;
+#endif
 }
 static bool flashfsBufferIsEmpty()
 {
@@ -95,6 +101,11 @@ static uint32_t flashfsWriteBuffers(uint8_t const **buffers, uint32_t *bufferSiz
     if (!sync && !m25p16_isReady()) {
         return 0;
     }
+#ifdef M25P16_DMA
+    if (pendingBytes > 0) {
+        return 0;
+    }
+#endif
     uint32_t bytesTotalRemaining = bytesTotal;
     while (bytesTotalRemaining > 0) {
         uint32_t bytesTotalThisIteration;
@@ -163,21 +174,64 @@ static void flashfsAdvanceTailInBuffer(uint32_t delta)
         flashfsClearBuffer();
     }
 }
+#ifdef M25P16_DMA
+static bool flashfsCompletePendingWrite(bool sync)
+{
+    uint32_t bytesWritten = pendingBytes;
+    if (bytesWritten == 0) {
+        return true;
+    }
+    if (m25p16_isTransferPending()) {
+        if (!sync) {
+            return false;
+        }
+        while (m25p16_isTransferPending()) {
+        }
+    }
+    pendingBytes = 0;
+    flashfsSetTailAddress(tailAddress + bytesWritten);
+    flashfsAdvanceTailInBuffer(bytesWritten);
+    return true;
+}
+#endif
 bool flashfsFlushAsync()
 {
+#ifdef M25P16_DMA
+    if (!flashfsCompletePendingWrite(false)) {
+        return false;
+    }
+#endif
     if (flashfsBufferIsEmpty()) {
         return true;
     }
     uint8_t const * buffers[2];
     uint32_t bufferSizes[2];
-    uint32_t bytesWritten;
     flashfsGetDirtyDataBuffers(buffers, bufferSizes);
+#ifdef M25P16_DMA
+    if (m25p16_isReady()) {
+        if (flashfsIsEOF()) {
+            flashfsClearBuffer();
+            return true;
+        }
+        if (tailAddress % M25P16_PAGESIZE + bufferSizes[0] > M25P16_PAGESIZE) {
+            bufferSizes[0] = M25P16_PAGESIZE - tailAddress % M25P16_PAGESIZE;
+        }
+        m25p16_pageProgramDMA(tailAddress, buffers[0], bufferSizes[0]);
+        pendingBytes = bufferSizes[0];
+    }
+    return false;
+#else
+    uint32_t bytesWritten;
     bytesWritten = flashfsWriteBuffers(buffers, bufferSizes, 2, false);
     flashfsAdvanceTailInBuffer(bytesWritten);
     return flashfsBufferIsEmpty();
+#endif
 }
 void flashfsFlushSync()
 {
+#ifdef M25P16_DMA
+    flashfsCompletePendingWrite(true);
+#endif
     if (flashfsBufferIsEmpty()) {
         return;
     }
@@ -211,6 +265,9 @@ void flashfsWrite(const uint8_t *data, unsigned int len, bool sync)
 {
     uint8_t const * buffers[3];
     uint32_t bufferSizes[3];
+#ifdef M25P16_DMA
+    flashfsCompletePendingWrite(sync);
+#endif
     flashfsGetDirtyDataBuffers(buffers, bufferSizes);
     buffers[2] = data;
     bufferSizes[2] = len;
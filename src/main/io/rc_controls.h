@@ -38,6 +38,7 @@ typedef enum {
  BOXTEST1,
  BOXTEST2,
  BOXTEST3,
+ BOXBLACKBOXBURST,
  CHECKBOX_ITEM_COUNT
 } boxId_e;
 extern uint32_t rcModeActivationMask;
@@ -98,6 +99,7 @@ typedef struct modeActivationCondition_s {
     channelRange_t range;
 } modeActivationCondition_t;
 #define IS_RANGE_USABLE(range) ((range)->startStep < (range)->endStep)
+#define TPA_CURVE_POINTS 9
 typedef struct controlRateConfig_s {
  float thrMid8;
  float thrExpo8;
@@ -110,6 +112,7 @@ typedef struct controlRateConfig_s {
     float PitchAcroPlusFactor;
     float RollAcroPlusFactor;
     float YawAcroPlusFactor;
+    uint8_t tpaCurve[TPA_CURVE_POINTS];
 } controlRateConfig_t;
 extern float rcCommand[4];
 extern float rcCommandUsed[4];
@@ -22,36 +22,103 @@
 #include "io/rc_controls.h"
 #include "io/escservo.h"
 #include "io/rc_curves.h"
+#include "config/config.h"
 float lookupPitchRC[PITCH_LOOKUP_LENGTH];
 float lookupRollRC[ROLL_LOOKUP_LENGTH];
 float lookupYawRC[YAW_LOOKUP_LENGTH];
+float lookupRateRC[3][RC_LOOKUP_LENGTH];
 float lookupThrottleRC[THROTTLE_LOOKUP_LENGTH];
-void generatePitchCurve(controlRateConfig_t *controlRateConfig)
+int16_t lookupTpaRC[TPA_LOOKUP_LENGTH];
+int16_t lookupThrustRC[THRUST_LOOKUP_LENGTH];
+int32_t thrustLookupMin;
+int32_t thrustLookupScale;
+bool thrustCurveActive;
+static void generateExpoCurve(float *curve, float expo)
 {
     uint8_t i;
- float j = 0;
- for (i = 0; i < PITCH_LOOKUP_LENGTH; i++) {
-  lookupPitchRC[i] = (float)((2500.0f + controlRateConfig->rcPitchExpo8 * (j * j - 25.0f)) * j * 100.0f / 2500.0f);
-  j += 0.2f;
- }
+    const bool txStyleExpo = feature(FEATURE_TX_STYLE_EXPO);
+    for (i = 0; i < RC_LOOKUP_LENGTH; i++) {
+        const float stick = (float)(i * RC_LOOKUP_STEP);
+        if (txStyleExpo) {
+            const float x = stick / 500.0f;
+            const float e = expo / 100.0f;
+            curve[i] = stick * (e * (x * x * x) + x * (1 - e));
+        } else {
+            const float j = stick / 100.0f;
+            curve[i] = (2500.0f + expo * (j * j - 25.0f)) * j * 100.0f / 2500.0f;
+        }
+    }
+}
+void generatePitchCurve(controlRateConfig_t *controlRateConfig)
+{
+    generateExpoCurve(lookupPitchRC, controlRateConfig->rcPitchExpo8);
 }
 void generateRollCurve(controlRateConfig_t *controlRateConfig)
 {
-    uint8_t i;
- float j = 0;
- for (i = 0; i < ROLL_LOOKUP_LENGTH; i++) {
-  lookupRollRC[i] = (float)((2500.0f + controlRateConfig->rcRollExpo8 * (j * j - 25.0f)) * j * 100.0f / 2500.0f);
-  j += 0.2f;
- }
+    generateExpoCurve(lookupRollRC, controlRateConfig->rcRollExpo8);
 }
 void generateYawCurve(controlRateConfig_t *controlRateConfig)
+{
+    generateExpoCurve(lookupYawRC, controlRateConfig->rcYawExpo8);
+}
+void generateRateCurves(controlRateConfig_t *controlRateConfig)
+{
+    uint8_t axis, i;
+    const float acroPlusFactor[3] = {
+        controlRateConfig->RollAcroPlusFactor,
+        controlRateConfig->PitchAcroPlusFactor,
+        controlRateConfig->YawAcroPlusFactor
+    };
+    for (axis = 0; axis < 3; axis++) {
+        for (i = 0; i < RC_LOOKUP_LENGTH; i++) {
+            const float stick = (float)(i * RC_LOOKUP_STEP);
+            const float factor = (stick / 500.0f) * (acroPlusFactor[axis] / 100.0f) * stick + stick;
+            const float rate = controlRateConfig->rates[axis] * factor / 500.0f;
+            lookupRateRC[axis][i] = (rate > 1500.0f) ? 1500.0f : rate;
+        }
+    }
+}
+void generateTpaCurve(controlRateConfig_t *controlRateConfig)
 {
     uint8_t i;
- float j = 0;
- for (i = 0; i < YAW_LOOKUP_LENGTH; i++) {
-  lookupYawRC[i] = (float)((2500.0f + controlRateConfig->rcYawExpo8 * (j * j - 25.0f)) * j * 100.0f / 2500.0f);
-  j += 0.2f;
- }
+    for (i = 0; i < TPA_LOOKUP_LENGTH; i++) {
+        const uint16_t position = i * (TPA_CURVE_POINTS - 1);
+        const uint8_t point = position / (TPA_LOOKUP_LENGTH - 1);
+        const uint16_t remainder = position % (TPA_LOOKUP_LENGTH - 1);
+        int32_t attenuation = controlRateConfig->tpaCurve[point] * (TPA_LOOKUP_LENGTH - 1);
+        if (point < TPA_CURVE_POINTS - 1) {
+            attenuation += (controlRateConfig->tpaCurve[point + 1] - controlRateConfig->tpaCurve[point]) * remainder;
+        }
+        lookupTpaRC[i] = 100 - attenuation / (TPA_LOOKUP_LENGTH - 1);
+    }
+}
+void generateThrustCurve(escAndServoConfig_t *escAndServoConfig)
+{
+    uint8_t i;
+    const uint8_t *curve = escAndServoConfig->thrustCurve;
+    const int32_t range = escAndServoConfig->maxthrottle - escAndServoConfig->minthrottle;
+    thrustCurveActive = false;
+    for (i = 0; i < THRUST_CURVE_POINTS; i++) {
+        if (curve[i] != i * 100 / (THRUST_CURVE_POINTS - 1)) {
+            thrustCurveActive = true;
+        }
+    }
+    if (range <= 0) {
+        thrustCurveActive = false;
+        return;
+    }
+    thrustLookupMin = escAndServoConfig->minthrottle;
+    thrustLookupScale = ((THRUST_LOOKUP_LENGTH - 1) << 16) / range;
+    for (i = 0; i < THRUST_LOOKUP_LENGTH; i++) {
+        const uint16_t position = i * (THRUST_CURVE_POINTS - 1);
+        const uint8_t point = position / (THRUST_LOOKUP_LENGTH - 1);
+        const uint16_t remainder = position % (THRUST_LOOKUP_LENGTH - 1);
+        int32_t output = curve[point] * (THRUST_LOOKUP_LENGTH - 1);
+        if (point < THRUST_CURVE_POINTS - 1) {
+            output += (curve[point + 1] - curve[point]) * remainder;
+        }
+        lookupThrustRC[i] = escAndServoConfig->minthrottle + output * range / (100 * (THRUST_LOOKUP_LENGTH - 1));
+    }
 }
 void generateThrottleCurve(controlRateConfig_t *controlRateConfig, escAndServoConfig_t *escAndServoConfig)
 {
@@ -18,15 +18,52 @@
  */ 
 #pragma once 
        
-#define PITCH_LOOKUP_LENGTH 31
-#define ROLL_LOOKUP_LENGTH 31
-#define YAW_LOOKUP_LENGTH 31
+#define RC_LOOKUP_STEP 5
+#define RC_LOOKUP_LENGTH (500 / RC_LOOKUP_STEP + 1)
+#define PITCH_LOOKUP_LENGTH RC_LOOKUP_LENGTH
+#define ROLL_LOOKUP_LENGTH RC_LOOKUP_LENGTH
+#define YAW_LOOKUP_LENGTH RC_LOOKUP_LENGTH
 #define THROTTLE_LOOKUP_LENGTH 12
+#define TPA_LOOKUP_LENGTH 101
+#define THRUST_LOOKUP_LENGTH 65
 extern float lookupPitchRC[PITCH_LOOKUP_LENGTH];
-extern float lookupRollRC[PITCH_LOOKUP_LENGTH];
+extern float lookupRollRC[ROLL_LOOKUP_LENGTH];
 extern float lookupYawRC[YAW_LOOKUP_LENGTH];
+extern float lookupRateRC[3][RC_LOOKUP_LENGTH];
 extern float lookupThrottleRC[THROTTLE_LOOKUP_LENGTH];
+extern int16_t lookupTpaRC[TPA_LOOKUP_LENGTH];
+extern int16_t lookupThrustRC[THRUST_LOOKUP_LENGTH];
+extern int32_t thrustLookupMin;
+extern int32_t thrustLookupScale;
+extern bool thrustCurveActive;
+static inline float rcCurveLookup(const float *curve, float stick)
+{
+    if (stick >= 500.0f) {
+        return curve[RC_LOOKUP_LENGTH - 1];
+    }
+    if (stick <= 0.0f) {
+        return curve[0];
+    }
+    const float position = stick * (1.0f / RC_LOOKUP_STEP);
+    const int32_t index = (int32_t)position;
+    return curve[index] + (position - index) * (curve[index + 1] - curve[index]);
+}
+static inline int16_t thrustCurveLookup(int16_t command)
+{
+    const int32_t position = (command - thrustLookupMin) * thrustLookupScale;
+    if (position <= 0) {
+        return lookupThrustRC[0];
+    }
+    const int32_t index = position >> 16;
+    if (index >= THRUST_LOOKUP_LENGTH - 1) {
+        return lookupThrustRC[THRUST_LOOKUP_LENGTH - 1];
+    }
+    return lookupThrustRC[index] + (((lookupThrustRC[index + 1] - lookupThrustRC[index]) * (position & 0xFFFF)) >> 16);
+}
 void generatePitchCurve(controlRateConfig_t *controlRateConfig);
 void generateRollCurve(controlRateConfig_t *controlRateConfig);
 void generateYawCurve(controlRateConfig_t *controlRateConfig);
+void generateRateCurves(controlRateConfig_t *controlRateConfig);
+void generateTpaCurve(controlRateConfig_t *controlRateConfig);
 void generateThrottleCurve(controlRateConfig_t *controlRateConfig, escAndServoConfig_t *escAndServoConfig);
+void generateThrustCurve(escAndServoConfig_t *escAndServoConfig);
@@ -32,7 +32,8 @@ typedef enum {
     FUNCTION_TELEMETRY_MSP = (1 << 4),
     FUNCTION_TELEMETRY_SMARTPORT = (1 << 5),
     FUNCTION_RX_SERIAL = (1 << 6),
-    FUNCTION_BLACKBOX = (1 << 7)
+    FUNCTION_BLACKBOX = (1 << 7),
+    FUNCTION_ESC_TELEMETRY = (1 << 8)
 } serialPortFunction_e;
 typedef enum {
     BAUD_AUTO = 0,
@@ -68,6 +68,7 @@
 #include "flight/failsafe.h"
 #include "telemetry/telemetry.h"
 #include "telemetry/frsky.h"
+#include "blackbox/blackbox_burst.h"
 #include "config/runtime_config.h"
 #include "config/config.h"
 #include "config/config_profile.h"
@@ -121,6 +122,8 @@ static void cliGet(char *cmdline);
 static void cliStatus(char *cmdline);
 static void cliVersion(char *cmdline);
 static void cliRxRange(char *cmdline);
+static void cliThrust(char *cmdline);
+static void cliTpa(char *cmdline);
 #ifdef GPS
 static void cliGpsPassthrough(char *cmdline);
 #endif
@@ -164,7 +167,7 @@ static const char * const featureNames[] = {
     "SONAR", "TELEMETRY", "CURRENT_METER", "3D", "RX_PARALLEL_PWM",
     "RX_MSP", "RSSI_ADC", "LED_STRIP", "DISPLAY", "ONESHOT125",
     "BLACKBOX", "CHANNEL_FORWARDING", "MULTISHOT", "USE_PWM_RATE",
- "RESERVED", "TX_STYLE_EXPO", "SBUS_INVERTER", NULL
+ "DSHOT", "TX_STYLE_EXPO", "SBUS_INVERTER", NULL
 };
 static const char rxFailsafeModeCharacters[] = "ahs";
 static const rxFailsafeChannelMode_e rxFailsafeModesTable[RX_FAILSAFE_TYPE_COUNT][RX_FAILSAFE_MODE_COUNT] = {
@@ -274,12 +277,17 @@ const clicmd_t cmdTable[] = {
         "\treverse <servo> <source> r|n", cliServoMix),
 #endif
     CLI_COMMAND_DEF("status", "show status", NULL, cliStatus),
+    CLI_COMMAND_DEF("thrust", "configure thrust linearisation curve", NULL, cliThrust),
+    CLI_COMMAND_DEF("tpa", "configure tpa curve", NULL, cliTpa),
     CLI_COMMAND_DEF("version", "show version", NULL, cliVersion),
 };
 #define CMD_COUNT (sizeof(cmdTable) / sizeof(clicmd_t))
 static const char * const lookupTableOffOn[] = {
     "OFF", "ON"
 };
+static const char * const lookupTableRcSmoothing[] = {
+    "OFF", "LINEAR", "CUBIC"
+};
 static const char * const lookupTableUnit[] = {
     "IMPERIAL", "METRIC"
 };
@@ -311,6 +319,9 @@ static const char * const lookupTableGimbalMode[] = {
 static const char * const lookupTableBlackboxDevice[] = {
     "SERIAL", "SPIFLASH"
 };
+static const char * const lookupTableBlackboxEncoding[] = {
+    "VB", "RICE"
+};
 static const char * const lookupTablePidController[] = {
  "UNUSED", "RFPIDC", "RFPIDC"
 };
@@ -322,7 +333,8 @@ static const char * const lookupTableSerialRX[] = {
     "SUMH",
     "XB-B",
     "XB-B-RJ01",
-    "IBUS"
+    "IBUS",
+    "CRSF"
 };
 static const char * const lookupTableRFLoopCtrl[] = {
  "L1",
@@ -358,6 +370,9 @@ static const char * const lookupTableFailsafeCondition[] = {
  "FS_LOW_THROTTLE",
  "FS_NO_RX_PULSE_AND_LOW_THROTTLE",
 };
+static const char * const lookupTableDshotRate[] = {
+ "DSHOT150", "DSHOT300", "DSHOT600"
+};
 typedef struct lookupTableEntry_s {
     const char * const *values;
     const uint8_t valueCount;
@@ -372,6 +387,7 @@ typedef enum {
 #endif
 #ifdef BLACKBOX
     TABLE_BLACKBOX_DEVICE,
+    TABLE_BLACKBOX_ENCODING,
 #endif
     TABLE_CURRENT_SENSOR,
     TABLE_GIMBAL_MODE,
@@ -381,6 +397,8 @@ typedef enum {
  TABLE_ARM_METHOD,
  TABLE_FAILSAFE_MODE,
  TABLE_FAILSAFE_CONDITION,
+ TABLE_DSHOT_RATE,
+ TABLE_RC_SMOOTHING,
 } lookupTableIndex_e;
 static const lookupTableEntry_t lookupTables[] = {
     { lookupTableOffOn, sizeof(lookupTableOffOn) / sizeof(char *) },
@@ -392,6 +410,7 @@ static const lookupTableEntry_t lookupTables[] = {
 #endif
 #ifdef BLACKBOX
     { lookupTableBlackboxDevice, sizeof(lookupTableBlackboxDevice) / sizeof(char *) },
+    { lookupTableBlackboxEncoding, sizeof(lookupTableBlackboxEncoding) / sizeof(char *) },
 #endif
     { lookupTableCurrentSensor, sizeof(lookupTableCurrentSensor) / sizeof(char *) },
     { lookupTableGimbalMode, sizeof(lookupTableGimbalMode) / sizeof(char *) },
@@ -401,6 +420,8 @@ static const lookupTableEntry_t lookupTables[] = {
     { lookupTableArmMethod, sizeof(lookupTableArmMethod) / sizeof(char *) },
     { lookupTableFailsafeMode, sizeof(lookupTableFailsafeMode) / sizeof(char *) },
     { lookupTableFailsafeCondition, sizeof(lookupTableFailsafeCondition) / sizeof(char *) },
+    { lookupTableDshotRate, sizeof(lookupTableDshotRate) / sizeof(char *) },
+    { lookupTableRcSmoothing, sizeof(lookupTableRcSmoothing) / sizeof(char *) },
 };
 #define VALUE_TYPE_OFFSET 0
 #define VALUE_SECTION_OFFSET 4
@@ -446,7 +467,7 @@ const clivalue_t valueTable[] = {
     { "rssi_scale", VAR_UINT8 | MASTER_VALUE, &masterConfig.rxConfig.rssi_scale, .config.minmax = { RSSI_SCALE_MIN, RSSI_SCALE_MAX } },
     { "rssi_ppm_invert", VAR_INT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.rxConfig.rssi_ppm_invert, .config.lookup = { TABLE_OFF_ON } },
     { "input_filtering_mode", VAR_INT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.inputFilteringMode, .config.lookup = { TABLE_OFF_ON } },
-    { "rc_smoothing", VAR_INT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.rxConfig.rcSmoothing, .config.lookup = { TABLE_OFF_ON } },
+    { "rc_smoothing", VAR_INT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.rxConfig.rcSmoothing, .config.lookup = { TABLE_RC_SMOOTHING } },
     { "roll_yaw_cam_mix_degrees", VAR_UINT8 | MASTER_VALUE, &masterConfig.rxConfig.fpvCamAngleDegrees, .config.minmax = { 0, 50 } },
     { "min_throttle", VAR_UINT16 | MASTER_VALUE, &masterConfig.escAndServoConfig.minthrottle, .config.minmax = { PWM_RANGE_ZERO, PWM_RANGE_MAX } },
     { "max_throttle", VAR_UINT16 | MASTER_VALUE, &masterConfig.escAndServoConfig.maxthrottle, .config.minmax = { PWM_RANGE_ZERO, PWM_RANGE_MAX } },
@@ -456,7 +477,13 @@ const clivalue_t valueTable[] = {
     { "enable_buzzer_p6", VAR_UINT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.use_buzzer_p6, .config.lookup = { TABLE_OFF_ON } },
 #endif
     { "motor_pwm_rate", VAR_UINT16 | MASTER_VALUE, &masterConfig.motor_pwm_rate, .config.minmax = { 50, 32000 } },
-    { "servo_pwm_rate", VAR_UINT16 | MASTER_VALUE, &masterConfig.servo_pwm_rate, .config.minmax = { 50, 498 } },
+    { "dshot_rate", VAR_UINT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.dshot_rate, .config.lookup = { TABLE_DSHOT_RATE } },
+    { "motor_skew_measure", VAR_UINT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.motor_skew_measure, .config.lookup = { TABLE_OFF_ON } },
+    { "motor_poles", VAR_UINT8 | MASTER_VALUE, &masterConfig.motor_poles, .config.minmax = { 2, 64 } },
+    { "rpm_notch_harmonics", VAR_UINT8 | MASTER_VALUE, &masterConfig.gyroConfig.rpm_notch_harmonics, .config.minmax = { 0, RPM_NOTCH_MAX_HARMONICS } },
+    { "rpm_notch_q", VAR_UINT8 | MASTER_VALUE, &masterConfig.gyroConfig.rpm_notch_q, .config.minmax = { 10, 250 } },
+    { "rpm_notch_min_hz", VAR_UINT8 | MASTER_VALUE, &masterConfig.gyroConfig.rpm_notch_min_hz, .config.minmax = { 20, 250 } },
+    { "servo_pwm_rate", VAR_UINT16 | MASTER_VALUE, &masterConfig.servo_pwm_rate, .config.minmax = { 50, 560 } },
     { "small_angle", VAR_UINT8 | MASTER_VALUE, &masterConfig.small_angle, .config.minmax = { 0, 180 } },
     { "serialrx_provider", VAR_UINT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.rxConfig.serialrx_provider, .config.lookup = { TABLE_SERIAL_RX } },
     { "spektrum_sat_bind", VAR_UINT8 | MASTER_VALUE, &masterConfig.rxConfig.spektrum_sat_bind, .config.minmax = { SPEKTRUM_SAT_BIND_DISABLED, SPEKTRUM_SAT_BIND_MAX} },
@@ -487,6 +514,17 @@ const clivalue_t valueTable[] = {
     { "cfscond", VAR_UINT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.fsCondition, .config.lookup = { TABLE_FAILSAFE_CONDITION } },
     { "acc_hardware", VAR_UINT8 | MASTER_VALUE, &masterConfig.acc_hardware, .config.minmax = { 0, ACC_MAX } },
     { "emu_blackbox_device", VAR_UINT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.blackbox_device, .config.lookup = { TABLE_BLACKBOX_DEVICE } },
+    { "blackbox_rate_hz", VAR_UINT16 | MASTER_VALUE, &masterConfig.blackbox_rate_hz, .config.minmax = { 0, 32000 } },
+    { "blackbox_pid_hz", VAR_UINT16 | MASTER_VALUE, &masterConfig.blackbox_pid_hz, .config.minmax = { 0, 32000 } },
+    { "blackbox_rc_hz", VAR_UINT16 | MASTER_VALUE, &masterConfig.blackbox_rc_hz, .config.minmax = { 0, 32000 } },
+    { "blackbox_batt_hz", VAR_UINT16 | MASTER_VALUE, &masterConfig.blackbox_batt_hz, .config.minmax = { 0, 32000 } },
+    { "blackbox_encoding", VAR_UINT8 | MASTER_VALUE | MODE_LOOKUP, &masterConfig.blackbox_encoding, .config.lookup = { TABLE_BLACKBOX_ENCODING } },
+    { "blackbox_burst_ms", VAR_UINT16 | MASTER_VALUE, &masterConfig.blackbox_burst_ms, .config.minmax = { 0, 10000 } },
+    { "blackbox_burst_crash_dps", VAR_UINT16 | MASTER_VALUE, &masterConfig.blackbox_burst_crash_dps, .config.minmax = { 0, 4000 } },
+    { "blackbox_pretrigger_ms", VAR_UINT16 | MASTER_VALUE, &masterConfig.blackbox_pretrigger_ms, .config.minmax = { 0, 10000 } },
+    { "blackbox_burst_denom", VAR_UINT8 | MASTER_VALUE, &masterConfig.blackbox_burst_denom, .config.minmax = { 1, 32 } },
+    { "blackbox_trigger", VAR_UINT8 | MASTER_VALUE, &masterConfig.blackbox_trigger, .config.minmax = { 0, BLACKBOX_TRIGGER_ALL } },
+    { "blackbox_trigger_g", VAR_UINT8 | MASTER_VALUE, &masterConfig.blackbox_trigger_g, .config.minmax = { 0, 16 } },
  { "fpexpo", VAR_FLOAT | CONTROL_RATE_VALUE, &masterConfig.controlRateProfiles[0].rcPitchExpo8, .config.minmax = { 0, 100 } },
     { "frexpo", VAR_FLOAT | CONTROL_RATE_VALUE, &masterConfig.controlRateProfiles[0].rcRollExpo8, .config.minmax = { 0, 100 } },
     { "fyexpo", VAR_FLOAT | CONTROL_RATE_VALUE, &masterConfig.controlRateProfiles[0].rcYawExpo8, .config.minmax = { 0, 100 } },
@@ -509,12 +547,18 @@ const clivalue_t valueTable[] = {
     { "fykp", VAR_FLOAT | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.P_f[YAW], .config.minmax = { 0, 300 } },
     { "fyki", VAR_FLOAT | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.I_f[YAW], .config.minmax = { 0, 300 } },
     { "fykd", VAR_FLOAT | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.D_f[YAW], .config.minmax = { 0, 300 } },
+    { "fpkf", VAR_FLOAT | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.F_f[PITCH], .config.minmax = { 0, 300 } },
+    { "frkf", VAR_FLOAT | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.F_f[ROLL], .config.minmax = { 0, 300 } },
+    { "fykf", VAR_FLOAT | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.F_f[YAW], .config.minmax = { 0, 300 } },
     { "wpgyrolpf", VAR_UINT16 | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.wpgyrolpf, .config.minmax = {0, 255 } },
     { "wrgyrolpf", VAR_UINT16 | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.wrgyrolpf, .config.minmax = {0, 255 } },
     { "wygyrolpf", VAR_UINT16 | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.wygyrolpf, .config.minmax = {0, 255 } },
     { "wpkdlpf", VAR_UINT16 | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.wpkdlpf, .config.minmax = {0, 255 } },
     { "wrkdlpf", VAR_UINT16 | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.wrkdlpf, .config.minmax = {0, 255 } },
     { "wykdlpf", VAR_UINT16 | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.wykdlpf, .config.minmax = {0, 255 } },
+    { "wpfflpf", VAR_UINT8 | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.ff_lpf_hz[PITCH], .config.minmax = {0, 255 } },
+    { "wrfflpf", VAR_UINT8 | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.ff_lpf_hz[ROLL], .config.minmax = {0, 255 } },
+    { "wyfflpf", VAR_UINT8 | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.ff_lpf_hz[YAW], .config.minmax = {0, 255 } },
     { "witchcraft", VAR_UINT16 | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.witchcraft, .config.minmax = { 0, 255 } },
     { "fcquick", VAR_FLOAT | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.fcquick, .config.minmax = {0, 32000 } },
     { "fcrap", VAR_FLOAT | PROFILE_VALUE, &masterConfig.profile[0].pidProfile.fcrap, .config.minmax = {0, 32000 } },
@@ -1573,6 +1617,68 @@ static void cliRxRange(char *cmdline)
         }
     }
 }
+static void cliThrust(char *cmdline)
+{
+    int i, validArgumentCount = 0;
+    char *ptr;
+    if (isEmpty(cmdline)) {
+        for (i = 0; i < THRUST_CURVE_POINTS; i++) {
+            cliPrintf("thrust %u %u\r\n", i, masterConfig.escAndServoConfig.thrustCurve[i]);
+        }
+    } else {
+        ptr = cmdline;
+        i = atoi(ptr);
+        if (i >= 0 && i < THRUST_CURVE_POINTS) {
+            int output = 0;
+            ptr = strchr(ptr, ' ');
+            if (ptr) {
+                output = atoi(++ptr);
+                validArgumentCount++;
+            }
+            if (validArgumentCount != 1) {
+                cliShowParseError();
+            } else if (output < 0 || output > 100) {
+                cliShowArgumentRangeError("output", 0, 100);
+            } else {
+                masterConfig.escAndServoConfig.thrustCurve[i] = output;
+                generateThrustCurve(&masterConfig.escAndServoConfig);
+            }
+        } else {
+            cliShowArgumentRangeError("point", 0, THRUST_CURVE_POINTS - 1);
+        }
+    }
+}
+static void cliTpa(char *cmdline)
+{
+    int i, validArgumentCount = 0;
+    char *ptr;
+    if (isEmpty(cmdline)) {
+        for (i = 0; i < TPA_CURVE_POINTS; i++) {
+            cliPrintf("tpa %u %u\r\n", i, currentControlRateProfile->tpaCurve[i]);
+        }
+    } else {
+        ptr = cmdline;
+        i = atoi(ptr);
+        if (i >= 0 && i < TPA_CURVE_POINTS) {
+            int attenuation = 0;
+            ptr = strchr(ptr, ' ');
+            if (ptr) {
+                attenuation = atoi(++ptr);
+                validArgumentCount++;
+            }
+            if (validArgumentCount != 1) {
+                cliShowParseError();
+            } else if (attenuation < 0 || attenuation > 100) {
+                cliShowArgumentRangeError("attenuation", 0, 100);
+            } else {
+                currentControlRateProfile->tpaCurve[i] = attenuation;
+                generateTpaCurve(currentControlRateProfile);
+            }
+        } else {
+            cliShowArgumentRangeError("point", 0, TPA_CURVE_POINTS - 1);
+        }
+    }
+}
 #ifdef LED_STRIP
 static void cliLed(char *cmdline)
 {
@@ -1674,8 +1780,8 @@ static void cliServo(char *cmdline)
         }
         servo = &currentProfile->servoConf[i];
         if (
-            arguments[MIN] < PWM_PULSE_MIN || arguments[MIN] > PWM_PULSE_MAX ||
-            arguments[MAX] < PWM_PULSE_MIN || arguments[MAX] > PWM_PULSE_MAX ||
+            arguments[MIN] < SERVO_PULSE_MIN || arguments[MIN] > SERVO_PULSE_MAX ||
+            arguments[MAX] < SERVO_PULSE_MIN || arguments[MAX] > SERVO_PULSE_MAX ||
             arguments[MIDDLE] < arguments[MIN] || arguments[MIDDLE] > arguments[MAX] ||
             arguments[MIN] > arguments[MAX] || arguments[MAX] < arguments[MIN] ||
             arguments[RATE] < -100 || arguments[RATE] > 100 ||
@@ -1991,6 +2097,8 @@ static void cliDump(char *cmdline)
             if (mask & (1 << i))
                 cliPrintf("feature %s\r\n", featureNames[i]);
         }
+        cliPrint("\r\n\r\n# thrust\r\n");
+        cliThrust("");
         cliPrint("\r\n\r\n# map\r\n");
         for (i = 0; i < 8; i++)
             buf[masterConfig.rxConfig.rcmap[i]] = rcChannelLetters[i];
@@ -2040,6 +2148,8 @@ static void cliDump(char *cmdline)
         cliRateProfile("");
         printSectionBreak();
         dumpValues(CONTROL_RATE_VALUE);
+        cliPrint("\r\n# tpa\r\n");
+        cliTpa("");
     }
 }
 void cliEnter(serialPort_t *serialPort)
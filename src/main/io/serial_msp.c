@@ -37,6 +37,7 @@
 #include "drivers/gpio.h"
 #include "drivers/timer.h"
 #include "drivers/pwm_rx.h"
+#include "drivers/pwm_output.h"
 #include "drivers/gyro_sync.h"
 #include "rx/rx.h"
 #include "rx/msp.h"
@@ -58,6 +59,7 @@
 #include "sensors/compass.h"
 #include "sensors/gyro.h"
 #include "flight/mixer.h"
+#include "sensors/esc_telemetry.h"
 #include "flight/pid.h"
 #include "flight/imu.h"
 #include "flight/failsafe.h"
@@ -79,6 +81,7 @@
 static serialPort_t *mspSerialPort;
 extern uint16_t cycleTime;
 extern uint16_t rssi;
+extern uint8_t motorCount;
 void useRcControlsConfig(modeActivationCondition_t *modeActivationConditions, escAndServoConfig_t *escAndServoConfigToUse, pidProfile_t *pidProfileToUse);
 #define MSP_PROTOCOL_VERSION 0
 #define API_VERSION_MAJOR 2
@@ -179,6 +182,10 @@ static const char * const boardIdentifier = TARGET_BOARD_IDENTIFIER;
 #define MSP_NAV_STATUS 121
 #define MSP_NAV_CONFIG 122
 #define MSP_PID_FLOAT 123
+#define MSP_TPA_CURVE 124
+#define MSP_ESC_TELEMETRY 125
+#define MSP_MOTOR_SKEW 126
+#define MSP_RX_STATS 127
 #define MSP_RF_CUSTOM_OUT 150
 #define MSP_RF_CUSTOM_IN 151
 #define MSP_SET_RAW_RC 200
@@ -197,6 +204,8 @@ static const char * const boardIdentifier = TARGET_BOARD_IDENTIFIER;
 #define MSP_SET_MOTOR 214
 #define MSP_SET_NAV_CONFIG 215
 #define MSP_SET_PID_FLOAT 216
+#define MSP_SET_TPA_CURVE 217
+#define MSP_RESET_RX_STATS 218
 #define MSP_EEPROM_WRITE 250
 #define MSP_DEBUGMSG 253
 #define MSP_DEBUG 254
@@ -232,6 +241,7 @@ static const box_t boxes[CHECKBOX_ITEM_COUNT + 1] = {
     { BOXTEST1, "TEST 1;", 15 },
     { BOXTEST2, "TEST 2;", 16 },
     { BOXTEST3, "TEST 3;", 17 },
+    { BOXBLACKBOXBURST, "BLACKBOX BURST;", 18 },
     { CHECKBOX_ITEM_COUNT, NULL, 0xFF }
 };
 static uint8_t activeBoxIds[CHECKBOX_ITEM_COUNT];
@@ -488,6 +498,7 @@ void mspInit(serialConfig_t *serialConfig)
         activeBoxIds[activeBoxIdCount++] = BOXTELEMETRY;
     if (feature(FEATURE_BLACKBOX)){
         activeBoxIds[activeBoxIdCount++] = BOXBLACKBOX;
+        activeBoxIds[activeBoxIdCount++] = BOXBLACKBOXBURST;
     }
     if (feature(FEATURE_FAILSAFE)){
         activeBoxIds[activeBoxIdCount++] = BOXFAILSAFE;
@@ -590,7 +601,8 @@ bool processOutCommand(uint8_t cmdMSP)
    IS_ENABLED(IS_RC_MODE_ACTIVE(BOXDELETEFLASH)) << BOXDELETEFLASH |
             IS_ENABLED(IS_RC_MODE_ACTIVE(BOXTEST1)) << BOXTEST1 |
             IS_ENABLED(IS_RC_MODE_ACTIVE(BOXTEST2)) << BOXTEST2 |
-            IS_ENABLED(IS_RC_MODE_ACTIVE(BOXTEST3)) << BOXTEST3;
+            IS_ENABLED(IS_RC_MODE_ACTIVE(BOXTEST3)) << BOXTEST3 |
+            IS_ENABLED(IS_RC_MODE_ACTIVE(BOXBLACKBOXBURST)) << BOXBLACKBOXBURST;
         for (i = 0; i < activeBoxIdCount; i++) {
             int flag = (tmp & (1 << activeBoxIds[i]));
             if (flag)
@@ -720,6 +732,42 @@ bool processOutCommand(uint8_t cmdMSP)
             }
         }
         break;
+    case MSP_TPA_CURVE:
+        headSerialReply(TPA_CURVE_POINTS);
+        for (i = 0; i < TPA_CURVE_POINTS; i++) {
+            serialize8(currentControlRateProfile->tpaCurve[i]);
+        }
+        break;
+    case MSP_ESC_TELEMETRY:
+        tmp = escTelemetryIsEnabled() ? motorCount : 0;
+        headSerialReply(1 + tmp * 9);
+        serialize8(tmp);
+        for (i = 0; i < tmp; i++) {
+            serialize8(escTelemetry.esc[i].temperature);
+            serialize16(escTelemetry.esc[i].voltage);
+            serialize16(escTelemetry.esc[i].current);
+            serialize16(escTelemetry.esc[i].consumption);
+            serialize16(escTelemetry.esc[i].erpm);
+        }
+        break;
+    case MSP_MOTOR_SKEW:
+        {
+            uint32_t skewNs, maxSkewNs;
+            headSerialReply(9);
+            serialize8(pwmGetMotorSkew(&skewNs, &maxSkewNs) ? 1 : 0);
+            serialize32(skewNs);
+            serialize32(maxSkewNs);
+        }
+        break;
+    case MSP_RX_STATS:
+        headSerialReply(16);
+        serialize32(rxFrameStats.frameCount);
+        serialize32(rxFrameStats.droppedFrames);
+        serialize16(rxFrameStats.interval);
+        serialize16(rxFrameStats.jitter);
+        serialize16(rxFrameStats.latency);
+        serialize16(rxFrameStats.maxLatency);
+        break;
     case MSP_PID_FLOAT:
         headSerialReply(3 * PID_ITEM_COUNT * 2);
         for (i = 0; i < 3; i++) {
@@ -1109,6 +1157,15 @@ static bool processInCommand(void)
             }
         }
         break;
+    case MSP_SET_TPA_CURVE:
+        for (i = 0; i < TPA_CURVE_POINTS; i++) {
+            currentControlRateProfile->tpaCurve[i] = MIN(read8(), 100);
+        }
+        generateTpaCurve(currentControlRateProfile);
+        break;
+    case MSP_RESET_RX_STATS:
+        rxFrameStatsReset();
+        break;
     case MSP_SET_PID_FLOAT:
         for (i = 0; i < 3; i++) {
             currentProfile->pidProfile.P_f[i] = (float)read16() / 1000.0f;
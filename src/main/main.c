@@ -39,6 +39,7 @@
 #include "drivers/accgyro.h"
 #include "drivers/compass.h"
 #include "drivers/pwm_mapping.h"
+#include "drivers/pwm_output.h"
 #include "drivers/pwm_rx.h"
 #include "drivers/adc.h"
 #include "drivers/bus_i2c.h"
@@ -74,6 +75,7 @@
 #include "flight/pid.h"
 #include "flight/imu.h"
 #include "flight/mixer.h"
+#include "sensors/esc_telemetry.h"
 #include "flight/failsafe.h"
 #include "flight/navigation.h"
 #include "config/runtime_config.h"
@@ -266,6 +268,8 @@ void init(void)
 #endif
  pwm_params.useOneshot = feature(FEATURE_ONESHOT125);
  pwm_params.useMultiShot = feature(FEATURE_MULTISHOT);
+ pwm_params.useDshot = feature(FEATURE_DSHOT);
+ pwm_params.dshotRate = masterConfig.dshot_rate;
  pwm_params.usePwmRate = feature(FEATURE_USE_PWM_RATE);
     pwm_params.useFastPWM = masterConfig.use_fast_pwm ? true : false;
     pwm_params.motorPwmRate = masterConfig.motor_pwm_rate;
@@ -290,7 +294,9 @@ void init(void)
     }
     pwmOutputConfiguration_t *pwmOutputConfiguration = pwmInit(&pwm_params);
     mixerUsePWMOutputConfiguration(pwmOutputConfiguration);
-    if (!feature(FEATURE_ONESHOT125) && !feature(FEATURE_MULTISHOT))
+    pwmSetMotorSkewMeasurement(masterConfig.motor_skew_measure);
+    escTelemetryInit(masterConfig.motor_poles);
+    if (!feature(FEATURE_ONESHOT125) && !feature(FEATURE_MULTISHOT) && !feature(FEATURE_DSHOT))
         motorControlEnable = true;
     systemState |= SYSTEM_STATE_MOTORS_READY;
 #ifdef BEEPER
@@ -65,7 +65,9 @@
 #include "rx/msp.h"
 #include "telemetry/telemetry.h"
 #include "blackbox/blackbox.h"
+#include "blackbox/blackbox_burst.h"
 #include "flight/mixer.h"
+#include "sensors/esc_telemetry.h"
 #include "flight/pid.h"
 #include "flight/imu.h"
 #include "flight/altitudehold.h"
@@ -140,30 +142,59 @@ bool isCalibrating()
 #endif
     return (!isAccelerationCalibrationComplete() && sensors(SENSOR_ACC)) || (!isGyroCalibrationComplete());
 }
-void filterRc(void){
-    static float lastCommand[4] = { 0, 0, 0, 0 };
-    static float deltaRC[4] = { 0, 0, 0, 0 };
-    static int16_t rcInterpolationFactor;
-    static int16_t factor = 0;
-    uint16_t rxRefreshRate;
-    initRxRefreshRate(&rxRefreshRate);
-    rcInterpolationFactor = (int16_t)rxRefreshRate / (int16_t)targetESCwritetime + 1;
+void filterRc(void)
+{
+    static float rcInterpolated[4];
+    static float rcStep[4];
+    static float rcStepAccel[4];
+    static float rcStepJerk[4];
+    static uint16_t rcStepsRemaining = 0;
+    int channel;
     if (isRXDataNew) {
-        for (int channel=0; channel < 4; channel++) {
-            deltaRC[channel] = rcCommand[channel] - (lastCommand[channel] - deltaRC[channel] * (float)factor / (float)rcInterpolationFactor);
-            lastCommand[channel] = rcCommand[channel];
-        }
         isRXDataNew = false;
-        factor = rcInterpolationFactor - 1;
-    } else {
-     factor--;
+        if (masterConfig.rxConfig.rcSmoothing == RC_SMOOTHING_OFF) {
+            for (channel = 0; channel < 4; channel++) {
+                rcCommandUsed[channel] = rcInterpolated[channel] = rcCommand[channel];
+                rcStep[channel] = 0;
+            }
+            rcStepsRemaining = 0;
+            return;
+        }
+        uint16_t rxInterval = rxFrameStats.interval;
+        if (!rxInterval) {
+            initRxRefreshRate(&rxInterval);
+        }
+        const uint16_t steps = MAX((rxInterval + targetESCwritetime / 2) / targetESCwritetime, 1);
+        const float stepScale = 1.0f / steps;
+        for (channel = 0; channel < 4; channel++) {
+            const float delta = rcCommand[channel] - rcInterpolated[channel];
+            if (masterConfig.rxConfig.rcSmoothing == RC_SMOOTHING_CUBIC) {
+                const float v0 = rcStep[channel];
+                const float v1 = delta * stepScale;
+                const float c2 = 2.0f * (v1 - v0) * stepScale;
+                const float c3 = (v0 - v1) * stepScale * stepScale;
+                rcStep[channel] = v0 + c2 + c3;
+                rcStepAccel[channel] = 2.0f * c2 + 6.0f * c3;
+                rcStepJerk[channel] = 6.0f * c3;
+            } else {
+                rcStep[channel] = delta * stepScale;
+            }
+        }
+        rcStepsRemaining = steps;
     }
-    if (factor > 0) {
-     for (int channel=0; channel < 4; channel++) {
-      rcCommandUsed[channel] = lastCommand[channel] - deltaRC[channel] * (float)factor / (float)rcInterpolationFactor;
-     }
-    } else {
-     factor = 0;
+    if (!rcStepsRemaining) {
+        return;
+    }
+    rcStepsRemaining--;
+    for (channel = 0; channel < 4; channel++) {
+        rcInterpolated[channel] += rcStep[channel];
+        rcCommandUsed[channel] = rcInterpolated[channel];
+    }
+    if (masterConfig.rxConfig.rcSmoothing == RC_SMOOTHING_CUBIC) {
+        for (channel = 0; channel < 4; channel++) {
+            rcStep[channel] += rcStepAccel[channel];
+            rcStepAccel[channel] += rcStepJerk[channel];
+        }
     }
 }
 void scaleRcCommandToFpvCamAngle(void) {
@@ -180,43 +211,6 @@ void scaleRcCommandToFpvCamAngle(void) {
     rcCommand[ROLL] = constrain(roll * cosFactor - yaw * sinFactor, -500, 500);
     rcCommand[YAW] = constrain(yaw * cosFactor + roll * sinFactor, -500, 500);
 }
-typedef struct {
- int numberOfPoints;
- float *curveValues;
- float *curveLocations;
-} MultiPointCurve;
-MultiPointCurve tpaCurve;
-float getValueFromMultiPointCurve(MultiPointCurve *curve, float input) {
- float lastCurvePoint = curve->curveValues[curve->numberOfPoints-1];
- float curvePointA = curve->curveLocations[0];
- float valueA = curve->curveValues[0];
- float curvePointB = curve->curveLocations[1];
- float valueB = curve->curveValues[1];
- float localizedInputRange;
- float normalizedInput;
- float magnitude;
- float value;
- if (input <= curve->curveLocations[0]) {
-  return curve->curveValues[0];
- }
- if (input >= lastCurvePoint) {
-  return lastCurvePoint;
- }
- for (int curveIndex = 0; curveIndex < curve->numberOfPoints - 1; curveIndex++) {
-  curvePointA = curve->curveLocations[curveIndex];
-  valueA = curve->curveValues[curveIndex];
-  curvePointB = curve->curveLocations[curveIndex+1];
-  valueB = curve->curveValues[curveIndex+1];
-  if (input >= curvePointA && input <= curvePointB) {
-   localizedInputRange = curvePointB - curvePointA;
-   normalizedInput = (input - curvePointA) / localizedInputRange;
-   magnitude = valueB - valueA;
-   value = normalizedInput * magnitude + valueA;
-   return value;
-  }
- }
- return 0.0f;
-}
 int32_t applyLegacyTPA(void) {
  uint16_t range;
  uint16_t location;
@@ -233,20 +227,9 @@ int32_t applyLegacyTPA(void) {
  }
  return 100;
 }
-int16_t applyTPA(float throttle) {
- float attenuation;
-    static float curveValuesC[9] = {0.0f, 0.0f, 0.15f, 0.20f, 0.20f, 0.25f, 0.30f, 0.3f, 0.3f};
-    static float curveLocationsC[9] = {0.0f, 0.15f, 0.35f, 0.50f, 0.55f, 0.60f, 0.75f, 0.85f, 1.0f};
-    tpaCurve.numberOfPoints = 9;
-    tpaCurve.curveValues = curveValuesC;
-    tpaCurve.curveLocations = curveLocationsC;
- attenuation = getValueFromMultiPointCurve(&tpaCurve, throttle);
- return (int16_t)((1.0f - attenuation) * 100.0f);
-}
 void annexCode(void)
 {
     int32_t tmp, tmp2;
-    float tmp3, tmp4;
     int32_t axis;
     bool allowSkitzo = true;
     float OldRange, OldValue, NewRange, NewValue, OldMax, OldMin, NewMax, NewMin, deadBand;
@@ -297,14 +280,7 @@ void annexCode(void)
       tmp = 0;
      }
     }
-    if (feature(FEATURE_TX_STYLE_EXPO) ) {
-     tmp3 = (float)tmp / 500.0f;
-     tmp4 = (float)currentControlRateProfile->rcPitchExpo8 / 100.0f;
-     rcCommand[axis] = (float)tmp*( tmp4*(tmp3*tmp3*tmp3) + tmp3*(1-tmp4) );
-    } else {
-     tmp2 = tmp / 20;
-     rcCommand[axis] = (float)lookupPitchRC[tmp2] + (float)(tmp - tmp2 * 20) * (lookupPitchRC[tmp2 + 1] - lookupPitchRC[tmp2]) / 20;
-    }
+    rcCommand[axis] = rcCurveLookup(lookupPitchRC, tmp);
    } else if (axis == ROLL) {
     if (currentProfile->rcControlsConfig.deadband) {
      if (tmp > currentProfile->rcControlsConfig.deadband) {
@@ -313,14 +289,7 @@ void annexCode(void)
       tmp = 0;
      }
     }
-    if (feature(FEATURE_TX_STYLE_EXPO) ) {
-     tmp3 = (float)tmp / 500.0f;
-     tmp4 = (float)currentControlRateProfile->rcRollExpo8 / 100.0f;
-     rcCommand[axis] = (float)tmp*( tmp4*(tmp3*tmp3*tmp3) + tmp3*(1-tmp4) );
-    } else {
-     tmp2 = tmp / 20;
-     rcCommand[axis] = (float)lookupRollRC[tmp2] + (float)(tmp - tmp2 * 20) * (lookupRollRC[tmp2 + 1] - lookupRollRC[tmp2]) / 20;
-    }
+    rcCommand[axis] = rcCurveLookup(lookupRollRC, tmp);
    } else if (axis == YAW) {
     if (currentProfile->rcControlsConfig.yaw_deadband) {
      if (tmp > currentProfile->rcControlsConfig.yaw_deadband) {
@@ -329,14 +298,7 @@ void annexCode(void)
       tmp = 0;
      }
     }
-    if (feature(FEATURE_TX_STYLE_EXPO) ) {
-     tmp3 = (float)tmp / 500.0f;
-     tmp4 = (float)currentControlRateProfile->rcYawExpo8 / 100.0f;
-     rcCommand[axis] = (float)tmp*( tmp4*(tmp3*tmp3*tmp3) + tmp3*(1-tmp4) ) * -masterConfig.yaw_control_direction;
-    } else {
-     tmp2 = tmp / 20;
-     rcCommand[axis] = (float)((float)lookupYawRC[tmp2] + (float)(tmp - tmp2 * 20) * (lookupYawRC[tmp2 + 1] - lookupYawRC[tmp2]) / 20) * -masterConfig.yaw_control_direction;
-    }
+    rcCommand[axis] = rcCurveLookup(lookupYawRC, tmp) * -masterConfig.yaw_control_direction;
    }
    if (rcData[axis] < masterConfig.rxConfig.midrc) {
     rcCommand[axis] = -rcCommand[axis];
@@ -489,6 +451,8 @@ void mwArm(void)
         if (!ARMING_FLAG(PREVENT_ARMING)) {
          doubleOnce = true;
             ENABLE_ARMING_FLAG(ARMED);
+            pidSelectLoopRateVariant();
+            mixerSelectMotorCountVariant();
             rx_watchdog_init(Watchdog_Timeout_2s);
             timeArmedAt = micros();
             headFreeModeHold = DECIDEGREES_TO_DEGREES(attitude.values.yaw);
@@ -717,6 +681,9 @@ void MainPidLoop(void)
   dT = (float)targetESCwritetime * 0.000001f;
  }
  imuUpdateGyroAndAttitude();
+#ifdef BLACKBOX
+    blackboxBurstCapture();
+#endif
     if (counter == ESCWriteDenominator) { } else {
         counter++;
      return;
@@ -772,18 +739,15 @@ void MainPidLoop(void)
         &masterConfig.rxConfig
     );
     debug[2]= micros() - cycleTimenow;
-    mixTable();
-#ifdef USE_SERVOS
-    filterServos();
-    writeServos();
-#endif
+    mix_table();
     if (motorControlEnable) {
         writeMotors();
+        rxFrameStatsMotorUpdate();
     }
 #ifdef BLACKBOX
  if (!cliMode && feature(FEATURE_BLACKBOX)) {
   if (masterConfig.rf_loop_ctrl <= DLPF_H8) {
-   handleBlackbox();
+   blackboxCapture();
   }
  }
 #endif
@@ -810,10 +774,34 @@ void taskCheckAndFlashErase(void) {
  }
 #endif
 }
+void taskUpdateEscTelemetry(void)
+{
+    escTelemetryProcess(micros());
+}
+void taskUpdateServos(void)
+{
+#ifdef USE_SERVOS
+    static uint32_t servoLastServiced = 0;
+    if (isMixerUsingServos() && cmp32(currentTime, servoLastServiced) >= 1000000 / masterConfig.servo_pwm_rate) {
+        servoLastServiced = currentTime;
+        mixServos();
+        filterServos();
+        writeServos();
+    }
+#endif
+}
 void taskHandleSerial(void)
 {
     handleSerial();
 }
+void taskBlackbox(void)
+{
+#ifdef BLACKBOX
+    if (!cliMode && feature(FEATURE_BLACKBOX)) {
+        handleBlackbox();
+    }
+#endif
+}
 void taskUpdateBeeper(void)
 {
     beeperUpdate();
@@ -26,4 +26,3 @@ void mwDisarm(void);
 void mwArm(void);
 void MainPidLoop(void);
 void UpdateAccelerometer(void);
-int16_t applyTPA(float throttle);
@@ -0,0 +1,189 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "platform.h"
+#include "build_config.h"
+#include "common/maths.h"
+#include "drivers/system.h"
+#include "drivers/serial.h"
+#include "drivers/serial_uart.h"
+#include "io/serial.h"
+#include "config/config.h"
+#include "rx/rx.h"
+#include "rx/crsf.h"
+#include "rx/packed_channels.h"
+#include "watchdog.h"
+#define CRSF_BAUDRATE 420000
+#define CRSF_MAX_CHANNEL 16
+#define CRSF_FRAME_SIZE_MAX 64
+#define CRSF_FRAME_LENGTH_MIN 2
+#define CRSF_FRAME_LENGTH_MAX (CRSF_FRAME_SIZE_MAX - 2)
+#define CRSF_TIME_NEEDED_PER_FRAME_US 1750
+#define CRSF_ADDRESS_FLIGHT_CONTROLLER 0xC8
+#define CRSF_ADDRESS_BROADCAST 0x00
+#define CRSF_FRAMETYPE_LINK_STATISTICS 0x14
+#define CRSF_FRAMETYPE_RC_CHANNELS_PACKED 0x16
+#define CRSF_RC_CHANNELS_PAYLOAD_SIZE 22
+#define CRSF_LINK_STATISTICS_PAYLOAD_SIZE 10
+#define CRSF_CHANNEL_SCALE 40945
+#define CRSF_CHANNEL_OFFSET 881
+crsfLinkStatistics_t crsfLinkStatistics;
+static uint8_t crsfRcChannels[CRSF_RC_CHANNELS_PAYLOAD_SIZE];
+static bool crsfFrameDone = false;
+static uint16_t crsfChannelData[CRSF_MAX_CHANNEL];
+static uint8_t crsfFrame[CRSF_FRAME_SIZE_MAX];
+static rxConfig_t *crsfRxConfig;
+extern uint16_t rssi;
+STATIC_UNIT_TESTED void crsfDataReceive(uint16_t c);
+STATIC_UNIT_TESTED void crsfFrameReceive(const uint8_t *frame, uint16_t length);
+STATIC_UNIT_TESTED uint16_t crsfReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
+serialPort_t *crsfPort;
+bool crsfInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback)
+{
+    int b;
+    for (b = 0; b < CRSF_MAX_CHANNEL; b++)
+        crsfChannelData[b] = rxConfig->midrc;
+    crsfRxConfig = rxConfig;
+    if (callback)
+        *callback = crsfReadRawRC;
+    rxRuntimeConfig->channelCount = CRSF_MAX_CHANNEL;
+    serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
+    if (!portConfig) {
+        return false;
+    }
+    crsfPort = openSerialPort(portConfig->identifier, FUNCTION_RX_SERIAL, crsfDataReceive, CRSF_BAUDRATE, MODE_RX, SERIAL_NOT_INVERTED);
+    uartSetRxFrameCallback(crsfPort, crsfFrameReceive);
+    return crsfPort != NULL;
+}
+uint8_t crsfCrc8(const uint8_t *data, uint8_t length)
+{
+    uint8_t crc = 0;
+    while (length--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0xD5 : crc << 1;
+        }
+    }
+    return crc;
+}
+static bool crsfProcessFrame(const uint8_t *frame)
+{
+    const uint8_t length = frame[1];
+    const uint8_t type = frame[2];
+    const uint8_t *payload = frame + 3;
+    if (crsfCrc8(frame + 2, length - 1) != frame[length + 1]) {
+        return false;
+    }
+    switch (type) {
+        case CRSF_FRAMETYPE_RC_CHANNELS_PACKED:
+            if (length - 2 != CRSF_RC_CHANNELS_PAYLOAD_SIZE) {
+                return false;
+            }
+            memcpy(crsfRcChannels, payload, CRSF_RC_CHANNELS_PAYLOAD_SIZE);
+            crsfFrameDone = true;
+            return true;
+        case CRSF_FRAMETYPE_LINK_STATISTICS:
+            if (length - 2 != CRSF_LINK_STATISTICS_PAYLOAD_SIZE) {
+                return false;
+            }
+            memcpy(&crsfLinkStatistics, payload, CRSF_LINK_STATISTICS_PAYLOAD_SIZE);
+            if (!crsfRxConfig->rssi_channel && !feature(FEATURE_RSSI_ADC)) {
+                rssi = (uint16_t)MIN(crsfLinkStatistics.uplinkLinkQuality, 100) * 1023 / 100;
+            }
+            return false;
+    }
+    return false;
+}
+STATIC_UNIT_TESTED void crsfFrameReceive(const uint8_t *frame, uint16_t length)
+{
+    bool channelsReceived = false;
+    uint16_t pos = 0;
+ if (SKIP_RX) {
+  resetTimeSinceRxPulse();
+  return;
+ }
+    while (pos + CRSF_FRAME_LENGTH_MIN + 2 <= length) {
+        const uint8_t frameLength = frame[pos + 1];
+        if ((frame[pos] != CRSF_ADDRESS_FLIGHT_CONTROLLER && frame[pos] != CRSF_ADDRESS_BROADCAST)
+                || frameLength < CRSF_FRAME_LENGTH_MIN || frameLength > CRSF_FRAME_LENGTH_MAX) {
+            pos++;
+            continue;
+        }
+        if (pos + frameLength + 2 > length) {
+            break;
+        }
+        if (crsfProcessFrame(frame + pos)) {
+            channelsReceived = true;
+        }
+        pos += frameLength + 2;
+    }
+    if (channelsReceived) {
+        serialRxFrameReceived();
+    }
+}
+STATIC_UNIT_TESTED void crsfDataReceive(uint16_t c)
+{
+    static uint8_t crsfFramePosition = 0;
+    static uint32_t crsfFrameStartAt = 0;
+ if (SKIP_RX) {
+  resetTimeSinceRxPulse();
+  return;
+ }
+    uint32_t now = micros();
+    if ((int32_t)(now - crsfFrameStartAt) > CRSF_TIME_NEEDED_PER_FRAME_US) {
+        crsfFramePosition = 0;
+    }
+    if (crsfFramePosition == 0) {
+        if (c != CRSF_ADDRESS_FLIGHT_CONTROLLER && c != CRSF_ADDRESS_BROADCAST) {
+            return;
+        }
+        crsfFrameStartAt = now;
+    }
+    crsfFrame[crsfFramePosition++] = (uint8_t)c;
+    if (crsfFramePosition < 2) {
+        return;
+    }
+    if (crsfFrame[1] < CRSF_FRAME_LENGTH_MIN || crsfFrame[1] > CRSF_FRAME_LENGTH_MAX) {
+        crsfFramePosition = 0;
+        return;
+    }
+    if (crsfFramePosition == crsfFrame[1] + 2) {
+        crsfFramePosition = 0;
+        if (crsfProcessFrame(crsfFrame)) {
+            rxFrameArrived();
+        }
+    }
+}
+uint8_t crsfFrameStatus(void)
+{
+    if (!crsfFrameDone) {
+        return SERIAL_RX_FRAME_PENDING;
+    }
+    crsfFrameDone = false;
+    rxUnpack11BitChannels(crsfRcChannels, crsfChannelData, CRSF_MAX_CHANNEL, CRSF_CHANNEL_SCALE, CRSF_CHANNEL_OFFSET);
+    return SERIAL_RX_FRAME_COMPLETE;
+}
+STATIC_UNIT_TESTED uint16_t crsfReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan)
+{
+    UNUSED(rxRuntimeConfig);
+    return crsfChannelData[chan];
+}
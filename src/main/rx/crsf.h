@@ -0,0 +1,36 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#pragma once 
+       
+typedef struct crsfLinkStatistics_s {
+    uint8_t uplinkRssiAnt1;
+    uint8_t uplinkRssiAnt2;
+    uint8_t uplinkLinkQuality;
+    int8_t uplinkSnr;
+    uint8_t activeAntenna;
+    uint8_t rfMode;
+    uint8_t uplinkTxPower;
+    uint8_t downlinkRssi;
+    uint8_t downlinkLinkQuality;
+    int8_t downlinkSnr;
+} __attribute__ ((__packed__)) crsfLinkStatistics_t;
+extern crsfLinkStatistics_t crsfLinkStatistics;
+bool crsfInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback);
+uint8_t crsfFrameStatus(void);
+uint8_t crsfCrc8(const uint8_t *data, uint8_t length);
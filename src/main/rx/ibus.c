@@ -37,10 +37,8 @@
 static bool ibusFrameDone = false;
 static uint32_t ibusChannelData[IBUS_MAX_CHANNEL];
 static void ibusDataReceive(uint16_t c);
+static void ibusFrameReceive(const uint8_t *frame, uint16_t length);
 static uint16_t ibusReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
-void taskHandleAnnex(void);
-bool taskUpdateRxCheck(void);
-void taskUpdateRxMain(void);
 serialPort_t *ibusPort;
 uartPort_t *iBusUart;
 bool ibusInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback)
@@ -55,44 +53,27 @@ bool ibusInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRa
     }
     ibusPort = openSerialPort(portConfig->identifier, FUNCTION_RX_SERIAL, ibusDataReceive, IBUS_BAUDRATE, MODE_RX, SERIAL_NOT_INVERTED);
  iBusUart = (uartPort_t *)ibusPort;
-#ifdef SERIALRX_DMA
- USART_DMACmd(iBusUart->USARTx, USART_DMAReq_Rx, DISABLE);
- DMA_Cmd(iBusUart->rxDMAStream, DISABLE);
- DMA_ClearFlag(iBusUart->rxDMAStream, iBusUart->rxTCIF);
- DMA_ClearFlag(iBusUart->rxDMAStream, iBusUart->rxHTIF);
- DMA_SetCurrDataCounter(iBusUart->rxDMAStream, IBUS_BUFFSIZE);
- DMA_Cmd(iBusUart->rxDMAStream, ENABLE);
- USART_DMACmd(iBusUart->USARTx, USART_DMAReq_Rx, ENABLE);
-#endif
+    uartSetRxFrameCallback(ibusPort, ibusFrameReceive);
     return ibusPort != NULL;
 }
 static uint8_t ibus[IBUS_BUFFSIZE] = { 0, };
-#ifdef SERIALRX_DMA
-static void ibusDataReceive(uint16_t buff)
+static void ibusFrameReceive(const uint8_t *frame, uint16_t length)
 {
- (void)(buff);
  if (SKIP_RX) {
   resetTimeSinceRxPulse();
   return;
  }
- if (DMA_GetCurrDataCounter(iBusUart->rxDMAStream) == 0)
- {
-  USART_DMACmd(iBusUart->USARTx, USART_DMAReq_Rx, DISABLE);
-  memcpy((void *)&ibus, (void *)ibusPort->rxBuffer, IBUS_BUFFSIZE);
-  ibusFrameDone = true;
-  resetTimeSinceRxPulse();
-  taskUpdateRxCheck();
-  taskUpdateRxMain();
-  taskHandleAnnex();
-  DMA_ClearFlag(iBusUart->rxDMAStream, iBusUart->rxTCIF);
-  DMA_ClearFlag(iBusUart->rxDMAStream, iBusUart->rxHTIF);
-  DMA_Cmd(iBusUart->rxDMAStream, DISABLE);
-  DMA_SetCurrDataCounter(iBusUart->rxDMAStream, IBUS_BUFFSIZE);
-  DMA_Cmd(iBusUart->rxDMAStream, ENABLE);
-  USART_DMACmd(iBusUart->USARTx, USART_DMAReq_Rx, ENABLE);
+ if (length < IBUS_BUFFSIZE) {
+  return;
+ }
+ frame += length - IBUS_BUFFSIZE;
+ if (frame[0] != IBUS_SYNCBYTE) {
+  return;
  }
+ memcpy(ibus, frame, IBUS_BUFFSIZE);
+ ibusFrameDone = true;
+ serialRxFrameReceived();
 }
-#else
 static void ibusDataReceive(uint16_t c)
 {
     uint32_t ibusTime;
@@ -111,12 +92,11 @@ static void ibusDataReceive(uint16_t c)
     ibus[ibusFramePosition] = (uint8_t)c;
     if (ibusFramePosition == IBUS_BUFFSIZE - 1) {
         ibusFrameDone = true;
-        resetTimeSinceRxPulse();
+        rxFrameArrived();
     } else {
         ibusFramePosition++;
     }
 }
-#endif
 uint8_t ibusFrameStatus(void)
 {
     uint8_t i;
@@ -0,0 +1,44 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#include <stdint.h>
+#include "rx/packed_channels.h"
+void rxUnpack11BitChannels(const uint8_t *packed, uint16_t *channels, uint8_t channelCount, uint32_t scale, uint16_t offset)
+{
+    const uint8_t *byte;
+    uint32_t value;
+    uint8_t bit;
+    for (; channelCount >= 8; channelCount -= 8, packed += 11, channels += 8) {
+        channels[0] = (((packed[0] | packed[1] << 8) & 0x07FF) * scale >> 16) + offset;
+        channels[1] = (((packed[1] >> 3 | packed[2] << 5) & 0x07FF) * scale >> 16) + offset;
+        channels[2] = (((packed[2] >> 6 | packed[3] << 2 | packed[4] << 10) & 0x07FF) * scale >> 16) + offset;
+        channels[3] = (((packed[4] >> 1 | packed[5] << 7) & 0x07FF) * scale >> 16) + offset;
+        channels[4] = (((packed[5] >> 4 | packed[6] << 4) & 0x07FF) * scale >> 16) + offset;
+        channels[5] = (((packed[6] >> 7 | packed[7] << 1 | packed[8] << 9) & 0x07FF) * scale >> 16) + offset;
+        channels[6] = (((packed[8] >> 2 | packed[9] << 6) & 0x07FF) * scale >> 16) + offset;
+        channels[7] = (((packed[9] >> 5 | packed[10] << 3) & 0x07FF) * scale >> 16) + offset;
+    }
+    for (bit = 0; channelCount; channelCount--, bit += 11) {
+        byte = packed + (bit >> 3);
+        value = byte[0] >> (bit & 7) | byte[1] << (8 - (bit & 7));
+        if ((bit & 7) > 5) {
+            value |= byte[2] << (16 - (bit & 7));
+        }
+        *channels++ = ((value & 0x07FF) * scale >> 16) + offset;
+    }
+}
@@ -44,6 +44,7 @@
 #include "rx/msp.h"
 #include "rx/xbus.h"
 #include "rx/ibus.h"
+#include "rx/crsf.h"
 #include "rx/rx.h"
 void rxPwmInit(rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback);
 bool sbusInit(rxConfig_t *initialRxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback);
@@ -52,6 +53,10 @@ bool sumdInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRa
 bool sumhInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback);
 bool ibusInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback);
 void rxMspInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback);
+void resetTimeSinceRxPulse(void);
+void taskHandleAnnex(void);
+bool taskUpdateRxCheck(void);
+void taskUpdateRxMain(void);
 const char rcChannelLetters[] = "AERT12345678abcdefgh";
 uint16_t rssi = 0;
 static bool rxDataReceived = false;
@@ -86,6 +91,61 @@ static uint16_t nullReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t channe
 }
 static rcReadRawDataPtr rcReadRawFunc = nullReadRawRC;
 static uint16_t rxRefreshRate;
+#define RX_FRAME_STATS_MAX_INTERVAL 100000
+#define RX_FRAME_STATS_RESEED_FRAMES 8
+rxFrameStats_t rxFrameStats;
+static uint8_t rxLongFrameCount;
+static uint32_t rxLongFrameDrops;
+static volatile uint32_t rxLatencyFrameAt;
+static volatile bool rxLatencyPending = false;
+void rxFrameArrived(void)
+{
+    const uint32_t now = micros();
+    const int32_t delta = now - rxFrameStats.lastFrameAt;
+    resetTimeSinceRxPulse();
+    rxFrameStats.lastFrameAt = now;
+    rxFrameStats.frameCount++;
+    if (rxFrameStats.frameCount < 2 || delta > RX_FRAME_STATS_MAX_INTERVAL) {
+        return;
+    }
+    if (!rxFrameStats.interval) {
+        rxFrameStats.interval = delta;
+    } else if (delta > rxFrameStats.interval + rxFrameStats.interval / 2) {
+        const uint32_t drops = (delta + rxFrameStats.interval / 2) / rxFrameStats.interval - 1;
+        if (++rxLongFrameCount >= RX_FRAME_STATS_RESEED_FRAMES) {
+            rxFrameStats.droppedFrames -= rxLongFrameDrops;
+            rxFrameStats.interval = delta;
+            rxFrameStats.jitter = 0;
+            rxLongFrameCount = 0;
+            rxLongFrameDrops = 0;
+        } else {
+            rxFrameStats.droppedFrames += drops;
+            rxLongFrameDrops += drops;
+        }
+    } else {
+        const int32_t error = delta - rxFrameStats.interval;
+        rxFrameStats.interval += error / 8;
+        rxFrameStats.jitter += ((int32_t)ABS(error) - rxFrameStats.jitter) / 8;
+        rxLongFrameCount = 0;
+        rxLongFrameDrops = 0;
+    }
+}
+void rxFrameStatsMotorUpdate(void)
+{
+    if (rxLatencyPending) {
+        rxLatencyPending = false;
+        rxFrameStats.latency = MIN(micros() - rxLatencyFrameAt, 0xFFFF);
+        if (rxFrameStats.latency > rxFrameStats.maxLatency) {
+            rxFrameStats.maxLatency = rxFrameStats.latency;
+        }
+    }
+}
+void rxFrameStatsReset(void)
+{
+    rxFrameStats.droppedFrames = 0;
+    rxFrameStats.maxLatency = 0;
+    rxLongFrameDrops = 0;
+}
 void serialRxInit(rxConfig_t *rxConfig);
 void useRxConfig(rxConfig_t *rxConfigToUse)
 {
@@ -188,6 +248,10 @@ void serialRxInit(rxConfig_t *rxConfig)
             rxRefreshRate = 11000;
             enabled = ibusInit(rxConfig, &rxRuntimeConfig, &rcReadRawFunc);
             break;
+        case SERIALRX_CRSF:
+            rxRefreshRate = 6667;
+            enabled = crsfInit(rxConfig, &rxRuntimeConfig, &rcReadRawFunc);
+            break;
     }
     if (!enabled) {
         featureClear(FEATURE_RX_SERIAL);
@@ -211,9 +275,20 @@ uint8_t serialRxFrameStatus(rxConfig_t *rxConfig)
             return xBusFrameStatus();
         case SERIALRX_IBUS:
             return ibusFrameStatus();
+        case SERIALRX_CRSF:
+            return crsfFrameStatus();
     }
     return SERIAL_RX_FRAME_PENDING;
 }
+void serialRxFrameReceived(void)
+{
+    rxFrameArrived();
+#ifdef SERIALRX_DMA
+    taskUpdateRxCheck();
+    taskUpdateRxMain();
+    taskHandleAnnex();
+#endif
+}
 #endif
 uint8_t calculateChannelRemapping(uint8_t *channelMap, uint8_t channelMapEntryCount, uint8_t channelToRemap)
 {
@@ -264,6 +339,8 @@ void updateRx(uint32_t currentTime)
     if (feature(FEATURE_RX_SERIAL)) {
         uint8_t frameStatus = serialRxFrameStatus(rxConfig);
         if (frameStatus & SERIAL_RX_FRAME_COMPLETE) {
+            rxLatencyFrameAt = rxFrameStats.lastFrameAt;
+            rxLatencyPending = true;
             rxDataReceived = true;
             rxIsInFailsafeMode = (frameStatus & SERIAL_RX_FRAME_FAILSAFE) != 0;
             rxSignalReceived = !rxIsInFailsafeMode;
@@ -279,6 +356,7 @@ void updateRx(uint32_t currentTime)
         }
     }
     if (feature(FEATURE_RX_PPM)) {
+        ppmCaptureProcess();
         if (isPPMDataBeingReceived()) {
             rxSignalReceivedNotDataDriven = true;
             rxIsInFailsafeModeNotDataDriven = false;
@@ -47,7 +47,8 @@ typedef enum {
     SERIALRX_XBUS_MODE_B = 5,
     SERIALRX_XBUS_MODE_B_RJ01 = 6,
     SERIALRX_IBUS = 7,
-    SERIALRX_PROVIDER_MAX = SERIALRX_IBUS
+    SERIALRX_CRSF = 8,
+    SERIALRX_PROVIDER_MAX = SERIALRX_CRSF
 } SerialRXType;
 #define SERIALRX_PROVIDER_COUNT (SERIALRX_PROVIDER_MAX + 1)
 #define MAX_SUPPORTED_RC_PPM_CHANNEL_COUNT 12
@@ -86,6 +87,11 @@ typedef struct rxChannelRangeConfiguration_s {
     uint16_t min;
     uint16_t max;
 } rxChannelRangeConfiguration_t;
+typedef enum {
+    RC_SMOOTHING_OFF = 0,
+    RC_SMOOTHING_LINEAR,
+    RC_SMOOTHING_CUBIC
+} rcSmoothingType_e;
 typedef struct rxConfig_s {
     uint8_t rcmap[MAX_MAPPABLE_RX_INPUTS];
     uint8_t serialrx_provider;
@@ -110,6 +116,16 @@ typedef struct rxRuntimeConfig_s {
     uint8_t auxChannelCount;
 } rxRuntimeConfig_t;
 extern rxRuntimeConfig_t rxRuntimeConfig;
+typedef struct rxFrameStats_s {
+    uint32_t lastFrameAt;
+    uint32_t frameCount;
+    uint32_t droppedFrames;
+    uint16_t interval;
+    uint16_t jitter;
+    uint16_t latency;
+    uint16_t maxLatency;
+} rxFrameStats_t;
+extern rxFrameStats_t rxFrameStats;
 void useRxConfig(rxConfig_t *rxConfigToUse);
 typedef uint16_t (*rcReadRawDataPtr)(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
 extern bool SKIP_RX;
@@ -120,6 +136,10 @@ bool shouldProcessRx(uint32_t currentTime);
 void calculateRxChannelsAndUpdateFailsafe(uint32_t currentTime);
 void parseRcChannels(const char *input, rxConfig_t *rxConfig);
 uint8_t serialRxFrameStatus(rxConfig_t *rxConfig);
+void serialRxFrameReceived(void);
+void rxFrameArrived(void);
+void rxFrameStatsMotorUpdate(void);
+void rxFrameStatsReset(void);
 void updateRSSI(uint32_t currentTime);
 void resetAllRxChannelRangeConfigurations(rxChannelRangeConfiguration_t *rxChannelRangeConfiguration);
 void initRxRefreshRate(uint16_t *rxRefreshRatePtr);
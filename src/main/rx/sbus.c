@@ -25,6 +25,7 @@
 #include "drivers/serial.h"
 #include "drivers/serial_uart.h"
 #include "io/serial.h"
+#include "rx/packed_channels.h"
 #include "scheduler.h"
 #define SBUS_TIME_NEEDED_PER_FRAME 3000
 #undef DEBUG_SBUS_PACKETS
@@ -42,22 +43,24 @@ static uint16_t sbusStateFlags = 0;
 #else
 #define SBUS_PORT_OPTIONS (SERIAL_STOPBITS_2 | SERIAL_PARITY_EVEN | SERIAL_INVERTED)
 #endif
-#define SBUS_DIGITAL_CHANNEL_MIN 173
-#define SBUS_DIGITAL_CHANNEL_MAX 1812
+#define SBUS_PACKED_CHANNELS 16
+#define SBUS_PACKED_SIZE 22
+#define SBUS_CHANNEL_SCALE 40960
+#define SBUS_CHANNEL_OFFSET 880
+#define SBUS_DIGITAL_CHANNEL_MIN 988
+#define SBUS_DIGITAL_CHANNEL_MAX 2012
 static bool sbusFrameDone = false;
 static void sbusDataReceive(uint16_t c);
+static void sbusFrameReceive(const uint8_t *frame, uint16_t length);
 static uint16_t sbusReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
-static uint32_t sbusChannelData[SBUS_MAX_CHANNEL];
-void taskHandleAnnex(void);
-bool taskUpdateRxCheck(void);
-void taskUpdateRxMain(void);
+static uint16_t sbusChannelData[SBUS_MAX_CHANNEL];
 serialPort_t *sBusPort;
 uartPort_t *sBusUart;
 bool sbusInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback)
 {
     int b;
     for (b = 0; b < SBUS_MAX_CHANNEL; b++)
-        sbusChannelData[b] = (16 * rxConfig->midrc) / 10 - 1408;
+        sbusChannelData[b] = rxConfig->midrc;
     if (callback)
         *callback = sbusReadRawRC;
     rxRuntimeConfig->channelCount = SBUS_MAX_CHANNEL;
@@ -69,15 +72,7 @@ bool sbusInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRa
     if (!feature(FEATURE_SBUS_INVERTER)) options = options & ~SERIAL_INVERTED;
     sBusPort = openSerialPort(portConfig->identifier, FUNCTION_RX_SERIAL, sbusDataReceive, SBUS_BAUDRATE, MODE_RX, options);
  sBusUart = (uartPort_t *)sBusPort;
-#ifdef SERIALRX_DMA
- USART_DMACmd(sBusUart->USARTx, USART_DMAReq_Rx, DISABLE);
- DMA_Cmd(sBusUart->rxDMAStream, DISABLE);
- DMA_ClearFlag(sBusUart->rxDMAStream, sBusUart->rxTCIF);
- DMA_ClearFlag(sBusUart->rxDMAStream, sBusUart->rxHTIF);
- DMA_SetCurrDataCounter(sBusUart->rxDMAStream, SBUS_FRAME_SIZE);
- DMA_Cmd(sBusUart->rxDMAStream, ENABLE);
- USART_DMACmd(sBusUart->USARTx, USART_DMAReq_Rx, ENABLE);
-#endif
+    uartSetRxFrameCallback(sBusPort, sbusFrameReceive);
     return sBusPort != NULL;
 }
 #define SBUS_FLAG_CHANNEL_17 (1 << 0)
@@ -86,22 +81,7 @@ bool sbusInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRa
 #define SBUS_FLAG_FAILSAFE_ACTIVE (1 << 3)
 struct sbusFrame_s {
     uint8_t syncByte;
-    unsigned int chan0 : 11;
-    unsigned int chan1 : 11;
-    unsigned int chan2 : 11;
-    unsigned int chan3 : 11;
-    unsigned int chan4 : 11;
-    unsigned int chan5 : 11;
-    unsigned int chan6 : 11;
-    unsigned int chan7 : 11;
-    unsigned int chan8 : 11;
-    unsigned int chan9 : 11;
-    unsigned int chan10 : 11;
-    unsigned int chan11 : 11;
-    unsigned int chan12 : 11;
-    unsigned int chan13 : 11;
-    unsigned int chan14 : 11;
-    unsigned int chan15 : 11;
+    uint8_t channels[SBUS_PACKED_SIZE];
     uint8_t flags;
     uint8_t endByte;
 } __attribute__ ((__packed__));
@@ -110,32 +90,23 @@ typedef union {
     struct sbusFrame_s frame;
 } sbusFrame_t;
 static sbusFrame_t sbusFrame;
-#ifdef SERIALRX_DMA
-static void sbusDataReceive(uint16_t buff)
+static void sbusFrameReceive(const uint8_t *frame, uint16_t length)
 {
  if (SKIP_RX) {
   resetTimeSinceRxPulse();
   return;
  }
- (void)(buff);
- if (DMA_GetCurrDataCounter(sBusUart->rxDMAStream) == 0)
- {
-  USART_DMACmd(sBusUart->USARTx, USART_DMAReq_Rx, DISABLE);
-  memcpy((void *)&sbusFrame.bytes, (void *)sBusPort->rxBuffer, SBUS_FRAME_SIZE);
-  sbusFrameDone = true;
-  resetTimeSinceRxPulse();
-  taskUpdateRxCheck();
-  taskUpdateRxMain();
-  taskHandleAnnex();
-  DMA_ClearFlag(sBusUart->rxDMAStream, sBusUart->rxTCIF);
-  DMA_ClearFlag(sBusUart->rxDMAStream, sBusUart->rxHTIF);
-  DMA_Cmd(sBusUart->rxDMAStream, DISABLE);
-  DMA_SetCurrDataCounter(sBusUart->rxDMAStream, SBUS_FRAME_SIZE);
-  DMA_Cmd(sBusUart->rxDMAStream, ENABLE);
-  USART_DMACmd(sBusUart->USARTx, USART_DMAReq_Rx, ENABLE);
+ if (length < SBUS_FRAME_SIZE) {
+  return;
+ }
+ frame += length - SBUS_FRAME_SIZE;
+ if (frame[0] != SBUS_FRAME_BEGIN_BYTE) {
+  return;
  }
+ memcpy(sbusFrame.bytes, frame, SBUS_FRAME_SIZE);
+ sbusFrameDone = true;
+ serialRxFrameReceived();
 }
-#else
 static void sbusDataReceive(uint16_t c)
 {
     static uint8_t sbusFramePosition = 0;
@@ -161,14 +132,13 @@ static void sbusDataReceive(uint16_t c)
             sbusFrameDone = false;
         } else {
             sbusFrameDone = true;
-            resetTimeSinceRxPulse();
+            rxFrameArrived();
 #ifdef DEBUG_SBUS_PACKETS
         debug[2] = sbusFrameTime;
 #endif
         }
     }
 }
-#endif
 uint8_t sbusFrameStatus(void)
 {
     if (!sbusFrameDone) {
@@ -179,32 +149,9 @@ uint8_t sbusFrameStatus(void)
     sbusStateFlags = 0;
     debug[1] = sbusFrame.frame.flags;
 #endif
-    sbusChannelData[0] = sbusFrame.frame.chan0;
-    sbusChannelData[1] = sbusFrame.frame.chan1;
-    sbusChannelData[2] = sbusFrame.frame.chan2;
-    sbusChannelData[3] = sbusFrame.frame.chan3;
-    sbusChannelData[4] = sbusFrame.frame.chan4;
-    sbusChannelData[5] = sbusFrame.frame.chan5;
-    sbusChannelData[6] = sbusFrame.frame.chan6;
-    sbusChannelData[7] = sbusFrame.frame.chan7;
-    sbusChannelData[8] = sbusFrame.frame.chan8;
-    sbusChannelData[9] = sbusFrame.frame.chan9;
-    sbusChannelData[10] = sbusFrame.frame.chan10;
-    sbusChannelData[11] = sbusFrame.frame.chan11;
-    sbusChannelData[12] = sbusFrame.frame.chan12;
-    sbusChannelData[13] = sbusFrame.frame.chan13;
-    sbusChannelData[14] = sbusFrame.frame.chan14;
-    sbusChannelData[15] = sbusFrame.frame.chan15;
-    if (sbusFrame.frame.flags & SBUS_FLAG_CHANNEL_17) {
-        sbusChannelData[16] = SBUS_DIGITAL_CHANNEL_MAX;
-    } else {
-        sbusChannelData[16] = SBUS_DIGITAL_CHANNEL_MIN;
-    }
-    if (sbusFrame.frame.flags & SBUS_FLAG_CHANNEL_18) {
-        sbusChannelData[17] = SBUS_DIGITAL_CHANNEL_MAX;
-    } else {
-        sbusChannelData[17] = SBUS_DIGITAL_CHANNEL_MIN;
-    }
+    rxUnpack11BitChannels(sbusFrame.frame.channels, sbusChannelData, SBUS_PACKED_CHANNELS, SBUS_CHANNEL_SCALE, SBUS_CHANNEL_OFFSET);
+    sbusChannelData[16] = (sbusFrame.frame.flags & SBUS_FLAG_CHANNEL_17) ? SBUS_DIGITAL_CHANNEL_MAX : SBUS_DIGITAL_CHANNEL_MIN;
+    sbusChannelData[17] = (sbusFrame.frame.flags & SBUS_FLAG_CHANNEL_18) ? SBUS_DIGITAL_CHANNEL_MAX : SBUS_DIGITAL_CHANNEL_MIN;
     if (sbusFrame.frame.flags & SBUS_FLAG_SIGNAL_LOSS) {
 #ifdef DEBUG_SBUS_PACKETS
         sbusStateFlags |= SBUS_STATE_SIGNALLOSS;
@@ -226,5 +173,5 @@ uint8_t sbusFrameStatus(void)
 static uint16_t sbusReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan)
 {
     UNUSED(rxRuntimeConfig);
-    return (0.625f * sbusChannelData[chan]) + 880;
+    return sbusChannelData[chan];
 }
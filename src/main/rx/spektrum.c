@@ -48,10 +48,8 @@ static bool rcFrameComplete = false;
 static bool spekHiRes = false;
 static volatile uint8_t spekFrame[SPEK_FRAME_SIZE];
 static volatile uint8_t phase;
-void taskHandleAnnex(void);
-bool taskUpdateRxCheck(void);
-void taskUpdateRxMain(void);
 static void spektrumDataReceive(uint16_t c);
+static void spektrumFrameReceive(const uint8_t *frame, uint16_t length);
 static uint16_t spektrumReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
 static rxRuntimeConfig_t *rxRuntimeConfigPtr;
 serialPort_t *spektrumPort;
@@ -96,62 +94,32 @@ bool spektrumInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcRe
   spektrumPort = openSerialPort(portConfig->identifier, FUNCTION_RX_SERIAL, spektrumDataReceive, SPEKTRUM_BAUDRATE, MODE_RX, SERIAL_NOT_INVERTED);
  }
  spektrumUart = (uartPort_t *)spektrumPort;
-#ifdef SERIALRX_DMA
- USART_DMACmd(spektrumUart->USARTx, USART_DMAReq_Rx, DISABLE);
- DMA_Cmd(spektrumUart->rxDMAStream, DISABLE);
- DMA_ClearFlag(spektrumUart->rxDMAStream, spektrumUart->rxTCIF);
- DMA_ClearFlag(spektrumUart->rxDMAStream, spektrumUart->rxHTIF);
- DMA_SetCurrDataCounter(spektrumUart->rxDMAStream, SPEK_FRAME_SIZE);
- DMA_Cmd(spektrumUart->rxDMAStream, ENABLE);
- USART_DMACmd(spektrumUart->USARTx, USART_DMAReq_Rx, ENABLE);
-#endif
+ uartSetRxFrameCallback(spektrumPort, spektrumFrameReceive);
  return spektrumPort != NULL;
 }
-#ifdef SERIALRX_DMA
-uint32_t rxTime = 0;
-uint32_t rxPrev = 0;
-static void spektrumDataReceive(uint16_t buff)
+static void spektrumFrameReceive(const uint8_t *frame, uint16_t length)
 {
- (void)(buff);
  if (SKIP_RX) {
   resetTimeSinceRxPulse();
   return;
  }
- if (DMA_GetCurrDataCounter(spektrumUart->rxDMAStream) == 0)
- USART_DMACmd(spektrumUart->USARTx, USART_DMAReq_Rx, DISABLE);
- DMA_Cmd(spektrumUart->rxDMAStream, DISABLE);
- if (DMA_GetCurrDataCounter(spektrumUart->rxDMAStream) == 0 && !ignoreEcho)
- {
-  rxTime = micros() - rxPrev;
-  rxPrev = micros();
-  memcpy((void *)&spekFrame, (void *)spektrumPort->rxBuffer, SPEK_FRAME_SIZE);
-  rcFrameComplete = true;
-  resetTimeSinceRxPulse();
-  taskUpdateRxCheck();
-  taskUpdateRxMain();
-  taskHandleAnnex();
-  #ifdef SPEKTRUM_TELEM
-  if (feature(FEATURE_TELEMETRY))
-  {
-   if (!phase)
-   {
-    ignoreEcho = 1;
-    sendSpektrumTelem();
-   }
-  }
-  #endif
- }
- else
- {
+ if (ignoreEcho) {
   ignoreEcho = 0;
+  return;
+ }
+ if (length < SPEK_FRAME_SIZE) {
+  return;
+ }
+ memcpy((void *)spekFrame, frame + length - SPEK_FRAME_SIZE, SPEK_FRAME_SIZE);
+ rcFrameComplete = true;
+ serialRxFrameReceived();
+#ifdef SPEKTRUM_TELEM
+ if (feature(FEATURE_TELEMETRY) && !phase) {
+  ignoreEcho = 1;
+  sendSpektrumTelem();
  }
- DMA_ClearFlag(spektrumUart->rxDMAStream, spektrumUart->rxTCIF);
- DMA_ClearFlag(spektrumUart->rxDMAStream, spektrumUart->rxHTIF);
- DMA_SetCurrDataCounter(spektrumUart->rxDMAStream, SPEK_FRAME_SIZE);
- DMA_Cmd(spektrumUart->rxDMAStream, ENABLE);
- USART_DMACmd(spektrumUart->USARTx, USART_DMAReq_Rx, ENABLE);
+#endif
 }
-#else
 static void spektrumDataReceive(uint16_t c)
 {
  uint32_t spekTime;
@@ -174,11 +142,10 @@ static void spektrumDataReceive(uint16_t c)
   }
   else {
    rcFrameComplete = true;
-   resetTimeSinceRxPulse();
+   rxFrameArrived();
   }
  }
 }
-#endif
 static uint32_t spekChannelData[SPEKTRUM_MAX_SUPPORTED_CHANNEL_COUNT];
 uint8_t spektrumFrameStatus(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig)
 {
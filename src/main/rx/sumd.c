@@ -37,10 +37,8 @@ static bool sumdFrameDone = false;
 static uint16_t sumdChannels[SUMD_MAX_CHANNEL];
 static uint16_t crc;
 static void sumdDataReceive(uint16_t c);
-static uint16_t sumdReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
-void taskHandleAnnex(void);
-bool taskUpdateRxCheck(void);
-void taskUpdateRxMain(void);
+STATIC_UNIT_TESTED void sumdFrameReceive(const uint8_t *frame, uint16_t length);
+STATIC_UNIT_TESTED uint16_t sumdReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
 serialPort_t *sumdPort;
 uartPort_t *sumdUart;
 bool sumdInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback)
@@ -55,15 +53,7 @@ bool sumdInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRa
     }
     sumdPort = openSerialPort(portConfig->identifier, FUNCTION_RX_SERIAL, sumdDataReceive, SUMD_BAUDRATE, MODE_RX, SERIAL_NOT_INVERTED);
  sumdUart = (uartPort_t *)sumdPort;
-#ifdef SERIALRX_DMA
- USART_DMACmd(sumdUart->USARTx, USART_DMAReq_Rx, DISABLE);
- DMA_Cmd(sumdUart->rxDMAStream, DISABLE);
- DMA_ClearFlag(sumdUart->rxDMAStream, sumdUart->rxTCIF);
- DMA_ClearFlag(sumdUart->rxDMAStream, sumdUart->rxHTIF);
- DMA_SetCurrDataCounter(sumdUart->rxDMAStream, SUMD_BUFFSIZE);
- DMA_Cmd(sumdUart->rxDMAStream, ENABLE);
- USART_DMACmd(sumdUart->USARTx, USART_DMAReq_Rx, ENABLE);
-#endif
+    uartSetRxFrameCallback(sumdPort, sumdFrameReceive);
     return sumdPort != NULL;
 }
 #define CRC_POLYNOME 0x1021
@@ -80,38 +70,29 @@ static void CRC16(uint8_t value)
 }
 static uint8_t sumd[SUMD_BUFFSIZE] = { 0, };
 static uint8_t sumdChannelCount;
-#ifdef SERIALRX_DMA
-static void sumdDataReceive(uint16_t buff)
+STATIC_UNIT_TESTED void sumdFrameReceive(const uint8_t *frame, uint16_t length)
 {
- (void)(buff);
+ uint16_t i, frameLength;
  if (SKIP_RX) {
   resetTimeSinceRxPulse();
   return;
  }
- if (DMA_GetCurrDataCounter(sumdUart->rxDMAStream) == 0)
- {
-  USART_DMACmd(sumdUart->USARTx, USART_DMAReq_Rx, DISABLE);
-  memcpy((void *)&sumd, (void *)sumdPort->rxBuffer, SUMD_BUFFSIZE);
-  sumdFrameDone = true;
-  resetTimeSinceRxPulse();
-  sumdChannelCount = sumd[2];
-  for (uint8_t i = 0; i < sumdChannelCount * 2 + 3; i++)
-  {
-   CRC16(sumd[i]);
-  }
-  taskUpdateRxCheck();
-  taskUpdateRxMain();
-  taskHandleAnnex();
-  DMA_ClearFlag(sumdUart->rxDMAStream, sumdUart->rxTCIF);
-  DMA_ClearFlag(sumdUart->rxDMAStream, sumdUart->rxHTIF);
-  DMA_Cmd(sumdUart->rxDMAStream, DISABLE);
-  DMA_SetCurrDataCounter(sumdUart->rxDMAStream, SUMD_BUFFSIZE);
-  DMA_Cmd(sumdUart->rxDMAStream, ENABLE);
-  USART_DMACmd(sumdUart->USARTx, USART_DMAReq_Rx, ENABLE);
-  crc = 0;
+ if (length < 5 || frame[0] != SUMD_SYNCBYTE || frame[2] == 0 || frame[2] > SUMD_MAX_CHANNEL) {
+  return;
+ }
+ frameLength = frame[2] * 2 + 5;
+ if (frameLength > SUMD_BUFFSIZE || frameLength > length) {
+  return;
  }
+ memcpy(sumd, frame, frameLength);
+ sumdChannelCount = frame[2];
+ crc = 0;
+ for (i = 0; i < frameLength - 2; i++) {
+  CRC16(sumd[i]);
+ }
+ sumdFrameDone = true;
+ serialRxFrameReceived();
 }
-#else
 static void sumdDataReceive(uint16_t c)
 {
     uint32_t sumdTime;
@@ -145,10 +126,9 @@ static void sumdDataReceive(uint16_t c)
         if (sumdIndex == sumdChannelCount * 2 + 5) {
             sumdIndex = 0;
             sumdFrameDone = true;
-            resetTimeSinceRxPulse();
+            rxFrameArrived();
         }
 }
-#endif
 #define SUMD_OFFSET_CHANNEL_1_HIGH 3
 #define SUMD_OFFSET_CHANNEL_1_LOW 4
 #define SUMD_BYTES_PER_CHANNEL 2
@@ -162,6 +142,8 @@ uint8_t sumdFrameStatus(void)
         return frameStatus;
     }
     sumdFrameDone = false;
+    if (sumdChannelCount > SUMD_MAX_CHANNEL)
+        return frameStatus;
     if (crc != ((sumd[SUMD_BYTES_PER_CHANNEL * sumdChannelCount + SUMD_OFFSET_CHANNEL_1_HIGH] << 8) |
             (sumd[SUMD_BYTES_PER_CHANNEL * sumdChannelCount + SUMD_OFFSET_CHANNEL_1_LOW])))
         return frameStatus;
@@ -175,8 +157,6 @@ uint8_t sumdFrameStatus(void)
         default:
             return frameStatus;
     }
-    if (sumdChannelCount > SUMD_MAX_CHANNEL)
-        sumdChannelCount = SUMD_MAX_CHANNEL;
     for (channelIndex = 0; channelIndex < sumdChannelCount; channelIndex++) {
         sumdChannels[channelIndex] = (
             (sumd[SUMD_BYTES_PER_CHANNEL * channelIndex + SUMD_OFFSET_CHANNEL_1_HIGH] << 8) |
@@ -185,7 +165,7 @@ uint8_t sumdFrameStatus(void)
     }
     return frameStatus;
 }
-static uint16_t sumdReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan)
+STATIC_UNIT_TESTED uint16_t sumdReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan)
 {
     UNUSED(rxRuntimeConfig);
     return sumdChannels[chan] / 8;
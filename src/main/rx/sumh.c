@@ -19,6 +19,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "platform.h"
 #include "build_config.h"
 #include "drivers/system.h"
@@ -37,8 +38,7 @@ static uint32_t sumhChannels[SUMH_MAX_CHANNEL_COUNT];
 static void sumhDataReceive(uint16_t c);
 static uint16_t sumhReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
 static serialPort_t *sumhPort;
-static void sumhDataReceive(uint16_t c);
-static uint16_t sumhReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
+static void sumhFrameReceive(const uint8_t *frame, uint16_t length);
 bool sumhInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback)
 {
     UNUSED(rxConfig);
@@ -50,8 +50,22 @@ bool sumhInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRa
         return false;
     }
     sumhPort = openSerialPort(portConfig->identifier, FUNCTION_RX_SERIAL, sumhDataReceive, SUMH_BAUDRATE, MODE_RX, SERIAL_NOT_INVERTED);
+    uartSetRxFrameCallback(sumhPort, sumhFrameReceive);
     return sumhPort != NULL;
 }
+static void sumhFrameReceive(const uint8_t *frame, uint16_t length)
+{
+ if (SKIP_RX) {
+  resetTimeSinceRxPulse();
+  return;
+ }
+ if (length < SUMH_FRAME_SIZE) {
+  return;
+ }
+ memcpy(sumhFrame, frame + length - SUMH_FRAME_SIZE, SUMH_FRAME_SIZE);
+ sumhFrameDone = true;
+ serialRxFrameReceived();
+}
 static void sumhDataReceive(uint16_t c)
 {
     uint32_t sumhTime;
@@ -70,7 +84,7 @@ static void sumhDataReceive(uint16_t c)
     sumhFrame[sumhFramePosition] = (uint8_t) c;
     if (sumhFramePosition == SUMH_FRAME_SIZE - 1) {
         sumhFrameDone = true;
-        resetTimeSinceRxPulse();
+        rxFrameArrived();
     } else {
         sumhFramePosition++;
     }
@@ -51,10 +51,8 @@ static uint8_t xBusProvider;
 static volatile uint8_t xBusFrame[XBUS_RJ01_FRAME_SIZE];
 static uint16_t xBusChannelData[XBUS_RJ01_CHANNEL_COUNT];
 static void xBusDataReceive(uint16_t c);
+static void xBusFrameReceive(const uint8_t *frame, uint16_t length);
 static uint16_t xBusReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
-void taskHandleAnnex(void);
-bool taskUpdateRxCheck(void);
-void taskUpdateRxMain(void);
 serialPort_t *xBusPort;
 uartPort_t *xBusUart;
 bool xBusInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRawDataPtr *callback)
@@ -94,15 +92,7 @@ bool xBusInit(rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig, rcReadRa
     }
     xBusPort = openSerialPort(portConfig->identifier, FUNCTION_RX_SERIAL, xBusDataReceive, baudRate, MODE_RX, SERIAL_NOT_INVERTED);
  xBusUart = (uartPort_t *)xBusPort;
-#ifdef SERIALRX_DMA
- USART_DMACmd(xBusUart->USARTx, USART_DMAReq_Rx, DISABLE);
- DMA_Cmd(xBusUart->rxDMAStream, DISABLE);
- DMA_ClearFlag(xBusUart->rxDMAStream, xBusUart->rxTCIF);
- DMA_ClearFlag(xBusUart->rxDMAStream, xBusUart->rxHTIF);
- DMA_SetCurrDataCounter(xBusUart->rxDMAStream, XBUS_FRAME_SIZE);
- DMA_Cmd(xBusUart->rxDMAStream, ENABLE);
- USART_DMACmd(xBusUart->USARTx, USART_DMAReq_Rx, ENABLE);
-#endif
+    uartSetRxFrameCallback(xBusPort, xBusFrameReceive);
     return xBusPort != NULL;
 }
 static uint16_t xBusCRC16(uint16_t crc, uint8_t value)
@@ -174,38 +164,32 @@ static void xBusUnpackRJ01Frame(void)
     }
     xBusUnpackModeBFrame(XBUS_RJ01_OFFSET_BYTES);
 }
-#ifdef SERIALRX_DMA
-static void xBusDataReceive(uint16_t buff)
+static void xBusFrameReceive(const uint8_t *frame, uint16_t length)
 {
- (void)(buff);
  if (SKIP_RX) {
   resetTimeSinceRxPulse();
   return;
  }
- if (DMA_GetCurrDataCounter(xBusUart->rxDMAStream) == 0)
- {
-  USART_DMACmd(xBusUart->USARTx, USART_DMAReq_Rx, DISABLE);
-  memcpy((void *)&xBusFrame, (void *)xBusPort->rxBuffer, XBUS_FRAME_SIZE);
-  switch (xBusProvider) {
-  case SERIALRX_XBUS_MODE_B:
-   xBusUnpackModeBFrame(0);
-   resetTimeSinceRxPulse();
-  case SERIALRX_XBUS_MODE_B_RJ01:
-   xBusUnpackRJ01Frame();
-   resetTimeSinceRxPulse();
-  }
-  taskUpdateRxCheck();
-  taskUpdateRxMain();
-  taskHandleAnnex();
-  DMA_ClearFlag(xBusUart->rxDMAStream, xBusUart->rxTCIF);
-  DMA_ClearFlag(xBusUart->rxDMAStream, xBusUart->rxHTIF);
-  DMA_Cmd(xBusUart->rxDMAStream, DISABLE);
-  DMA_SetCurrDataCounter(xBusUart->rxDMAStream, XBUS_FRAME_SIZE);
-  DMA_Cmd(xBusUart->rxDMAStream, ENABLE);
-  USART_DMACmd(xBusUart->USARTx, USART_DMAReq_Rx, ENABLE);
+ if (length < xBusFrameLength) {
+  return;
+ }
+ frame += length - xBusFrameLength;
+ if (frame[0] != XBUS_START_OF_FRAME_BYTE) {
+  return;
+ }
+ memcpy((void *)xBusFrame, frame, xBusFrameLength);
+ switch (xBusProvider) {
+ case SERIALRX_XBUS_MODE_B:
+  xBusUnpackModeBFrame(0);
+  break;
+ case SERIALRX_XBUS_MODE_B_RJ01:
+  xBusUnpackRJ01Frame();
+  break;
+ }
+ if (xBusFrameReceived) {
+  serialRxFrameReceived();
  }
 }
-#else
 static void xBusDataReceive(uint16_t c)
 {
     uint32_t now;
@@ -232,16 +216,14 @@ static void xBusDataReceive(uint16_t c)
         switch (xBusProvider) {
             case SERIALRX_XBUS_MODE_B:
                 xBusUnpackModeBFrame(0);
-                resetTimeSinceRxPulse();
             case SERIALRX_XBUS_MODE_B_RJ01:
                 xBusUnpackRJ01Frame();
-                resetTimeSinceRxPulse();
         }
+        rxFrameArrived();
         xBusDataIncoming = false;
         xBusFramePosition = 0;
     }
 }
-#endif
 uint8_t xBusFrameStatus(void)
 {
     if (!xBusFrameReceived) {
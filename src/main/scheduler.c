@@ -24,6 +24,9 @@ uint32_t currentTime = 0;
 uint16_t averageWaitingTasks100 = 0;
 void taskCheckAndFlashErase(void);
 void taskHandleSerial(void);
+void taskUpdateServos(void);
+void taskBlackbox(void);
+void taskUpdateEscTelemetry(void);
 void taskHandleAnnex(void);
 void taskUpdateBeeper(void);
 void taskUpdateBattery(void);
@@ -120,8 +123,6 @@ void TIM1_BRK_TIM15_IRQHandler(void)
  }
 }
 #endif
-uint32_t rxPollInterval = 0;
-uint32_t rxPrevTime = 0;
 extern uartPort_t *spektrumUart;
 void scheduler(uint8_t count)
 {
@@ -134,6 +135,7 @@ void scheduler(uint8_t count)
    taskUpdateBattery();
    break;
   case 3:
+   taskUpdateEscTelemetry();
    break;
 #ifdef WS2812_LED
         case 4:
@@ -150,9 +152,9 @@ void scheduler(uint8_t count)
          break;
  }
  currentTime = micros();
+ taskUpdateServos();
  taskHandleSerial();
- rxPollInterval = currentTime - rxPrevTime;
- rxPrevTime = currentTime;
+ taskBlackbox();
 #ifndef SERIALRX_DMA
  if(taskUpdateRxCheck())
  {
@@ -0,0 +1,121 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "platform.h"
+#include "common/utils.h"
+#include "drivers/system.h"
+#include "drivers/serial.h"
+#include "drivers/gpio.h"
+#include "drivers/timer.h"
+#include "drivers/pwm_output.h"
+#include "io/serial.h"
+#include "config/config.h"
+#include "flight/mixer.h"
+#include "sensors/esc_telemetry.h"
+escTelemetry_t escTelemetry;
+static serialPort_t *escTelemetryPort = NULL;
+static uint8_t escTelemetryBuffer[ESC_TELEMETRY_FRAME_SIZE];
+static uint8_t escTelemetryBufferIndex = 0;
+static uint8_t escTelemetryMotor = 0;
+static bool escTelemetryWaiting = false;
+static uint32_t escTelemetryRequestTime = 0;
+static float erpmToHz = 0.0f;
+extern uint8_t motorCount;
+static uint8_t escTelemetryCrc8(const uint8_t *data, uint8_t length)
+{
+    uint8_t crc = 0;
+    uint8_t i, bit;
+    for (i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+        }
+    }
+    return crc;
+}
+void escTelemetryInit(uint8_t motorPoles)
+{
+    memset(&escTelemetry, 0, sizeof(escTelemetry));
+    erpmToHz = 100.0f / 60.0f / (motorPoles / 2);
+    serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_ESC_TELEMETRY);
+    if (!portConfig || !mixerMotorsUseDshot()) {
+        return;
+    }
+    escTelemetryPort = openSerialPort(portConfig->identifier, FUNCTION_ESC_TELEMETRY, NULL, ESC_TELEMETRY_BAUDRATE, MODE_RX, SERIAL_NOT_INVERTED);
+}
+bool escTelemetryIsEnabled(void)
+{
+    return escTelemetryPort != NULL;
+}
+static void escTelemetryMissedFrame(escTelemetryData_t *esc, uint8_t motorIndex)
+{
+    if (esc->missedFrames < ESC_TELEMETRY_MAX_MISSED_FRAMES) {
+        esc->missedFrames++;
+    } else {
+        esc->erpm = 0;
+        escTelemetry.motorHz[motorIndex] = 0.0f;
+    }
+}
+static void escTelemetryDecodeFrame(uint8_t motorIndex)
+{
+    escTelemetryData_t *esc = &escTelemetry.esc[motorIndex];
+    if (escTelemetryCrc8(escTelemetryBuffer, ESC_TELEMETRY_FRAME_SIZE - 1) != escTelemetryBuffer[ESC_TELEMETRY_FRAME_SIZE - 1]) {
+        escTelemetry.crcErrors++;
+        escTelemetryMissedFrame(esc, motorIndex);
+        return;
+    }
+    esc->temperature = escTelemetryBuffer[0];
+    esc->voltage = escTelemetryBuffer[1] << 8 | escTelemetryBuffer[2];
+    esc->current = escTelemetryBuffer[3] << 8 | escTelemetryBuffer[4];
+    esc->consumption = escTelemetryBuffer[5] << 8 | escTelemetryBuffer[6];
+    esc->erpm = escTelemetryBuffer[7] << 8 | escTelemetryBuffer[8];
+    esc->missedFrames = 0;
+    escTelemetry.motorHz[motorIndex] = esc->erpm * erpmToHz;
+}
+void escTelemetryProcess(uint32_t currentTime)
+{
+    if (!escTelemetryPort || !motorCount) {
+        return;
+    }
+    if (!escTelemetryWaiting) {
+        while (serialRxBytesWaiting(escTelemetryPort)) {
+            serialRead(escTelemetryPort);
+        }
+        escTelemetryBufferIndex = 0;
+        pwmRequestDshotTelemetry(escTelemetryMotor);
+        escTelemetryRequestTime = currentTime;
+        escTelemetryWaiting = true;
+        return;
+    }
+    while (serialRxBytesWaiting(escTelemetryPort) && escTelemetryBufferIndex < ESC_TELEMETRY_FRAME_SIZE) {
+        escTelemetryBuffer[escTelemetryBufferIndex++] = serialRead(escTelemetryPort);
+    }
+    if (escTelemetryBufferIndex == ESC_TELEMETRY_FRAME_SIZE) {
+        escTelemetryDecodeFrame(escTelemetryMotor);
+    } else if (cmp32(currentTime, escTelemetryRequestTime) >= ESC_TELEMETRY_TIMEOUT_US) {
+        escTelemetry.timeouts++;
+        escTelemetryMissedFrame(&escTelemetry.esc[escTelemetryMotor], escTelemetryMotor);
+    } else {
+        return;
+    }
+    escTelemetryWaiting = false;
+    escTelemetryMotor = (escTelemetryMotor + 1) % motorCount;
+}
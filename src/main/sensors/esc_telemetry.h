@@ -0,0 +1,42 @@
+/* 
+ * This file is part of RaceFlight. 
+ * 
+ * RaceFlight is free software: you can redistribute it and/or modify 
+ * it under the terms of the GNU General Public License as published by 
+ * the Free Software Foundation, either version 3 of the License, or 
+ * (at your option) any later version. 
+ * 
+ * RaceFlight is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of 
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+ * GNU General Public License for more details. 
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ * You should have received a copy of the GNU General Public License 
+ * along with RaceFlight.  If not, see <http://www.gnu.org/licenses/>.
+ */ 
+#pragma once 
+       
+#define ESC_TELEMETRY_BAUDRATE 115200
+#define ESC_TELEMETRY_FRAME_SIZE 10
+#define ESC_TELEMETRY_TIMEOUT_US 3000
+#define ESC_TELEMETRY_MAX_MISSED_FRAMES 4
+typedef struct escTelemetryData_s {
+    int8_t temperature;
+    uint16_t voltage;
+    uint16_t current;
+    uint16_t consumption;
+    uint16_t erpm;
+    uint8_t missedFrames;
+} escTelemetryData_t;
+typedef struct escTelemetry_s {
+    escTelemetryData_t esc[MAX_SUPPORTED_MOTORS];
+    float motorHz[MAX_SUPPORTED_MOTORS];
+    uint16_t crcErrors;
+    uint16_t timeouts;
+} escTelemetry_t;
+extern escTelemetry_t escTelemetry;
+void escTelemetryInit(uint8_t motorPoles);
+bool escTelemetryIsEnabled(void);
+void escTelemetryProcess(uint32_t currentTime);
@@ -19,6 +19,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "debug.h"
 #include "platform.h"
@@ -37,8 +38,13 @@
 #include "sensors/boardalignment.h"
 #include "sensors/gyro.h"
 #include "include.h"
+#include "drivers/pwm_mapping.h"
+#include "sensors/esc_telemetry.h"
 uint16_t calibratingG = 0;
 int16_t gyroADC[XYZ_AXIS_COUNT];
+#ifdef BLACKBOX
+int16_t gyroADCRaw[XYZ_AXIS_COUNT];
+#endif
 int16_t gyroZero[FLIGHT_DYNAMICS_INDEX_COUNT] = { 0, 0, 0 };
 static gyroConfig_t *gyroConfig;
 static biquad_t gyroBiQuadState[3];
@@ -48,6 +54,69 @@ static uint16_t gyroLpfCutFreq;
 int axis;
 gyro_t gyro;
 sensor_align_e gyroAlign = 0;
+#ifdef USE_DSHOT
+extern uint8_t motorCount;
+static notchCoeffs_t rpmNotchCoeffs[RPM_NOTCH_MAX_MOTORS * RPM_NOTCH_MAX_HARMONICS];
+static notchState_t rpmNotchState[XYZ_AXIS_COUNT][RPM_NOTCH_MAX_MOTORS * RPM_NOTCH_MAX_HARMONICS];
+static bool rpmNotchActive[RPM_NOTCH_MAX_MOTORS * RPM_NOTCH_MAX_HARMONICS];
+static uint8_t rpmNotchCount;
+static uint8_t rpmNotchHarmonics;
+static uint8_t rpmNotchUpdateIndex;
+static float rpmNotchSamplingRate;
+static float rpmNotchMaxHz;
+static float rpmNotchQ;
+STATIC_UNIT_TESTED void initRpmNotchFilters(void)
+{
+    rpmNotchCount = 0;
+    rpmNotchHarmonics = 0;
+    rpmNotchUpdateIndex = 0;
+    if (!escTelemetryIsEnabled() || !gyroConfig->rpm_notch_harmonics || !targetLooptime) {
+        return;
+    }
+    initSinLut();
+    rpmNotchSamplingRate = 1000000.0f / targetLooptime;
+    rpmNotchMaxHz = rpmNotchSamplingRate * 0.45f;
+    rpmNotchQ = gyroConfig->rpm_notch_q / 10.0f;
+    rpmNotchHarmonics = MIN(gyroConfig->rpm_notch_harmonics, RPM_NOTCH_MAX_HARMONICS);
+    rpmNotchCount = MIN(motorCount, RPM_NOTCH_MAX_MOTORS) * rpmNotchHarmonics;
+    memset(rpmNotchActive, 0, sizeof(rpmNotchActive));
+}
+STATIC_UNIT_TESTED void updateRpmNotchFilter(void)
+{
+    uint8_t index = rpmNotchUpdateIndex;
+    float centerFreq = escTelemetry.motorHz[index / rpmNotchHarmonics] * (index % rpmNotchHarmonics + 1);
+    bool active = centerFreq >= gyroConfig->rpm_notch_min_hz && centerFreq < rpmNotchMaxHz;
+    if (active) {
+        notchFilterUpdate(&rpmNotchCoeffs[index], centerFreq, rpmNotchQ, rpmNotchSamplingRate);
+        if (!rpmNotchActive[index]) {
+            for (axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+                memset(&rpmNotchState[axis][index], 0, sizeof(notchState_t));
+            }
+        }
+    }
+    rpmNotchActive[index] = active;
+    if (++rpmNotchUpdateIndex >= rpmNotchCount) {
+        rpmNotchUpdateIndex = 0;
+    }
+}
+STATIC_UNIT_TESTED void applyRpmNotchFilters(void)
+{
+    uint8_t index;
+    if (!rpmNotchCount) {
+        return;
+    }
+    updateRpmNotchFilter();
+    for (axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        float sample = gyroADC[axis];
+        for (index = 0; index < rpmNotchCount; index++) {
+            if (rpmNotchActive[index]) {
+                sample = applyNotchFilter(sample, &rpmNotchCoeffs[index], &rpmNotchState[axis][index]);
+            }
+        }
+        gyroADC[axis] = lrintf(sample);
+    }
+}
+#endif
 void useGyroConfig(gyroConfig_t *gyroConfigToUse, uint8_t gyro_lpf_hz)
 {
     gyroConfig = gyroConfigToUse;
@@ -73,6 +142,9 @@ void initGyroFilterCoefficients(void) {
   }
  }
  gyroFilterStateIsSet = true;
+#ifdef USE_DSHOT
+ initRpmNotchFilters();
+#endif
 }
 void gyroSetCalibrationCycles(uint16_t calibrationCyclesRequired)
 {
@@ -130,9 +202,15 @@ void gyroUpdate(void)
     if (!gyro.read(gyroADC)) {
         return;
     }
+#ifdef BLACKBOX
+    memcpy(gyroADCRaw, gyroADC, sizeof(gyroADCRaw));
+#endif
     if (!gyroFilterStateIsSet) {
      initGyroFilterCoefficients();
     }
+#ifdef USE_DSHOT
+    applyRpmNotchFilters();
+#endif
     for (axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
      if (axis == FD_ROLL) {
    gyroLpfCutFreq = currentProfile->pidProfile.wrgyrolpf;
@@ -164,4 +242,10 @@ void gyroUpdate(void)
         performAcclerationCalibration(gyroConfig->gyroMovementCalibrationThreshold);
     }
     applyGyroZero();
+#ifdef BLACKBOX
+    alignSensors(gyroADCRaw, gyroADCRaw, gyroAlign);
+    for (axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        gyroADCRaw[axis] -= gyroZero[axis];
+    }
+#endif
 }
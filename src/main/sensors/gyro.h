@@ -34,8 +34,14 @@ extern gyro_t gyro;
 extern sensor_align_e gyroAlign;
 extern int16_t gyroADC[XYZ_AXIS_COUNT];
 extern int16_t gyroZero[FLIGHT_DYNAMICS_INDEX_COUNT];
+extern int16_t gyroADCRaw[XYZ_AXIS_COUNT];
+#define RPM_NOTCH_MAX_MOTORS 8
+#define RPM_NOTCH_MAX_HARMONICS 3
 typedef struct gyroConfig_s {
     uint8_t gyroMovementCalibrationThreshold;
+    uint8_t rpm_notch_harmonics;
+    uint8_t rpm_notch_q;
+    uint8_t rpm_notch_min_hz;
 } gyroConfig_t;
 void gyroSetCalibrationCycles(uint16_t calibrationCyclesRequired);
 void gyroUpdate(void);
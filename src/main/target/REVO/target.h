@@ -64,6 +64,16 @@
 #define M25P16_SPI_INSTANCE SPI3
 #define USE_FLASHFS 
 #define USE_FLASH_M25P16 
+#define M25P16_DMA 
+#define M25P16_DMA_CH DMA_Channel_0
+#define M25P16_DMA_TX_ST DMA1_Stream5
+#define M25P16_DMA_RX_ST DMA1_Stream0
+#define M25P16_DMA_TX_FLAGS (DMA_FLAG_TCIF5 | DMA_FLAG_HTIF5 | DMA_FLAG_TEIF5 | DMA_FLAG_DMEIF5 | DMA_FLAG_FEIF5)
+#define M25P16_DMA_RX_FLAGS (DMA_FLAG_TCIF0 | DMA_FLAG_HTIF0 | DMA_FLAG_TEIF0 | DMA_FLAG_DMEIF0 | DMA_FLAG_FEIF0)
+#define M25P16_DMA_RX_TC_FLAG DMA_FLAG_TCIF0
+#define M25P16_DMA_RX_IRQ DMA1_Stream0_IRQn
+#define M25P16_DMA_RX_IRQ_HANDLER DMA1_Stream0_IRQHandler
+#define M25P16_DMA_PERIPH RCC_AHB1Periph_DMA1
 #define USABLE_TIMER_CHANNEL_COUNT 12
 #define USE_VCP 
 #define VBUS_SENSING_PIN PC5
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static inline uint64_t benchNowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static inline uint32_t benchRandom(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+#define BENCH_REPEAT 15
+
+// Best of BENCH_REPEAT runs, reported per iteration and as iterations/sec.
+#define BENCH_RUN(name, iterations, body) do { \
+    uint64_t benchBest = UINT64_MAX; \
+    int benchRun; \
+    for (benchRun = 0; benchRun < BENCH_REPEAT; benchRun++) { \
+        uint64_t benchStart = benchNowNs(); \
+        uint32_t benchIter; \
+        for (benchIter = 0; benchIter < (iterations); benchIter++) { \
+            body; \
+        } \
+        uint64_t benchElapsed = benchNowNs() - benchStart; \
+        if (benchElapsed < benchBest) \
+            benchBest = benchElapsed; \
+    } \
+    printf("%-40s %10.2f ns/op %12.0f op/s\n", name, (double)benchBest / (iterations), \
+        (iterations) * 1e9 / benchBest); \
+} while (0)
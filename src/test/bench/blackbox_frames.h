@@ -0,0 +1,56 @@
+// I- and P-frame bodies following writeIntraframe/writeInterframe in
+// blackbox.c for a quad logging vbat and PID D. Included once per writer set:
+// BB(fn) picks the writer, BENCH_FRAME(fn) names the generated function.
+
+static void BENCH_FRAME(writeIntraframe)(const benchState_t *cur, uint32_t iteration)
+{
+    int x;
+    BB(Write)('I');
+    BB(WriteUnsignedVB)(iteration);
+    BB(WriteUnsignedVB)(cur->time);
+    BB(WriteSignedVBArray)((int32_t *)cur->axisPID_P, XYZ_AXIS_COUNT);
+    BB(WriteSignedVBArray)((int32_t *)cur->axisPID_I, XYZ_AXIS_COUNT);
+    for (x = 0; x < XYZ_AXIS_COUNT; x++)
+        BB(WriteSignedVB)(cur->axisPID_D[x]);
+    BB(WriteSigned16VBArray)((int16_t *)cur->rcCommand, 3);
+    BB(WriteUnsignedVB)(cur->rcCommand[THROTTLE] - 1000);
+    BB(WriteUnsignedVB)((4095 - cur->vbatLatest) & 0x3FFF);
+    BB(WriteSigned16VBArray)((int16_t *)cur->gyroADC, XYZ_AXIS_COUNT);
+    BB(WriteSigned16VBArray)((int16_t *)cur->accSmooth, XYZ_AXIS_COUNT);
+    BB(WriteSigned16VBArray)((int16_t *)cur->debug, 3);
+    BB(WriteUnsignedVB)(cur->motor[0] - 1000);
+    for (x = 1; x < BENCH_MOTORS; x++)
+        BB(WriteSignedVB)(cur->motor[x] - cur->motor[0]);
+}
+
+static void BENCH_FRAME(writeAveragePredicted)(const int16_t *curr, const int16_t *prev1, const int16_t *prev2, int count)
+{
+    int i;
+    for (i = 0; i < count; i++)
+        BB(WriteSignedVB)(curr[i] - (prev1[i] + prev2[i]) / 2);
+}
+
+static void BENCH_FRAME(writeInterframe)(const benchState_t *cur, const benchState_t *last, const benchState_t *last2)
+{
+    int32_t deltas[8];
+    int x;
+    BB(Write)('P');
+    BB(WriteSignedVB)((int32_t)(cur->time - 2 * last->time + last2->time));
+    for (x = 0; x < XYZ_AXIS_COUNT; x++)
+        deltas[x] = cur->axisPID_P[x] - last->axisPID_P[x];
+    BB(WriteSignedVBArray)(deltas, XYZ_AXIS_COUNT);
+    for (x = 0; x < XYZ_AXIS_COUNT; x++)
+        deltas[x] = cur->axisPID_I[x] - last->axisPID_I[x];
+    BB(WriteTag2_3S32)(deltas);
+    for (x = 0; x < XYZ_AXIS_COUNT; x++)
+        BB(WriteSignedVB)(cur->axisPID_D[x] - last->axisPID_D[x]);
+    for (x = 0; x < 4; x++)
+        deltas[x] = cur->rcCommand[x] - last->rcCommand[x];
+    BB(WriteTag8_4S16)(deltas);
+    deltas[0] = (int32_t)cur->vbatLatest - last->vbatLatest;
+    BB(WriteTag8_8SVB)(deltas, 1);
+    BENCH_FRAME(writeAveragePredicted)(cur->gyroADC, last->gyroADC, last2->gyroADC, XYZ_AXIS_COUNT);
+    BENCH_FRAME(writeAveragePredicted)(cur->accSmooth, last->accSmooth, last2->accSmooth, XYZ_AXIS_COUNT);
+    BENCH_FRAME(writeAveragePredicted)(cur->debug, last->debug, last2->debug, 3);
+    BENCH_FRAME(writeAveragePredicted)(cur->motor, last->motor, last2->motor, BENCH_MOTORS);
+}
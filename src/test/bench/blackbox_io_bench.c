@@ -0,0 +1,108 @@
+#include "blackbox_io_support.h"
+#include "blackbox_io_reference.h"
+#include "bench.h"
+
+#define BENCH_MOTORS 4
+#define STATES 256
+#define ITERATIONS 200000
+
+typedef struct benchState_s {
+    uint32_t time;
+    int32_t axisPID_P[XYZ_AXIS_COUNT], axisPID_I[XYZ_AXIS_COUNT], axisPID_D[XYZ_AXIS_COUNT];
+    int16_t rcCommand[4];
+    uint16_t vbatLatest;
+    int16_t gyroADC[XYZ_AXIS_COUNT];
+    int16_t accSmooth[XYZ_AXIS_COUNT];
+    int16_t debug[3];
+    int16_t motor[BENCH_MOTORS];
+} benchState_t;
+
+#define BB(fn) blackbox##fn
+#define BENCH_FRAME(fn) fn##Buffered
+#include "blackbox_frames.h"
+#undef BB
+#undef BENCH_FRAME
+
+#define BB(fn) refBlackbox##fn
+#define BENCH_FRAME(fn) fn##PerByte
+#include "blackbox_frames.h"
+#undef BB
+#undef BENCH_FRAME
+
+static benchState_t states[STATES];
+
+// Flight-like history: slow sticks, noisy gyro, motors following the PID sum.
+static void buildStates(void)
+{
+    uint32_t seed = 0x1f2e3d4c;
+    int i, axis;
+    for (i = 0; i < STATES; i++) {
+        benchState_t *s = &states[i];
+        s->time = i * 125;
+        for (axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            s->gyroADC[axis] = (int16_t)((i * (3 + axis)) % 200 - 100 + (int)(benchRandom(&seed) % 17) - 8);
+            s->accSmooth[axis] = (int16_t)((axis == 2 ? 512 : 0) + (int)(benchRandom(&seed) % 9) - 4);
+            s->axisPID_P[axis] = -s->gyroADC[axis] / 2;
+            s->axisPID_I[axis] = (i / 8) % 40 - 20;
+            s->axisPID_D[axis] = (int)(benchRandom(&seed) % 61) - 30;
+            s->debug[axis] = s->gyroADC[axis] - s->accSmooth[axis];
+        }
+        for (axis = 0; axis < 4; axis++)
+            s->rcCommand[axis] = axis == THROTTLE ? 1400 + (i / 4) % 100 : (i / 2) % 60 - 30;
+        s->vbatLatest = 1600 - i / 64;
+        for (axis = 0; axis < BENCH_MOTORS; axis++)
+            s->motor[axis] = s->rcCommand[THROTTLE] + s->axisPID_P[axis % 3] + s->axisPID_D[(axis + 1) % 3];
+    }
+}
+
+#define HISTORY(n) (&states[(n) & (STATES - 1)])
+
+static void runDevice(const char *device, uint8_t deviceId)
+{
+    static uint8_t perByte[256];
+    char name[64];
+    uint32_t length, iFrameLength;
+
+    testBlackboxOpen(deviceId);
+    refBlackboxPort = &testSerialPort;
+
+    snprintf(name, sizeof(name), "%s I-frame per-byte", device);
+    BENCH_RUN(name, ITERATIONS,
+        writeIntraframePerByte(HISTORY(benchIter), benchIter));
+    snprintf(name, sizeof(name), "%s I-frame buffered", device);
+    BENCH_RUN(name, ITERATIONS, {
+        writeIntraframeBuffered(HISTORY(benchIter), benchIter);
+        blackboxFrameFlush();
+    });
+    snprintf(name, sizeof(name), "%s P-frame per-byte", device);
+    BENCH_RUN(name, ITERATIONS,
+        writeInterframePerByte(HISTORY(benchIter + 2), HISTORY(benchIter + 1), HISTORY(benchIter)));
+    snprintf(name, sizeof(name), "%s P-frame buffered", device);
+    BENCH_RUN(name, ITERATIONS, {
+        writeInterframeBuffered(HISTORY(benchIter + 2), HISTORY(benchIter + 1), HISTORY(benchIter));
+        blackboxFrameFlush();
+    });
+
+    testOutputLength = 0;
+    writeIntraframePerByte(HISTORY(0), 0);
+    writeInterframePerByte(HISTORY(2), HISTORY(1), HISTORY(0));
+    length = testOutputLength;
+    memcpy(perByte, testOutput, length);
+    testOutputLength = 0;
+    writeIntraframeBuffered(HISTORY(0), 0);
+    blackboxFrameFlush();
+    iFrameLength = testOutputLength;
+    writeInterframeBuffered(HISTORY(2), HISTORY(1), HISTORY(0));
+    blackboxFrameFlush();
+    printf("%s frame size: I %u bytes, P %u bytes, output %s\n", device, (unsigned)iFrameLength,
+        (unsigned)(testOutputLength - iFrameLength),
+        testOutputLength == length && !memcmp(perByte, testOutput, length) ? "identical" : "DIFFERS");
+}
+
+int main(void)
+{
+    buildStates();
+    runDevice("flash", BLACKBOX_DEVICE_FLASH);
+    runDevice("serial", BLACKBOX_DEVICE_SERIAL);
+    return 0;
+}
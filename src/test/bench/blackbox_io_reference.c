@@ -0,0 +1,218 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "include.h"
+#include "blackbox/blackbox_io.h"
+#include "io/flashfs.h"
+
+#include "blackbox_io_reference.h"
+
+serialPort_t *refBlackboxPort;
+
+void refBlackboxWrite(uint8_t value)
+{
+    switch (masterConfig.blackbox_device) {
+        case BLACKBOX_DEVICE_FLASH:
+            flashfsWriteByte(value);
+        break;
+        case BLACKBOX_DEVICE_SERIAL:
+        default:
+            serialWrite(refBlackboxPort, value);
+        break;
+    }
+}
+void refBlackboxWriteUnsignedVB(uint32_t value)
+{
+    while (value > 127) {
+        refBlackboxWrite((uint8_t) (value | 0x80));
+        value >>= 7;
+    }
+    refBlackboxWrite(value);
+}
+void refBlackboxWriteSignedVB(int32_t value)
+{
+    refBlackboxWriteUnsignedVB(zigzagEncode(value));
+}
+void refBlackboxWriteSignedVBArray(int32_t *array, int count)
+{
+    for (int i = 0; i < count; i++) {
+        refBlackboxWriteSignedVB(array[i]);
+    }
+}
+void refBlackboxWriteSigned16VBArray(int16_t *array, int count)
+{
+    for (int i = 0; i < count; i++) {
+        refBlackboxWriteSignedVB(array[i]);
+    }
+}
+void refBlackboxWriteTag2_3S32(int32_t *values) {
+    static const int NUM_FIELDS = 3;
+    enum {
+        BITS_2 = 0,
+        BITS_4 = 1,
+        BITS_6 = 2,
+        BITS_32 = 3
+    };
+    enum {
+        BYTES_1 = 0,
+        BYTES_2 = 1,
+        BYTES_3 = 2,
+        BYTES_4 = 3
+    };
+    int x;
+    int selector = BITS_2, selector2;
+    for (x = 0; x < NUM_FIELDS; x++) {
+        if (values[x] >= 32 || values[x] < -32) {
+            selector = BITS_32;
+            break;
+        }
+        if (values[x] >= 8 || values[x] < -8) {
+             if (selector < BITS_6) {
+                 selector = BITS_6;
+             }
+        } else if (values[x] >= 2 || values[x] < -2) {
+            if (selector < BITS_4) {
+                selector = BITS_4;
+            }
+        }
+    }
+    switch (selector) {
+        case BITS_2:
+            refBlackboxWrite((selector << 6) | ((values[0] & 0x03) << 4) | ((values[1] & 0x03) << 2) | (values[2] & 0x03));
+        break;
+        case BITS_4:
+            refBlackboxWrite((selector << 6) | (values[0] & 0x0F));
+            refBlackboxWrite((values[1] << 4) | (values[2] & 0x0F));
+        break;
+        case BITS_6:
+            refBlackboxWrite((selector << 6) | (values[0] & 0x3F));
+            refBlackboxWrite((uint8_t)values[1]);
+            refBlackboxWrite((uint8_t)values[2]);
+        break;
+        case BITS_32:
+            selector2 = 0;
+            for (x = NUM_FIELDS - 1; x >= 0; x--) {
+                selector2 <<= 2;
+                if (values[x] < 128 && values[x] >= -128) {
+                    selector2 |= BYTES_1;
+                } else if (values[x] < 32768 && values[x] >= -32768) {
+                    selector2 |= BYTES_2;
+                } else if (values[x] < 8388608 && values[x] >= -8388608) {
+                    selector2 |= BYTES_3;
+                } else {
+                    selector2 |= BYTES_4;
+                }
+            }
+            refBlackboxWrite((selector << 6) | selector2);
+            for (x = 0; x < NUM_FIELDS; x++, selector2 >>= 2) {
+                switch (selector2 & 0x03) {
+                    case BYTES_1:
+                        refBlackboxWrite(values[x]);
+                    break;
+                    case BYTES_2:
+                        refBlackboxWrite(values[x]);
+                        refBlackboxWrite(values[x] >> 8);
+                    break;
+                    case BYTES_3:
+                        refBlackboxWrite(values[x]);
+                        refBlackboxWrite(values[x] >> 8);
+                        refBlackboxWrite(values[x] >> 16);
+                    break;
+                    case BYTES_4:
+                        refBlackboxWrite(values[x]);
+                        refBlackboxWrite(values[x] >> 8);
+                        refBlackboxWrite(values[x] >> 16);
+                        refBlackboxWrite(values[x] >> 24);
+                    break;
+                }
+            }
+        break;
+    }
+}
+void refBlackboxWriteTag8_4S16(int32_t *values) {
+    enum {
+        FIELD_ZERO = 0,
+        FIELD_4BIT = 1,
+        FIELD_8BIT = 2,
+        FIELD_16BIT = 3
+    };
+    uint8_t selector, buffer;
+    int nibbleIndex;
+    int x;
+    selector = 0;
+    for (x = 3; x >= 0; x--) {
+        selector <<= 2;
+        if (values[x] == 0) {
+            selector |= FIELD_ZERO;
+        } else if (values[x] < 8 && values[x] >= -8) {
+            selector |= FIELD_4BIT;
+        } else if (values[x] < 128 && values[x] >= -128) {
+            selector |= FIELD_8BIT;
+        } else {
+            selector |= FIELD_16BIT;
+        }
+    }
+    refBlackboxWrite(selector);
+    nibbleIndex = 0;
+    buffer = 0;
+    for (x = 0; x < 4; x++, selector >>= 2) {
+        switch (selector & 0x03) {
+            case FIELD_ZERO:
+            break;
+            case FIELD_4BIT:
+                if (nibbleIndex == 0) {
+                    buffer = values[x] << 4;
+                    nibbleIndex = 1;
+                } else {
+                    refBlackboxWrite(buffer | (values[x] & 0x0F));
+                    nibbleIndex = 0;
+                }
+            break;
+            case FIELD_8BIT:
+                if (nibbleIndex == 0) {
+                    refBlackboxWrite(values[x]);
+                } else {
+                    refBlackboxWrite(buffer | ((values[x] >> 4) & 0x0F));
+                    buffer = values[x] << 4;
+                }
+            break;
+            case FIELD_16BIT:
+                if (nibbleIndex == 0) {
+                    refBlackboxWrite(values[x] >> 8);
+                    refBlackboxWrite(values[x]);
+                } else {
+                    refBlackboxWrite(buffer | ((values[x] >> 12) & 0x0F));
+                    refBlackboxWrite(values[x] >> 4);
+                    buffer = values[x] << 4;
+                }
+            break;
+        }
+    }
+    if (nibbleIndex == 1) {
+        refBlackboxWrite(buffer);
+    }
+}
+void refBlackboxWriteTag8_8SVB(int32_t *values, int valueCount)
+{
+    uint8_t header;
+    int i;
+    if (valueCount > 0) {
+        if (valueCount == 1) {
+            refBlackboxWriteSignedVB(values[0]);
+        } else {
+            header = 0;
+            for (i = valueCount - 1; i >= 0; i--) {
+                header <<= 1;
+                if (values[i] != 0) {
+                    header |= 0x01;
+                }
+            }
+            refBlackboxWrite(header);
+            for (i = 0; i < valueCount; i++) {
+                if (values[i] != 0) {
+                    refBlackboxWriteSignedVB(values[i]);
+                }
+            }
+        }
+    }
+}
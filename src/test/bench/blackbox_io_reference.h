@@ -0,0 +1,17 @@
+#pragma once
+
+// The blackbox writers as they were before frames were buffered: every byte
+// goes through the device switch and then flashfsWriteByte or serialWrite.
+
+#include <stdint.h>
+
+extern serialPort_t *refBlackboxPort;
+
+void refBlackboxWrite(uint8_t value);
+void refBlackboxWriteUnsignedVB(uint32_t value);
+void refBlackboxWriteSignedVB(int32_t value);
+void refBlackboxWriteSignedVBArray(int32_t *array, int count);
+void refBlackboxWriteSigned16VBArray(int16_t *array, int count);
+void refBlackboxWriteTag2_3S32(int32_t *values);
+void refBlackboxWriteTag8_4S16(int32_t *values);
+void refBlackboxWriteTag8_8SVB(int32_t *values, int valueCount);
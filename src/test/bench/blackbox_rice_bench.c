@@ -0,0 +1,141 @@
+#include <math.h>
+
+#include "blackbox_io_support.h"
+#include "blackbox_rice_decode.h"
+#include "bench.h"
+
+#define GROUPS 4
+#define FIELDS 13
+#define FRAMES 4096
+#define I_INTERVAL 32
+#define LOG_RATE_HZ 1000
+#define ITERATIONS 200000
+
+static const char *const groupNames[GROUPS] = { "gyroADC", "accSmooth", "debug", "motor" };
+static const uint8_t groupStart[GROUPS + 1] = { 0, 3, 6, 9, 13 };
+
+static int16_t history[FRAMES][FIELDS];
+static int32_t residuals[FRAMES][FIELDS];
+
+static int16_t noiseValue(uint32_t *seed, int range)
+{
+    return (int16_t)((int)(benchRandom(seed) % (2 * range + 1)) - range);
+}
+
+// Synthetic 1 kHz log: stick inputs of a few Hz, a 180 Hz motor vibration
+// line, sensor noise, and motors following throttle plus PID correction.
+static void buildHistory(void)
+{
+    uint32_t seed = 0x600dcafe;
+    int frame, axis;
+    for (frame = 0; frame < FRAMES; frame++) {
+        const float t = (float)frame / LOG_RATE_HZ;
+        const float vibration = sinf(2 * M_PI * 180 * t);
+        int16_t *h = history[frame];
+        for (axis = 0; axis < 3; axis++) {
+            const float stick = 250 * sinf(2 * M_PI * (1.5f + axis) * t) * (((frame >> 9) & 1) ? 1.0f : 0.2f);
+            h[axis] = (int16_t)(stick + 25 * vibration) + noiseValue(&seed, 6);
+            h[3 + axis] = (int16_t)((axis == 2 ? 512 : 0) + 40 * vibration * (axis + 1)) + noiseValue(&seed, 4);
+            h[6 + axis] = (int16_t)(60 * vibration) + noiseValue(&seed, 20);
+        }
+        for (axis = 0; axis < 4; axis++)
+            h[9 + axis] = (int16_t)(1450 + 200 * sinf(2 * M_PI * 0.7f * t) + ((axis & 1) ? -1 : 1) * h[axis % 3] / 3) + noiseValue(&seed, 10);
+    }
+    for (frame = 2; frame < FRAMES; frame++) {
+        for (axis = 0; axis < FIELDS; axis++)
+            residuals[frame][axis] = history[frame][axis] - (history[frame - 1][axis] + history[frame - 2][axis]) / 2;
+    }
+}
+
+static void encodeVB(int frame)
+{
+    int i;
+    for (i = 0; i < FIELDS; i++)
+        blackboxWriteSignedVB(residuals[frame][i]);
+    blackboxFrameFlush();
+}
+
+static void encodeRice(int frame, blackboxRiceState_t *state)
+{
+    int i;
+    if (frame % I_INTERVAL == 0)
+        blackboxRiceReset(state, FIELDS);
+    for (i = 0; i < FIELDS; i++)
+        blackboxWriteRiceSigned(residuals[frame][i], &state[i]);
+    blackboxRiceFlush();
+    blackboxFrameFlush();
+}
+
+static void reportCompression(void)
+{
+    blackboxRiceState_t state[FIELDS];
+    riceDecodeState_t decodeState[FIELDS];
+    riceDecoder_t decoder;
+    uint32_t vbBytes[GROUPS] = { 0 }, riceBits[GROUPS] = { 0 };
+    uint32_t vbTotal = 0, riceTotal, paddingBits = 0;
+    int frame, group, i;
+
+    testBlackboxOpen(BLACKBOX_DEVICE_FLASH);
+    for (frame = 2; frame < FRAMES; frame++) {
+        for (group = 0; group < GROUPS; group++) {
+            const uint32_t before = testOutputLength;
+            for (i = groupStart[group]; i < groupStart[group + 1]; i++)
+                blackboxWriteSignedVB(residuals[frame][i]);
+            blackboxFrameFlush();
+            vbBytes[group] += testOutputLength - before;
+        }
+    }
+    vbTotal = testOutputLength;
+
+    testBlackboxOpen(BLACKBOX_DEVICE_FLASH);
+    for (frame = 2; frame < FRAMES; frame++)
+        encodeRice(frame, state);
+    riceTotal = testOutputLength;
+
+    riceDecoderInit(&decoder, testOutput, testOutputLength);
+    for (frame = 2; frame < FRAMES; frame++) {
+        uint32_t padStart;
+        if (frame % I_INTERVAL == 0)
+            riceDecodeReset(decodeState, FIELDS);
+        for (group = 0; group < GROUPS; group++) {
+            const uint32_t before = decoder.bitPos;
+            for (i = groupStart[group]; i < groupStart[group + 1]; i++) {
+                int32_t value;
+                if (!riceDecodeSigned(&decoder, &decodeState[i], &value) || value != residuals[frame][i]) {
+                    printf("decode mismatch at frame %d field %d\n", frame, i);
+                    return;
+                }
+            }
+            riceBits[group] += decoder.bitPos - before;
+        }
+        padStart = decoder.bitPos;
+        riceDecodeAlign(&decoder);
+        paddingBits += decoder.bitPos - padStart;
+    }
+
+    printf("%-12s %12s %12s %8s\n", "group", "VB B/frame", "Rice B/frame", "ratio");
+    for (group = 0; group < GROUPS; group++) {
+        const double vb = (double)vbBytes[group] / (FRAMES - 2);
+        const double rice = (double)riceBits[group] / 8 / (FRAMES - 2);
+        printf("%-12s %12.2f %12.2f %8.2f\n", groupNames[group], vb, rice, rice / vb);
+    }
+    printf("%-12s %12s %12.2f\n", "padding", "", (double)paddingBits / 8 / (FRAMES - 2));
+    printf("%-12s %12.2f %12.2f %8.2f\n", "total", (double)vbTotal / (FRAMES - 2),
+        (double)riceTotal / (FRAMES - 2), (double)riceTotal / vbTotal);
+}
+
+int main(void)
+{
+    blackboxRiceState_t state[FIELDS];
+
+    buildHistory();
+    reportCompression();
+
+    testBlackboxOpen(BLACKBOX_DEVICE_FLASH);
+    blackboxRiceReset(state, FIELDS);
+    BENCH_RUN("13 residuals, VB", ITERATIONS,
+        encodeVB(2 + benchIter % (FRAMES - 2)));
+    BENCH_RUN("13 residuals, Rice", ITERATIONS,
+        encodeRice(2 + benchIter % (FRAMES - 2), state));
+    return 0;
+}
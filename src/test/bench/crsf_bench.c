@@ -0,0 +1,37 @@
+#include "crsf_support.h"
+#include "bench.h"
+
+#define FRAMES 64
+#define ITERATIONS 1000000
+
+static uint8_t frames[FRAMES][CRSF_RC_FRAME_SIZE];
+static volatile uint32_t sink;
+
+int main(void)
+{
+    static rxConfig_t rxConfig = { .midrc = 1500 };
+    uint16_t values[16];
+    uint32_t seed = 0xbeef;
+    int i, j;
+    for (i = 0; i < FRAMES; i++) {
+        for (j = 0; j < 16; j++)
+            values[j] = 172 + benchRandom(&seed) % 1640;
+        buildRcFrame(frames[i], values);
+    }
+    crsfInit(&rxConfig, &rxRuntimeConfig, NULL);
+
+    BENCH_RUN("crsfCrc8 (23 bytes)", ITERATIONS,
+        sink = crsfCrc8(frames[benchIter & (FRAMES - 1)] + 2, CRSF_RC_FRAME_LENGTH - 1));
+    BENCH_RUN("idle frame: receive + decode", ITERATIONS, {
+        crsfFrameReceive(frames[benchIter & (FRAMES - 1)], CRSF_RC_FRAME_SIZE);
+        sink = crsfFrameStatus();
+    });
+    BENCH_RUN("byte stream: 26 bytes + decode", ITERATIONS, {
+        const uint8_t *frame = frames[benchIter & (FRAMES - 1)];
+        for (j = 0; j < CRSF_RC_FRAME_SIZE; j++)
+            crsfDataReceive(frame[j]);
+        sink = crsfFrameStatus();
+    });
+    sink = framesArrived + framesReceived;
+    return 0;
+}
@@ -0,0 +1,28 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "flight/lowpass.h"
+
+#include "bench.h"
+
+#define SAMPLES 4096
+#define ITERATIONS 4000000
+
+static int16_t input[SAMPLES];
+static volatile int32_t sinkFixed;
+static volatile float sinkFloat;
+
+int main(void)
+{
+    static lowpass_t fixedFilter, floatFilter;
+    uint32_t seed = 0x12345678;
+    int i;
+    for (i = 0; i < SAMPLES; i++)
+        input[i] = 1000 + benchRandom(&seed) % 1000;
+
+    BENCH_RUN("lowpassFixed (int64)", ITERATIONS,
+        sinkFixed = lowpassFixed(&fixedFilter, input[benchIter & (SAMPLES - 1)], 400));
+    BENCH_RUN("lowpassFloat (biquad)", ITERATIONS,
+        sinkFloat = lowpassFloat(&floatFilter, input[benchIter & (SAMPLES - 1)], 400));
+    return 0;
+}
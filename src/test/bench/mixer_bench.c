@@ -0,0 +1,125 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "common/axis.h"
+#include "common/maths.h"
+#include "flight/mixer.h"
+#include "flight/mixer_matrix.h"
+
+#include "mixer_reference.h"
+#include "bench.h"
+
+#define STATES 1024
+#define ITERATIONS 2000000
+#define MIN_THROTTLE 1000
+#define MAX_THROTTLE 2000
+#define TPA_LENGTH 101
+
+typedef struct benchState_s {
+    int32_t pidP[XYZ_AXIS_COUNT], pidI[XYZ_AXIS_COUNT], pidD[XYZ_AXIS_COUNT];
+    int16_t throttle;
+    float throttleP;
+} benchState_t;
+
+static const motorMixer_t mixerQuadXL[] = {
+    { 1.0f, -1.0f, 1.0f, -1.0f },
+    { 1.0f, -1.0f, -1.0f, 1.0f },
+    { 1.0f, 1.0f, 1.0f, 1.0f },
+    { 1.0f, 1.0f, -1.0f, -1.0f },
+};
+static const motorMixer_t mixerHex6X[] = {
+    { 1.0f, -0.5f, 0.866025f, 1.0f },
+    { 1.0f, -0.5f, -0.866025f, 1.0f },
+    { 1.0f, 0.5f, 0.866025f, -1.0f },
+    { 1.0f, 0.5f, -0.866025f, -1.0f },
+    { 1.0f, -1.0f, 0.0f, -1.0f },
+    { 1.0f, 1.0f, 0.0f, 1.0f },
+};
+static const motorMixer_t mixerOctoX8[] = {
+    { 1.0f, -1.0f, 1.0f, -1.0f },
+    { 1.0f, -1.0f, -1.0f, 1.0f },
+    { 1.0f, 1.0f, 1.0f, 1.0f },
+    { 1.0f, 1.0f, -1.0f, -1.0f },
+    { 1.0f, -1.0f, 1.0f, 1.0f },
+    { 1.0f, -1.0f, -1.0f, -1.0f },
+    { 1.0f, 1.0f, 1.0f, -1.0f },
+    { 1.0f, 1.0f, -1.0f, 1.0f },
+};
+
+static benchState_t states[STATES];
+static int16_t tpaCurve[TPA_LENGTH];
+static int16_t motors[MAX_SUPPORTED_MOTORS];
+static volatile int16_t sink;
+
+static bool matrixMixTable(const mixerMatrixRow_t *matrix, uint8_t motorCount, const benchState_t *state)
+{
+    const float tpaScale = tpaCurve[(uint8_t)(state->throttleP * (TPA_LENGTH - 1) + 0.5f)] * 0.01f;
+    const float rollInput = tpaScale * (state->pidP[FD_ROLL] + state->pidD[FD_ROLL]) + state->pidI[FD_ROLL];
+    const float pitchInput = tpaScale * (state->pidP[FD_PITCH] + state->pidD[FD_PITCH]) + state->pidI[FD_PITCH];
+    const float yawInput = state->pidP[FD_YAW] + state->pidD[FD_YAW] + state->pidI[FD_YAW];
+    return mixerMatrixApply(motors, matrix, motorCount, rollInput, pitchInput, yawInput, state->throttle, MIN_THROTTLE, MAX_THROTTLE);
+}
+
+static bool int16MixTable(const refMixerConfig_t *config, uint8_t motorCount, const benchState_t *state)
+{
+    const int16_t tpaFactor = tpaCurve[(uint8_t)(state->throttleP * (TPA_LENGTH - 1) + 0.5f)];
+    return refMixTable(motors, config, motorCount, state->throttleP, tpaFactor, state->pidP, state->pidI, state->pidD, state->throttle);
+}
+
+static void benchMixer(const char *name, const motorMixer_t *mixer, uint8_t motorCount, uint8_t mixerFixer)
+{
+    static mixerMatrixRow_t matrix[MAX_SUPPORTED_MOTORS];
+    static motorMixer_t padded[MAX_SUPPORTED_MOTORS];
+    refMixerConfig_t config = { padded, mixerFixer, 0.95f, 1, MIN_THROTTLE, MAX_THROTTLE };
+    int16_t expected[MAX_SUPPORTED_MOTORS];
+    int maxError = 0, limited = 0;
+    int i, j;
+
+    for (i = 0; i < MAX_SUPPORTED_MOTORS; i++)
+        padded[i] = i < motorCount ? mixer[i] : (motorMixer_t){ 0 };
+    mixerMatrixBuild(matrix, padded, mixerFixer, config.foreAftMixerFixerStrength, config.yawMotorDirection, MIN_THROTTLE, MAX_THROTTLE);
+
+    for (i = 0; i < STATES; i++) {
+        limited += int16MixTable(&config, motorCount, &states[i]);
+        for (j = 0; j < motorCount; j++)
+            expected[j] = motors[j];
+        matrixMixTable(matrix, motorCount, &states[i]);
+        for (j = 0; j < motorCount; j++)
+            maxError = MAX(maxError, abs(motors[j] - expected[j]));
+    }
+    printf("%s: %d motors, %d%% of states saturate, max difference %d us\n", name, motorCount, limited * 100 / STATES, maxError);
+
+    BENCH_RUN("  int16 mix + mixerFixer remap", ITERATIONS, {
+        int16MixTable(&config, motorCount, &states[benchIter & (STATES - 1)]);
+        sink = motors[0];
+    });
+    BENCH_RUN("  float matrix, one-pass desaturation", ITERATIONS, {
+        matrixMixTable(matrix, motorCount, &states[benchIter & (STATES - 1)]);
+        sink = motors[0];
+    });
+}
+
+int main(void)
+{
+    uint32_t seed = 0x3141592;
+    int i, axis;
+
+    for (i = 0; i < TPA_LENGTH; i++)
+        tpaCurve[i] = i < 50 ? 100 : 100 - (i - 50) * 30 / 50;
+    for (i = 0; i < STATES; i++) {
+        for (axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            states[i].pidP[axis] = (int32_t)(benchRandom(&seed) % 801) - 400;
+            states[i].pidI[axis] = (int32_t)(benchRandom(&seed) % 101) - 50;
+            states[i].pidD[axis] = (int32_t)(benchRandom(&seed) % 201) - 100;
+        }
+        states[i].throttle = MIN_THROTTLE + benchRandom(&seed) % (MAX_THROTTLE - MIN_THROTTLE + 1);
+        states[i].throttleP = (states[i].throttle - MIN_THROTTLE) / (float)(MAX_THROTTLE - MIN_THROTTLE);
+    }
+
+    benchMixer("QUADX (mixerFixer 1)", mixerQuadXL, 4, 1);
+    benchMixer("HEX6X", mixerHex6X, 6, 0);
+    benchMixer("OCTOX8", mixerOctoX8, 8, 0);
+    return 0;
+}
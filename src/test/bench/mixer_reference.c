@@ -0,0 +1,61 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/axis.h"
+#include "common/maths.h"
+
+#include "mixer_reference.h"
+
+bool refMixTable(int16_t *motors, const refMixerConfig_t *config, uint8_t motorCount, float throttleP, int16_t tpaFactor,
+    const int32_t *pidP, const int32_t *pidI, const int32_t *pidD, int16_t throttle)
+{
+    static int32_t throttleToKiAverage[11];
+    static int16_t mixReduction;
+    uint32_t i;
+    bool motorLimitReached;
+    int16_t rollPitchYawMix[MAX_SUPPORTED_MOTORS];
+    int16_t rollPitchYawMixMax = 0;
+    int16_t rollPitchYawMixMin = 0;
+    float OldRange, OldValue, NewRange, OldMax, OldMin, NewMax, NewMin;
+    for (i = 0; i < motorCount; i++) {
+        uint8_t throttleTen = (uint8_t)(throttleP * 10.0f);
+        throttleToKiAverage[throttleTen] = (int32_t)((throttleToKiAverage[throttleTen] + pidI[FD_PITCH]) / 2);
+        rollPitchYawMix[i] =
+            (((tpaFactor * (pidP[FD_PITCH] + pidD[FD_PITCH]) / 100) + pidI[FD_PITCH])) * config->mixer[i].pitch +
+            (((tpaFactor * (pidP[FD_ROLL] + pidD[FD_ROLL]) / 100) + pidI[FD_ROLL])) * config->mixer[i].roll +
+            -config->yawMotorDirection * (pidP[FD_YAW] + pidD[FD_YAW] + pidI[FD_YAW]) * config->mixer[i].yaw;
+        if (rollPitchYawMix[i] > rollPitchYawMixMax) rollPitchYawMixMax = rollPitchYawMix[i];
+        if (rollPitchYawMix[i] < rollPitchYawMixMin) rollPitchYawMixMin = rollPitchYawMix[i];
+    }
+    int16_t rollPitchYawMixRange = rollPitchYawMixMax - rollPitchYawMixMin;
+    int16_t throttleMin = config->minthrottle;
+    int16_t throttleMax = config->maxthrottle;
+    int16_t throttleRange = throttleMax - throttleMin;
+    if (rollPitchYawMixRange > throttleRange) {
+        motorLimitReached = true;
+        mixReduction = (throttleRange << 12) / rollPitchYawMixRange;
+        for (i = 0; i < motorCount; i++) {
+            rollPitchYawMix[i] = ((mixReduction * rollPitchYawMix[i]) >> 12);
+        }
+        throttleMin = throttleMax = throttleMin + (throttleRange / 2);
+    } else {
+        motorLimitReached = false;
+        throttleMin = throttleMin + (rollPitchYawMixRange / 2);
+        throttleMax = throttleMax - (rollPitchYawMixRange / 2);
+    }
+    for (i = 0; i < motorCount; i++) {
+        uint16_t currentMixerThrottle = throttle;
+        if ((config->mixerFixer == 1 && (i == 1 || i == 3)) || (config->mixerFixer == 2 && (i == 0 || i == 1))) {
+            OldMax = config->maxthrottle;
+            OldMin = config->minthrottle;
+            NewMax = (uint16_t)((float)config->maxthrottle * config->foreAftMixerFixerStrength);
+            NewMin = config->minthrottle;
+            OldValue = throttle;
+            OldRange = (OldMax - OldMin);
+            NewRange = (NewMax - NewMin);
+            currentMixerThrottle = (((OldValue - OldMin) * NewRange) / OldRange) + NewMin;
+        }
+        motors[i] = rollPitchYawMix[i] + constrain(currentMixerThrottle * config->mixer[i].throttle, throttleMin, throttleMax);
+    }
+    return motorLimitReached;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+// mixTable's roll/pitch/yaw mix and desaturation as they were before the
+// precomputed matrix: int16 mix, a fixed-point rescale pass and the
+// per-motor mixerFixer throttle remap.
+
+#include <stdint.h>
+
+#include "flight/mixer.h"
+
+typedef struct refMixerConfig_s {
+    const motorMixer_t *mixer;
+    uint8_t mixerFixer;
+    float foreAftMixerFixerStrength;
+    int8_t yawMotorDirection;
+    uint16_t minthrottle;
+    uint16_t maxthrottle;
+} refMixerConfig_t;
+
+bool refMixTable(int16_t *motors, const refMixerConfig_t *config, uint8_t motorCount, float throttleP, int16_t tpaFactor,
+    const int32_t *pidP, const int32_t *pidI, const int32_t *pidD, int16_t throttle);
@@ -0,0 +1,66 @@
+#include <stdint.h>
+
+#include "rx/packed_channels.h"
+
+#include "bench.h"
+#include "sbus_reference.h"
+
+#define FRAMES 256
+#define ITERATIONS 2000000
+#define SBUS_CHANNEL_SCALE 40960
+#define SBUS_CHANNEL_OFFSET 880
+
+typedef uint16_t (*readRawFn)(uint8_t chan);
+
+static sbusReferenceFrame_t frames[FRAMES];
+static uint32_t referenceData[16];
+static uint16_t channelData[16];
+static volatile uint32_t sink;
+
+static uint16_t __attribute__((noinline)) referenceReadRaw(uint8_t chan)
+{
+    return sbusReferenceScale(referenceData[chan]);
+}
+
+static uint16_t __attribute__((noinline)) packedReadRaw(uint8_t chan)
+{
+    return channelData[chan];
+}
+
+static uint32_t readAll(readRawFn readRaw)
+{
+    uint32_t sum = 0;
+    uint8_t chan;
+    for (chan = 0; chan < 16; chan++)
+        sum += readRaw(chan);
+    return sum;
+}
+
+int main(void)
+{
+    readRawFn volatile referenceRead = referenceReadRaw;
+    readRawFn volatile packedRead = packedReadRaw;
+    uint32_t seed = 0xcafe;
+    int i, j;
+    for (i = 0; i < FRAMES; i++)
+        for (j = 0; j < 25; j++)
+            frames[i].bytes[j] = benchRandom(&seed);
+
+    BENCH_RUN("bitfield decode + float readRawRC", ITERATIONS, {
+        sbusReferenceDecode(&frames[benchIter & (FRAMES - 1)], referenceData);
+        sink = readAll(referenceRead);
+    });
+    BENCH_RUN("rxUnpack11BitChannels + readRawRC", ITERATIONS, {
+        rxUnpack11BitChannels(frames[benchIter & (FRAMES - 1)].bytes + 1, channelData, 16, SBUS_CHANNEL_SCALE, SBUS_CHANNEL_OFFSET);
+        sink = readAll(packedRead);
+    });
+    BENCH_RUN("bitfield decode only", ITERATIONS, {
+        sbusReferenceDecode(&frames[benchIter & (FRAMES - 1)], referenceData);
+        sink = referenceData[benchIter & 15];
+    });
+    BENCH_RUN("rxUnpack11BitChannels only", ITERATIONS, {
+        rxUnpack11BitChannels(frames[benchIter & (FRAMES - 1)].bytes + 1, channelData, 16, SBUS_CHANNEL_SCALE, SBUS_CHANNEL_OFFSET);
+        sink = channelData[benchIter & 15];
+    });
+    return 0;
+}
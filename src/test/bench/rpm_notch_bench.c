@@ -0,0 +1,86 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "include.h"
+#include "sensors/esc_telemetry.h"
+
+#undef printf
+#undef sprintf
+
+#include "bench.h"
+
+#define MOTORS 4
+#define HARMONICS 3
+#define ITERATIONS 2000000
+#define SAMPLES 1024
+
+void initRpmNotchFilters(void);
+void updateRpmNotchFilter(void);
+void applyRpmNotchFilters(void);
+
+uint8_t motorCount = MOTORS;
+uint32_t targetLooptime = 125;
+uint32_t targetESCwritetime = 125;
+uint32_t rcModeActivationMask;
+escTelemetry_t escTelemetry;
+profile_t *currentProfile;
+int32_t gyroShare[XYZ_AXIS_COUNT];
+
+bool escTelemetryIsEnabled(void) { return true; }
+void alignSensors(int16_t *src, int16_t *dest, uint8_t rotation) { (void)src; (void)dest; (void)rotation; }
+void beeper(beeperMode_e mode) { (void)mode; }
+
+static int16_t samples[SAMPLES][XYZ_AXIS_COUNT];
+static volatile float sink;
+
+static void notchFilterUpdateLibm(notchCoeffs_t *coeffs, float centerFreq, float q, float samplingRate)
+{
+    float omega = 2 * M_PI * centerFreq / samplingRate;
+    float sn = sinf(omega), cs = cosf(omega);
+    float alpha = sn / (2 * q);
+    float a0 = 1.0f / (1 + alpha);
+    coeffs->b0 = a0;
+    coeffs->b1 = -2 * cs * a0;
+    coeffs->a2 = (1 - alpha) * a0;
+}
+
+int main(void)
+{
+    static gyroConfig_t config = { .rpm_notch_harmonics = HARMONICS, .rpm_notch_q = 50, .rpm_notch_min_hz = 100 };
+    notchCoeffs_t coeffs;
+    uint32_t seed = 0x5eed;
+    int i, axis;
+
+    for (i = 0; i < SAMPLES; i++) {
+        for (axis = 0; axis < XYZ_AXIS_COUNT; axis++)
+            samples[i][axis] = (int16_t)(benchRandom(&seed) % 2001) - 1000;
+    }
+    for (i = 0; i < MOTORS; i++)
+        escTelemetry.motorHz[i] = 180.0f + 25.0f * i;
+
+    useGyroConfig(&config, 0);
+    initRpmNotchFilters();
+    for (i = 0; i < MOTORS * HARMONICS; i++)
+        updateRpmNotchFilter();
+
+    printf("8 kHz loop, %d motors x %d harmonics x %d axes = %d notches\n", MOTORS, HARMONICS, XYZ_AXIS_COUNT,
+        MOTORS * HARMONICS * XYZ_AXIS_COUNT);
+    BENCH_RUN("notchFilterUpdate (sin LUT)", ITERATIONS,
+        notchFilterUpdate(&coeffs, 150.0f + (benchIter & 1023), 5.0f, 8000.0f); sink = coeffs.b1);
+    BENCH_RUN("notch coefficients via sinf/cosf", ITERATIONS,
+        notchFilterUpdateLibm(&coeffs, 150.0f + (benchIter & 1023), 5.0f, 8000.0f); sink = coeffs.b1);
+    BENCH_RUN("updateRpmNotchFilter (one notch)", ITERATIONS, {
+        escTelemetry.motorHz[benchIter & (MOTORS - 1)] = 180.0f + (benchIter & 255);
+        updateRpmNotchFilter();
+    });
+    BENCH_RUN("applyRpmNotchFilters per gyro sample", ITERATIONS, {
+        escTelemetry.motorHz[benchIter & (MOTORS - 1)] = 180.0f + (benchIter & 255);
+        for (axis = 0; axis < XYZ_AXIS_COUNT; axis++)
+            gyroADC[axis] = samples[benchIter & (SAMPLES - 1)][axis];
+        applyRpmNotchFilters();
+        sink = gyroADC[0];
+    });
+    return 0;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+// Host-side reader for the burst capture stream described in
+// blackbox/blackbox_burst.h.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "blackbox/blackbox_burst.h"
+
+#define BURST_DECODE_GROUPS 5
+
+typedef struct burstDecodedSample_s {
+    bool keyframe;
+    int16_t gyroRaw[3];
+    int16_t gyroADC[3];
+    int16_t motor[BLACKBOX_BURST_MAX_MOTORS];
+    int16_t rcCommand[4];
+    int16_t accSmooth[3];
+} burstDecodedSample_t;
+
+typedef struct burstDecoder_s {
+    const uint8_t *data;
+    uint32_t length;
+    uint32_t pos;
+    uint8_t motorCount;
+    bool started;
+    burstDecodedSample_t previous;
+} burstDecoder_t;
+
+static inline void burstDecoderInit(burstDecoder_t *decoder, const uint8_t *data, uint32_t length, uint8_t motorCount)
+{
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->data = data;
+    decoder->length = length;
+    decoder->motorCount = motorCount;
+}
+
+static inline bool burstDecodeSignedVB(burstDecoder_t *decoder, int32_t *value)
+{
+    uint32_t zigzag = 0;
+    uint8_t shift;
+    for (shift = 0; shift < 32; shift += 7) {
+        uint8_t c;
+        if (decoder->pos >= decoder->length)
+            return false;
+        c = decoder->data[decoder->pos++];
+        zigzag |= (uint32_t)(c & 0x7F) << shift;
+        if (!(c & 0x80)) {
+            *value = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline bool burstDecodeGroup(burstDecoder_t *decoder, int16_t *values, uint8_t count)
+{
+    uint8_t mask, i;
+    if (decoder->pos >= decoder->length)
+        return false;
+    mask = decoder->data[decoder->pos++];
+    if (!mask || (count < 8 && (mask >> count)))
+        return false;
+    for (i = 0; i < count; i++) {
+        int32_t delta;
+        if (!(mask & (1 << i)))
+            continue;
+        if (!burstDecodeSignedVB(decoder, &delta))
+            return false;
+        values[i] = (int16_t)(values[i] + delta);
+    }
+    return true;
+}
+
+// Returns 1 for a decoded sample, 0 at the end of the stream and -1 on a
+// malformed stream (including one that does not start on a keyframe).
+static inline int burstDecodeNext(burstDecoder_t *decoder, burstDecodedSample_t *sample)
+{
+    int16_t *groups[BURST_DECODE_GROUPS];
+    const uint8_t counts[BURST_DECODE_GROUPS] = { 3, 3, decoder->motorCount, 4, 3 };
+    uint8_t tag, group;
+    if (decoder->pos >= decoder->length)
+        return 0;
+    tag = decoder->data[decoder->pos++];
+    if (tag & 0x60)
+        return -1;
+    if (tag & BLACKBOX_BURST_KEYFRAME) {
+        memset(&decoder->previous, 0, sizeof(decoder->previous));
+        decoder->started = true;
+    } else if (!decoder->started) {
+        return -1;
+    }
+    groups[0] = decoder->previous.gyroRaw;
+    groups[1] = decoder->previous.gyroADC;
+    groups[2] = decoder->previous.motor;
+    groups[3] = decoder->previous.rcCommand;
+    groups[4] = decoder->previous.accSmooth;
+    for (group = 0; group < BURST_DECODE_GROUPS; group++) {
+        if ((tag & (1 << group)) && !burstDecodeGroup(decoder, groups[group], counts[group]))
+            return -1;
+    }
+    decoder->previous.keyframe = (tag & BLACKBOX_BURST_KEYFRAME) != 0;
+    *sample = decoder->previous;
+    return 1;
+}
@@ -0,0 +1,311 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "include.h"
+#include "blackbox/blackbox_io.h"
+#include "blackbox/blackbox_burst.h"
+
+// include.h routes printf to the firmware's tfp_printf.
+#undef printf
+#undef sprintf
+
+#include "blackbox_burst_decode.h"
+#include "unittest.h"
+
+#define TEST_MOTORS 4
+#define TEST_MAX_SAMPLES 8192
+
+master_t masterConfig;
+gyro_t gyro;
+int16_t gyroADC[XYZ_AXIS_COUNT];
+int16_t gyroADCRaw[XYZ_AXIS_COUNT];
+int16_t accSmooth[XYZ_AXIS_COUNT];
+int16_t motor[MAX_SUPPORTED_MOTORS];
+float rcCommand[4];
+uint16_t acc_1G = 512;
+uint8_t armingFlags;
+uint32_t rcModeActivationMask;
+uint32_t targetLooptime = 1000;
+uint16_t cycleTime = 1000;
+uint8_t motorCount = TEST_MOTORS;
+
+static uint32_t fakeMicros;
+static uint32_t captureCount;
+static burstDecodedSample_t captured[TEST_MAX_SAMPLES];
+static burstDecodedSample_t decoded[TEST_MAX_SAMPLES];
+static uint8_t stream[BLACKBOX_BURST_BUFFER_SIZE];
+
+uint32_t micros(void) { return fakeMicros; }
+bool sensors(uint32_t mask) { UNUSED(mask); return false; }
+bool failsafeIsActive(void) { return false; }
+
+typedef enum {
+    SIGNAL_QUIET,
+    SIGNAL_FLIGHT,
+    SIGNAL_NOISE
+} testSignal_e;
+
+static uint32_t noiseState = 0x12345678;
+
+static int16_t noise(int16_t range)
+{
+    noiseState ^= noiseState << 13;
+    noiseState ^= noiseState >> 17;
+    noiseState ^= noiseState << 5;
+    return (int16_t)((int32_t)(noiseState % (2 * range + 1)) - range);
+}
+
+static void setInputs(testSignal_e signal, uint32_t n)
+{
+    int i;
+    for (i = 0; i < XYZ_AXIS_COUNT; i++) {
+        switch (signal) {
+            case SIGNAL_QUIET:
+                gyroADCRaw[i] = 0;
+                gyroADC[i] = i - 1;
+                accSmooth[i] = i == 2 ? 512 : 0;
+            break;
+            case SIGNAL_FLIGHT:
+                gyroADCRaw[i] = (int16_t)((n * (7 + i)) % 400) - 200 + noise(3);
+                gyroADC[i] = (int16_t)(gyroADCRaw[i] / 2);
+                accSmooth[i] = (n / 16) % 2 ? -300 * i : 300 * i;
+            break;
+            case SIGNAL_NOISE:
+                gyroADCRaw[i] = noise(32767);
+                gyroADC[i] = noise(32767);
+                accSmooth[i] = noise(32767);
+            break;
+        }
+    }
+    for (i = 0; i < MAX_SUPPORTED_MOTORS; i++) {
+        motor[i] = signal == SIGNAL_NOISE ? noise(32767) : 1000 + (int16_t)((n + 50 * i) % 1000);
+    }
+    for (i = 0; i < 4; i++) {
+        rcCommand[i] = signal == SIGNAL_QUIET ? 0.0f : (float)((int)(n % 500) - 250 * (i & 1));
+    }
+}
+
+static void recordInputs(burstDecodedSample_t *sample)
+{
+    int i;
+    memset(sample, 0, sizeof(*sample));
+    for (i = 0; i < XYZ_AXIS_COUNT; i++) {
+        sample->gyroRaw[i] = gyroADCRaw[i];
+        sample->gyroADC[i] = gyroADC[i];
+        sample->accSmooth[i] = accSmooth[i];
+    }
+    for (i = 0; i < TEST_MOTORS; i++) {
+        sample->motor[i] = motor[i];
+    }
+    for (i = 0; i < 4; i++) {
+        sample->rcCommand[i] = (int16_t)rcCommand[i];
+    }
+}
+
+static void reset(uint16_t pretriggerMs, uint16_t burstMs)
+{
+    memset(&masterConfig, 0, sizeof(masterConfig));
+    masterConfig.blackbox_device = BLACKBOX_DEVICE_FLASH;
+    masterConfig.blackbox_pretrigger_ms = pretriggerMs;
+    masterConfig.blackbox_burst_ms = burstMs;
+    masterConfig.blackbox_burst_denom = 1;
+    masterConfig.blackbox_trigger = BLACKBOX_TRIGGER_SWITCH;
+    armingFlags = ARMED;
+    rcModeActivationMask = 0;
+    captureCount = 0;
+    blackboxBurstInit();
+}
+
+static void runLoops(testSignal_e signal, uint32_t loops)
+{
+    while (loops-- && blackboxBurst.state != BLACKBOX_BURST_PENDING) {
+        fakeMicros += 1000;
+        setInputs(signal, captureCount);
+        blackboxBurstCapture();
+        if (blackboxBurst.state != BLACKBOX_BURST_PENDING) {
+            recordInputs(&captured[captureCount++]);
+        }
+    }
+}
+
+static void triggerAndFinish(testSignal_e signal)
+{
+    rcModeActivationMask = 1 << BOXBLACKBOXBURST;
+    runLoops(signal, TEST_MAX_SAMPLES - captureCount);
+    rcModeActivationMask = 0;
+}
+
+static uint32_t decodeStream(void)
+{
+    burstDecoder_t decoder;
+    const uint32_t length = blackboxBurst.head - blackboxBurst.tail;
+    uint32_t count = 0, i;
+    int result;
+    for (i = 0; i < length; i++) {
+        stream[i] = blackboxBurstRead(i);
+    }
+    burstDecoderInit(&decoder, stream, length, blackboxBurst.motorCount);
+    while (count < TEST_MAX_SAMPLES && (result = burstDecodeNext(&decoder, &decoded[count])) > 0) {
+        count++;
+    }
+    EXPECT_EQ(0, result);
+    EXPECT_EQ(length, decoder.pos);
+    return count;
+}
+
+static void expectRoundTrip(void)
+{
+    const uint32_t count = decodeStream();
+    uint32_t first, i, mismatches = 0, keyframes = 0;
+    EXPECT_EQ(BLACKBOX_BURST_PENDING, blackboxBurst.state);
+    EXPECT_EQ(blackboxBurst.samples, count);
+    EXPECT_TRUE(count > 0 && count <= captureCount);
+    if (count == 0 || count > captureCount) {
+        return;
+    }
+    first = captureCount - count;
+    for (i = 0; i < count; i++) {
+        burstDecodedSample_t expected = captured[first + i];
+        expected.keyframe = decoded[i].keyframe;
+        if (memcmp(&expected, &decoded[i], sizeof(expected))) {
+            mismatches++;
+        }
+        if (decoded[i].keyframe) {
+            EXPECT_EQ(0, i % BLACKBOX_BURST_KEYFRAME_INTERVAL);
+            keyframes++;
+        }
+    }
+    EXPECT_EQ(0, mismatches);
+    EXPECT_TRUE(decoded[0].keyframe);
+    EXPECT_EQ((count + BLACKBOX_BURST_KEYFRAME_INTERVAL - 1) / BLACKBOX_BURST_KEYFRAME_INTERVAL, keyframes);
+    EXPECT_EQ((count - 1) * 1000, blackboxBurst.duration);
+}
+
+static void testFlightRoundTrip(void)
+{
+    reset(100, 50);
+    runLoops(SIGNAL_FLIGHT, 300);
+    triggerAndFinish(SIGNAL_FLIGHT);
+    expectRoundTrip();
+    EXPECT_TRUE(blackboxBurst.pretrigger >= 100 * 1000);
+    EXPECT_TRUE(blackboxBurst.pretrigger < (100 + BLACKBOX_BURST_KEYFRAME_INTERVAL) * 1000);
+    EXPECT_EQ(blackboxBurst.pretrigger + 50 * 1000 - 1000, blackboxBurst.duration);
+    blackboxBurstRelease();
+}
+
+static void testQuietGroupsOmitted(void)
+{
+    reset(40, 10);
+    runLoops(SIGNAL_QUIET, 200);
+    triggerAndFinish(SIGNAL_QUIET);
+    expectRoundTrip();
+    EXPECT_EQ(BLACKBOX_BURST_KEYFRAME | 0x16, blackboxBurstRead(0));
+    blackboxBurstRelease();
+}
+
+static void testRingTrimmedBySize(void)
+{
+    reset(60000, 20);
+    runLoops(SIGNAL_NOISE, 2000);
+    EXPECT_TRUE(blackboxBurst.head > BLACKBOX_BURST_BUFFER_SIZE);
+    EXPECT_TRUE(blackboxBurst.head - blackboxBurst.tail <= BLACKBOX_BURST_BUFFER_SIZE);
+    triggerAndFinish(SIGNAL_NOISE);
+    expectRoundTrip();
+    EXPECT_TRUE(blackboxBurst.samples < 2000);
+    blackboxBurstRelease();
+}
+
+static void testRingTrimmedByKeyframeSlots(void)
+{
+    reset(60000, 10);
+    runLoops(SIGNAL_QUIET, BLACKBOX_BURST_KEYFRAME_SLOTS * BLACKBOX_BURST_KEYFRAME_INTERVAL * 2);
+    triggerAndFinish(SIGNAL_QUIET);
+    expectRoundTrip();
+    EXPECT_TRUE(blackboxBurst.samples <= BLACKBOX_BURST_KEYFRAME_SLOTS * BLACKBOX_BURST_KEYFRAME_INTERVAL);
+    blackboxBurstRelease();
+}
+
+static void testNoTriggersSkipsCapture(void)
+{
+    reset(100, 50);
+    masterConfig.blackbox_trigger = 0;
+    blackboxBurstInit();
+    runLoops(SIGNAL_FLIGHT, 200);
+    EXPECT_EQ(0, blackboxBurst.head);
+    blackboxBurstTrigger(BLACKBOX_TRIGGER_SWITCH);
+    EXPECT_EQ(BLACKBOX_BURST_IDLE, blackboxBurst.state);
+}
+
+static void testDisarmedSkipsPretrigger(void)
+{
+    reset(100, 50);
+    armingFlags = 0;
+    runLoops(SIGNAL_FLIGHT, 200);
+    EXPECT_EQ(0, blackboxBurst.head);
+    armingFlags = ARMED;
+    runLoops(SIGNAL_FLIGHT, 200);
+    EXPECT_TRUE(blackboxBurst.head > 0);
+    armingFlags = 0;
+    runLoops(SIGNAL_FLIGHT, 1);
+    EXPECT_EQ(0, blackboxBurst.head);
+    EXPECT_EQ(BLACKBOX_BURST_IDLE, blackboxBurst.state);
+}
+
+static void testArmTriggerKeepsPreArmHistory(void)
+{
+    reset(100, 50);
+    masterConfig.blackbox_trigger = BLACKBOX_TRIGGER_ARM;
+    armingFlags = 0;
+    runLoops(SIGNAL_FLIGHT, 200);
+    EXPECT_TRUE(blackboxBurst.head > 0);
+    armingFlags = ARMED;
+    blackboxBurstTrigger(BLACKBOX_TRIGGER_ARM);
+    expectRoundTrip();
+    EXPECT_TRUE(blackboxBurst.pretrigger >= 100 * 1000);
+    blackboxBurstRelease();
+}
+
+static void testDecoderRejectsMissingKeyframe(void)
+{
+    const uint8_t data[] = { 0x01, 0x01, 0x02 };
+    burstDecoder_t decoder;
+    burstDecodedSample_t sample;
+    burstDecoderInit(&decoder, data, sizeof(data), TEST_MOTORS);
+    EXPECT_EQ(-1, burstDecodeNext(&decoder, &sample));
+}
+
+static void testDecoderVarints(void)
+{
+    const uint8_t data[] = {
+        BLACKBOX_BURST_KEYFRAME | 0x01, 0x07, 0x01, 0xFE, 0xFF, 0x03, 0xFF, 0xFF, 0x03,
+        0x01, 0x02, 0x01
+    };
+    burstDecoder_t decoder;
+    burstDecodedSample_t sample;
+    burstDecoderInit(&decoder, data, sizeof(data), TEST_MOTORS);
+    EXPECT_EQ(1, burstDecodeNext(&decoder, &sample));
+    EXPECT_TRUE(sample.keyframe);
+    EXPECT_EQ(-1, sample.gyroRaw[0]);
+    EXPECT_EQ(32767, sample.gyroRaw[1]);
+    EXPECT_EQ(-32768, sample.gyroRaw[2]);
+    EXPECT_EQ(1, burstDecodeNext(&decoder, &sample));
+    EXPECT_TRUE(!sample.keyframe);
+    EXPECT_EQ(32766, sample.gyroRaw[1]);
+    EXPECT_EQ(-32768, sample.gyroRaw[2]);
+    EXPECT_EQ(0, burstDecodeNext(&decoder, &sample));
+}
+
+int main(void)
+{
+    RUN_TEST(testFlightRoundTrip);
+    RUN_TEST(testQuietGroupsOmitted);
+    RUN_TEST(testRingTrimmedBySize);
+    RUN_TEST(testRingTrimmedByKeyframeSlots);
+    RUN_TEST(testNoTriggersSkipsCapture);
+    RUN_TEST(testDisarmedSkipsPretrigger);
+    RUN_TEST(testArmTriggerKeepsPreArmHistory);
+    RUN_TEST(testDecoderRejectsMissingKeyframe);
+    RUN_TEST(testDecoderVarints);
+    return UNITTEST_RESULT();
+}
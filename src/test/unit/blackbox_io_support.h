@@ -0,0 +1,71 @@
+#pragma once
+
+// Link-time stubs for blackbox/blackbox_io.c. Flash and serial output both
+// land in testOutput.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "include.h"
+#include "blackbox/blackbox_io.h"
+#include "io/flashfs.h"
+
+// include.h routes printf to the firmware's tfp_printf.
+#undef printf
+#undef sprintf
+
+#define TEST_OUTPUT_SIZE 65536
+
+master_t masterConfig;
+const uint32_t baudRates[] = { 0, 9600, 19200, 38400, 57600, 115200, 230400, 250000 };
+uint32_t targetESCwritetime = 1000;
+
+uint8_t testOutput[TEST_OUTPUT_SIZE];
+uint32_t testOutputLength;
+
+// Wraps when full so benchmarks can write forever; tests stay well below it.
+static void testOutputAppend(const uint8_t *data, unsigned int length)
+{
+    if (testOutputLength + length > TEST_OUTPUT_SIZE)
+        testOutputLength = 0;
+    memcpy(testOutput + testOutputLength, data, length);
+    testOutputLength += length;
+}
+
+void flashfsWriteByte(uint8_t byte) { testOutputAppend(&byte, 1); }
+void flashfsWrite(const uint8_t *data, unsigned int len, bool sync) { UNUSED(sync); testOutputAppend(data, len); }
+bool flashfsFlushAsync(void) { return true; }
+bool flashfsIsEOF(void) { return false; }
+uint32_t flashfsGetSize(void) { return TEST_OUTPUT_SIZE; }
+uint32_t flashfsGetWriteBufferSize(void) { return TEST_OUTPUT_SIZE; }
+uint32_t flashfsGetWriteBufferFreeSpace(void) { return TEST_OUTPUT_SIZE; }
+
+static void testSerialWrite(serialPort_t *instance, uint8_t ch) { UNUSED(instance); testOutputAppend(&ch, 1); }
+static uint8_t testSerialTxFree(serialPort_t *instance) { UNUSED(instance); return 255; }
+static bool testSerialTxEmpty(serialPort_t *instance) { UNUSED(instance); return true; }
+
+static const struct serialPortVTable testSerialVTable = {
+    .serialWrite = testSerialWrite,
+    .serialTotalTxFree = testSerialTxFree,
+    .isSerialTransmitBufferEmpty = testSerialTxEmpty,
+};
+serialPort_t testSerialPort = { .vTable = &testSerialVTable };
+static serialPortConfig_t testSerialPortConfig;
+
+serialPortConfig_t *findSerialPortConfig(serialPortFunction_e function) { UNUSED(function); return &testSerialPortConfig; }
+portSharing_e determinePortSharing(serialPortConfig_t *portConfig, serialPortFunction_e function) { UNUSED(portConfig); UNUSED(function); return PORTSHARING_NOT_SHARED; }
+serialPort_t *openSerialPort(serialPortIdentifier_e identifier, serialPortFunction_e function, serialReceiveCallbackPtr callback, uint32_t baudrate, portMode_t mode, portOptions_t options)
+{
+    UNUSED(identifier); UNUSED(function); UNUSED(callback); UNUSED(baudrate); UNUSED(mode); UNUSED(options);
+    return &testSerialPort;
+}
+void closeSerialPort(serialPort_t *serialPort) { UNUSED(serialPort); }
+void mspAllocateSerialPorts(serialConfig_t *serialConfig) { UNUSED(serialConfig); }
+
+static inline void testBlackboxOpen(uint8_t device)
+{
+    masterConfig.blackbox_device = device;
+    testOutputLength = 0;
+    blackboxDeviceOpen();
+}
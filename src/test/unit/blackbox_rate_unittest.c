@@ -0,0 +1,184 @@
+#include "blackbox_io_support.h"
+#include "blackbox/blackbox_burst.h"
+#include "version.h"
+
+#include "unittest.h"
+
+#define BLACKBOX_I_INTERVAL 32
+
+void validateBlackboxConfig(void);
+bool blackboxGroupDue(uint32_t *nextDue, uint16_t hz, uint32_t now);
+
+extern uint32_t hidden_denom;
+
+int32_t axisPID_P[3], axisPID_I[3], axisPID_D[3], axisPID_F[3];
+int16_t gyroADC[XYZ_AXIS_COUNT];
+int16_t accSmooth[XYZ_AXIS_COUNT];
+int16_t debug[DEBUG16_VALUE_COUNT];
+int16_t motor[MAX_SUPPORTED_MOTORS];
+float rcCommand[4];
+float rcCommandUsed[4];
+uint16_t acc_1G = 512;
+uint16_t vbatLatestADC;
+uint16_t amperageLatestADC;
+uint16_t rssi;
+uint8_t armingFlags;
+uint8_t stateFlags;
+uint16_t flightModeFlags;
+uint32_t rcModeActivationMask;
+uint32_t currentTime;
+uint8_t motorCount = 4;
+gyro_t gyro;
+profile_t *currentProfile;
+escTelemetry_t escTelemetry;
+rxFrameStats_t rxFrameStats;
+blackboxBurst_t blackboxBurst;
+const char * const shortGitRevision = "test";
+const char * const buildDate = "Jan  1 2000";
+const char * const buildTime = "00:00:00";
+
+uint32_t micros(void) { return 0; }
+uint32_t millis(void) { return 0; }
+bool feature(uint32_t mask) { UNUSED(mask); return false; }
+bool escTelemetryIsEnabled(void) { return false; }
+uint32_t getArmingBeepTimeMicros(void) { return 0; }
+bool isModeActivationConditionPresent(modeActivationCondition_t *modeActivationConditions, boxId_e modeId) { UNUSED(modeActivationConditions); UNUSED(modeId); return false; }
+failsafePhase_e failsafePhase(void) { return FAILSAFE_IDLE; }
+bool rxIsReceivingSignal(void) { return true; }
+bool rxAreFlightChannelsValid(void) { return true; }
+void blackboxBurstInit(void) { }
+void blackboxBurstTrigger(uint8_t trigger) { UNUSED(trigger); }
+uint8_t blackboxBurstRead(uint32_t offset) { UNUSED(offset); return 0; }
+void blackboxBurstRelease(void) { }
+
+static uint32_t denomFor(uint16_t rateHz, uint32_t escWriteTime)
+{
+    masterConfig.blackbox_rate_num = 1;
+    masterConfig.blackbox_rate_denom = 1;
+    masterConfig.blackbox_rate_hz = rateHz;
+    targetESCwritetime = escWriteTime;
+    validateBlackboxConfig();
+    return hidden_denom;
+}
+
+static void testDenomDefaultsWithoutRate(void)
+{
+    EXPECT_EQ(8, denomFor(0, 125));
+    EXPECT_EQ(8, denomFor(0, 1000));
+}
+
+static void testDenomMatchesRateAtLoopRate(void)
+{
+    // 8 kHz loop
+    EXPECT_EQ(1, denomFor(8000, 125));
+    EXPECT_EQ(2, denomFor(4000, 125));
+    EXPECT_EQ(4, denomFor(2000, 125));
+    EXPECT_EQ(8, denomFor(1000, 125));
+    EXPECT_EQ(16, denomFor(500, 125));
+    // 1 kHz loop
+    EXPECT_EQ(1, denomFor(1000, 1000));
+    EXPECT_EQ(2, denomFor(500, 1000));
+}
+
+static void testDenomRoundsToNearest(void)
+{
+    EXPECT_EQ(3, denomFor(3000, 125));
+    EXPECT_EQ(3, denomFor(2500, 125));
+    EXPECT_EQ(2, denomFor(3300, 125));
+    EXPECT_EQ(5, denomFor(1500, 125));
+}
+
+static void testDenomIsClamped(void)
+{
+    EXPECT_EQ(1, denomFor(32000, 125));
+    EXPECT_EQ(BLACKBOX_I_INTERVAL, denomFor(100, 125));
+    EXPECT_EQ(BLACKBOX_I_INTERVAL, denomFor(1, 125));
+    // no ESC write time yet only guards the division
+    EXPECT_EQ(BLACKBOX_I_INTERVAL, denomFor(1000, 0));
+}
+
+static void testDenomForcesUnitRateNum(void)
+{
+    masterConfig.blackbox_rate_num = 3;
+    masterConfig.blackbox_rate_denom = 4;
+    masterConfig.blackbox_rate_hz = 1000;
+    targetESCwritetime = 125;
+    validateBlackboxConfig();
+    EXPECT_EQ(1, masterConfig.blackbox_rate_num);
+    EXPECT_EQ(8, hidden_denom);
+}
+
+static void testGroupWithoutRateIsAlwaysDue(void)
+{
+    uint32_t nextDue = 5000;
+    EXPECT_TRUE(blackboxGroupDue(&nextDue, 0, 0));
+    EXPECT_TRUE(blackboxGroupDue(&nextDue, 0, 1));
+    EXPECT_EQ(5000, nextDue);
+}
+
+static void testGroupIsDueOncePerPeriod(void)
+{
+    uint32_t nextDue = 1000;
+    uint32_t now;
+    int due = 0;
+    for (now = 1000; now < 1000 + 100 * 1000; now += 125) {
+        if (blackboxGroupDue(&nextDue, 1000, now)) {
+            EXPECT_EQ(0, (now - 1000) % 1000);
+            due++;
+        }
+    }
+    EXPECT_EQ(100, due);
+}
+
+static void testGroupKeepsPhaseWhenSlightlyLate(void)
+{
+    // 300 Hz does not divide the 125 us loop, so due frames land late; the
+    // schedule must advance from the due time, not from the late frame.
+    uint32_t nextDue = 0;
+    uint32_t now;
+    int due = 0;
+    for (now = 0; now < 1000000; now += 125) {
+        due += blackboxGroupDue(&nextDue, 300, now);
+    }
+    EXPECT_EQ(300, due);
+}
+
+static void testGroupCatchesUpWithoutBurst(void)
+{
+    uint32_t nextDue = 1000;
+    EXPECT_TRUE(blackboxGroupDue(&nextDue, 1000, 10500));
+    EXPECT_EQ(11500, nextDue);
+    EXPECT_TRUE(!blackboxGroupDue(&nextDue, 1000, 10625));
+    EXPECT_TRUE(!blackboxGroupDue(&nextDue, 1000, 11375));
+    EXPECT_TRUE(blackboxGroupDue(&nextDue, 1000, 11500));
+    EXPECT_EQ(12500, nextDue);
+}
+
+static void testGroupSurvivesTimerWrap(void)
+{
+    uint32_t nextDue = 0xFFFFFC18;
+    uint32_t now = 0xFFFFFC18;
+    int due = 0;
+    int i;
+    for (i = 0; i < 80; i++, now += 125) {
+        due += blackboxGroupDue(&nextDue, 1000, now);
+    }
+    EXPECT_EQ(10, due);
+    EXPECT_EQ(9000, nextDue);
+    EXPECT_TRUE(!blackboxGroupDue(&nextDue, 1000, 0xFFFFFFF0));
+}
+
+int main(void)
+{
+    RUN_TEST(testDenomDefaultsWithoutRate);
+    RUN_TEST(testDenomMatchesRateAtLoopRate);
+    RUN_TEST(testDenomRoundsToNearest);
+    RUN_TEST(testDenomIsClamped);
+    RUN_TEST(testDenomForcesUnitRateNum);
+    RUN_TEST(testGroupWithoutRateIsAlwaysDue);
+    RUN_TEST(testGroupIsDueOncePerPeriod);
+    RUN_TEST(testGroupKeepsPhaseWhenSlightlyLate);
+    RUN_TEST(testGroupCatchesUpWithoutBurst);
+    RUN_TEST(testGroupSurvivesTimerWrap);
+    return UNITTEST_RESULT();
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+// Host-side reader for the adaptive Rice bit blocks written by
+// blackboxWriteRiceSigned in blackbox/blackbox_io.c.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define RICE_DECODE_ESCAPE 16
+#define RICE_DECODE_RESET 32
+#define RICE_DECODE_MAX_K 24
+
+typedef struct riceDecodeState_s {
+    uint32_t sum;
+    uint8_t count;
+} riceDecodeState_t;
+
+typedef struct riceDecoder_s {
+    const uint8_t *data;
+    uint32_t length;
+    uint32_t bitPos;
+} riceDecoder_t;
+
+static inline void riceDecoderInit(riceDecoder_t *decoder, const uint8_t *data, uint32_t length)
+{
+    decoder->data = data;
+    decoder->length = length;
+    decoder->bitPos = 0;
+}
+
+static inline void riceDecodeReset(riceDecodeState_t *state, int count)
+{
+    int i;
+    for (i = 0; i < count; i++) {
+        state[i].sum = 4;
+        state[i].count = 1;
+    }
+}
+
+static inline uint8_t riceDecodeK(const riceDecodeState_t *state)
+{
+    uint8_t k = 0;
+    while (k < RICE_DECODE_MAX_K && ((uint32_t)state->count << k) < state->sum)
+        k++;
+    return k;
+}
+
+static inline bool riceReadBits(riceDecoder_t *decoder, uint8_t count, uint32_t *value)
+{
+    *value = 0;
+    if (decoder->bitPos + count > decoder->length * 8)
+        return false;
+    while (count--) {
+        uint8_t byte = decoder->data[decoder->bitPos >> 3];
+        *value = (*value << 1) | ((byte >> (7 - (decoder->bitPos & 7))) & 1);
+        decoder->bitPos++;
+    }
+    return true;
+}
+
+static inline bool riceDecodeSigned(riceDecoder_t *decoder, riceDecodeState_t *state, int32_t *value)
+{
+    const uint8_t k = riceDecodeK(state);
+    uint32_t quotient = 0, bit, low, high, unsignedValue;
+    for (;;) {
+        if (!riceReadBits(decoder, 1, &bit))
+            return false;
+        if (!bit)
+            break;
+        if (++quotient == RICE_DECODE_ESCAPE)
+            break;
+    }
+    if (quotient == RICE_DECODE_ESCAPE) {
+        if (!riceReadBits(decoder, 16, &high) || !riceReadBits(decoder, 16, &low))
+            return false;
+        unsignedValue = (high << 16) | low;
+    } else {
+        if (!riceReadBits(decoder, k, &low))
+            return false;
+        unsignedValue = (quotient << k) | low;
+    }
+    *value = (int32_t)(unsignedValue >> 1) ^ -(int32_t)(unsignedValue & 1);
+    state->sum += unsignedValue < 0xFFFF ? unsignedValue : 0xFFFF;
+    if (++state->count >= RICE_DECODE_RESET) {
+        state->sum >>= 1;
+        state->count >>= 1;
+    }
+    return true;
+}
+
+// The writer pads each P-frame's block with zero bits to a byte boundary.
+static inline bool riceDecodeAlign(riceDecoder_t *decoder)
+{
+    uint32_t padding;
+    if (!(decoder->bitPos & 7))
+        return true;
+    return riceReadBits(decoder, 8 - (decoder->bitPos & 7), &padding) && padding == 0;
+}
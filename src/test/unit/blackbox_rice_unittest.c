@@ -0,0 +1,170 @@
+#include "blackbox_io_support.h"
+#include "blackbox_rice_decode.h"
+#include "unittest.h"
+
+#define FIELDS 13
+#define FRAMES 512
+#define I_INTERVAL 32
+
+static int32_t values[FRAMES][FIELDS];
+static uint32_t frameEnd[FRAMES];
+
+static void encodeFrames(int frames)
+{
+    blackboxRiceState_t state[FIELDS];
+    int frame, i;
+    testBlackboxOpen(BLACKBOX_DEVICE_FLASH);
+    for (frame = 0; frame < frames; frame++) {
+        if (frame % I_INTERVAL == 0)
+            blackboxRiceReset(state, FIELDS);
+        for (i = 0; i < FIELDS; i++)
+            blackboxWriteRiceSigned(values[frame][i], &state[i]);
+        blackboxRiceFlush();
+        blackboxFrameFlush();
+        frameEnd[frame] = testOutputLength;
+    }
+}
+
+static int decodeFrames(int firstFrame, int frames)
+{
+    riceDecoder_t decoder;
+    riceDecodeState_t state[FIELDS];
+    const uint32_t start = firstFrame ? frameEnd[firstFrame - 1] : 0;
+    int frame, i, mismatches = 0;
+    riceDecoderInit(&decoder, testOutput + start, testOutputLength - start);
+    for (frame = firstFrame; frame < frames; frame++) {
+        if (frame % I_INTERVAL == 0)
+            riceDecodeReset(state, FIELDS);
+        for (i = 0; i < FIELDS; i++) {
+            int32_t value;
+            if (!riceDecodeSigned(&decoder, &state[i], &value) || value != values[frame][i])
+                mismatches++;
+        }
+        EXPECT_TRUE(riceDecodeAlign(&decoder));
+        EXPECT_EQ(frameEnd[frame] - start, decoder.bitPos / 8);
+    }
+    return mismatches;
+}
+
+static void fillRandom(int frames, uint32_t seed, int32_t range)
+{
+    int frame, i;
+    for (frame = 0; frame < frames; frame++) {
+        for (i = 0; i < FIELDS; i++) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            values[frame][i] = (int32_t)(seed % (2 * range + 1)) - range;
+        }
+    }
+}
+
+static void testKnownBits(void)
+{
+    blackboxRiceState_t state;
+    testBlackboxOpen(BLACKBOX_DEVICE_FLASH);
+    blackboxRiceReset(&state, 1);
+    blackboxWriteRiceSigned(0, &state);
+    blackboxRiceFlush();
+    blackboxRiceReset(&state, 1);
+    blackboxWriteRiceSigned(1, &state);
+    blackboxRiceFlush();
+    blackboxRiceReset(&state, 1);
+    blackboxWriteRiceSigned(-3, &state);
+    blackboxRiceFlush();
+    blackboxFrameFlush();
+    EXPECT_EQ(3, testOutputLength);
+    EXPECT_EQ(0x00, testOutput[0]);
+    EXPECT_EQ(0x40, testOutput[1]);
+    EXPECT_EQ(0x90, testOutput[2]);
+}
+
+static void testEscapeBits(void)
+{
+    blackboxRiceState_t state;
+    testBlackboxOpen(BLACKBOX_DEVICE_FLASH);
+    blackboxRiceReset(&state, 1);
+    blackboxWriteRiceSigned(64, &state);
+    blackboxRiceFlush();
+    blackboxFrameFlush();
+    EXPECT_EQ(6, testOutputLength);
+    EXPECT_EQ(0xFF, testOutput[0]);
+    EXPECT_EQ(0xFF, testOutput[1]);
+    EXPECT_EQ(0x00, testOutput[2]);
+    EXPECT_EQ(0x00, testOutput[3]);
+    EXPECT_EQ(0x00, testOutput[4]);
+    EXPECT_EQ(0x80, testOutput[5]);
+}
+
+static void testSmallResiduals(void)
+{
+    fillRandom(FRAMES, 0x1234, 20);
+    encodeFrames(FRAMES);
+    EXPECT_EQ(0, decodeFrames(0, FRAMES));
+}
+
+static void testEscapes(void)
+{
+    const int32_t extremes[] = { INT32_MIN, INT32_MAX, -1, 0, 64, -65, 65535, -65536, 1 << 24, INT16_MIN };
+    int frame, i;
+    fillRandom(FRAMES, 0x5678, 3);
+    for (frame = 0; frame < FRAMES; frame += 7) {
+        for (i = 0; i < FIELDS; i++)
+            values[frame][i] = extremes[(frame + i) % ARRAYLEN(extremes)];
+    }
+    encodeFrames(FRAMES);
+    EXPECT_EQ(0, decodeFrames(0, FRAMES));
+}
+
+static void testAdaptation(void)
+{
+    blackboxRiceState_t state;
+    uint32_t before;
+    int i;
+    testBlackboxOpen(BLACKBOX_DEVICE_FLASH);
+    blackboxRiceReset(&state, 1);
+    for (i = 0; i < RICE_DECODE_RESET - 1; i++)
+        blackboxWriteRiceSigned(3000, &state);
+    EXPECT_EQ(RICE_DECODE_RESET / 2, state.count);
+    EXPECT_EQ((4 + (RICE_DECODE_RESET - 1) * 6000) / 2, state.sum);
+    blackboxRiceFlush();
+    blackboxFrameFlush();
+    before = testOutputLength;
+    blackboxWriteRiceSigned(3000, &state);
+    blackboxRiceFlush();
+    blackboxFrameFlush();
+    EXPECT_TRUE(testOutputLength - before <= 2);
+
+    fillRandom(FRAMES, 0x9abc, 4);
+    for (i = 0; i < FIELDS; i++) {
+        values[40][i] = values[41][i] = values[42][i] = 20000;
+        values[100][i] = -30000;
+    }
+    encodeFrames(FRAMES);
+    EXPECT_EQ(0, decodeFrames(0, FRAMES));
+}
+
+static void testIFrameResetResyncs(void)
+{
+    int frame;
+    fillRandom(FRAMES, 0xdef0, 200);
+    for (frame = I_INTERVAL; frame < 2 * I_INTERVAL; frame++)
+        memcpy(values[frame], values[frame - I_INTERVAL], sizeof(values[frame]));
+    encodeFrames(2 * I_INTERVAL);
+    EXPECT_EQ(frameEnd[I_INTERVAL - 1], frameEnd[2 * I_INTERVAL - 1] - frameEnd[I_INTERVAL - 1]);
+    EXPECT_EQ(0, memcmp(testOutput, testOutput + frameEnd[I_INTERVAL - 1], frameEnd[I_INTERVAL - 1]));
+
+    encodeFrames(FRAMES);
+    EXPECT_EQ(0, decodeFrames(3 * I_INTERVAL, FRAMES));
+}
+
+int main(void)
+{
+    RUN_TEST(testKnownBits);
+    RUN_TEST(testEscapeBits);
+    RUN_TEST(testSmallResiduals);
+    RUN_TEST(testEscapes);
+    RUN_TEST(testAdaptation);
+    RUN_TEST(testIFrameResetResyncs);
+    return UNITTEST_RESULT();
+}
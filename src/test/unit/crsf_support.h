@@ -0,0 +1,79 @@
+#pragma once
+
+// Link-time stubs for rx/crsf.c and helpers that build CRSF frames.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+#include "build_config.h"
+#include "drivers/serial.h"
+#include "drivers/serial_uart.h"
+#include "io/serial.h"
+#include "rx/rx.h"
+#include "rx/crsf.h"
+
+#define CRSF_ADDRESS 0xC8
+#define CRSF_RC_FRAME_LENGTH 24
+#define CRSF_RC_FRAME_SIZE (CRSF_RC_FRAME_LENGTH + 2)
+#define CRSF_LINK_FRAME_SIZE 14
+
+void crsfDataReceive(uint16_t c);
+void crsfFrameReceive(const uint8_t *frame, uint16_t length);
+uint16_t crsfReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
+
+bool SKIP_RX = false;
+uint16_t rssi;
+static uint32_t fakeMicros;
+static int framesArrived;
+static int framesReceived;
+
+uint32_t micros(void) { return fakeMicros; }
+void resetTimeSinceRxPulse(void) { }
+void rxFrameArrived(void) { framesArrived++; }
+void serialRxFrameReceived(void) { framesReceived++; }
+bool feature(uint32_t mask) { UNUSED(mask); return false; }
+serialPortConfig_t *findSerialPortConfig(serialPortFunction_e function) { UNUSED(function); return NULL; }
+serialPort_t *openSerialPort(serialPortIdentifier_e identifier, serialPortFunction_e function, serialReceiveCallbackPtr callback, uint32_t baudrate, portMode_t mode, portOptions_t options)
+{
+    UNUSED(identifier); UNUSED(function); UNUSED(callback); UNUSED(baudrate); UNUSED(mode); UNUSED(options);
+    return NULL;
+}
+bool uartSetRxFrameCallback(serialPort_t *instance, serialReceiveFrameCallbackPtr callback) { UNUSED(instance); UNUSED(callback); return false; }
+
+rxRuntimeConfig_t rxRuntimeConfig;
+
+static inline void packChannel(uint8_t *packed, uint8_t channel, uint16_t value)
+{
+    uint16_t bit;
+    for (bit = 0; bit < 11; bit++) {
+        uint16_t pos = channel * 11 + bit;
+        if (value & (1 << bit))
+            packed[pos / 8] |= 1 << (pos % 8);
+    }
+}
+
+static inline uint8_t buildRcFrame(uint8_t *frame, const uint16_t *values)
+{
+    uint8_t channel;
+    memset(frame, 0, CRSF_RC_FRAME_SIZE);
+    frame[0] = CRSF_ADDRESS;
+    frame[1] = CRSF_RC_FRAME_LENGTH;
+    frame[2] = 0x16;
+    for (channel = 0; channel < 16; channel++)
+        packChannel(frame + 3, channel, values[channel]);
+    frame[CRSF_RC_FRAME_SIZE - 1] = crsfCrc8(frame + 2, CRSF_RC_FRAME_LENGTH - 1);
+    return CRSF_RC_FRAME_SIZE;
+}
+
+static inline uint8_t buildLinkFrame(uint8_t *frame, uint8_t linkQuality)
+{
+    memset(frame, 0, CRSF_LINK_FRAME_SIZE);
+    frame[0] = CRSF_ADDRESS;
+    frame[1] = CRSF_LINK_FRAME_SIZE - 2;
+    frame[2] = 0x14;
+    frame[3 + 2] = linkQuality;
+    frame[CRSF_LINK_FRAME_SIZE - 1] = crsfCrc8(frame + 2, CRSF_LINK_FRAME_SIZE - 3);
+    return CRSF_LINK_FRAME_SIZE;
+}
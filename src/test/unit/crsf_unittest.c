@@ -0,0 +1,157 @@
+#include "crsf_support.h"
+#include "unittest.h"
+
+static rxConfig_t rxConfig;
+
+static const uint16_t testChannels[16] = {
+    992, 172, 1811, 992, 500, 1500, 0, 2047, 992, 992, 992, 992, 1000, 1100, 1200, 1300
+};
+
+static void feedBytes(const uint8_t *data, uint8_t length)
+{
+    while (length--) {
+        crsfDataReceive(*data++);
+        fakeMicros += 23;
+    }
+}
+
+static void reset(void)
+{
+    fakeMicros += 10000;
+    framesArrived = 0;
+    framesReceived = 0;
+    crsfFrameStatus();
+    rxConfig.midrc = 1500;
+    rxConfig.rssi_channel = 0;
+    crsfInit(&rxConfig, &rxRuntimeConfig, NULL);
+}
+
+static void expectTestChannels(void)
+{
+    EXPECT_EQ(1500, crsfReadRawRC(&rxRuntimeConfig, 0));
+    EXPECT_EQ(988, crsfReadRawRC(&rxRuntimeConfig, 1));
+    EXPECT_EQ(2012, crsfReadRawRC(&rxRuntimeConfig, 2));
+    EXPECT_EQ(881, crsfReadRawRC(&rxRuntimeConfig, 6));
+    EXPECT_EQ(881 + 1278, crsfReadRawRC(&rxRuntimeConfig, 7));
+}
+
+static void testCrc8(void)
+{
+    const uint8_t check[] = "123456789";
+    EXPECT_EQ(0xBC, crsfCrc8(check, 9));
+    EXPECT_EQ(0x00, crsfCrc8(check, 0));
+}
+
+static void testByteStreamFrame(void)
+{
+    uint8_t frame[CRSF_RC_FRAME_SIZE];
+    reset();
+    EXPECT_EQ(SERIAL_RX_FRAME_PENDING, crsfFrameStatus());
+    feedBytes(frame, buildRcFrame(frame, testChannels));
+    EXPECT_EQ(1, framesArrived);
+    EXPECT_EQ(SERIAL_RX_FRAME_COMPLETE, crsfFrameStatus());
+    EXPECT_EQ(SERIAL_RX_FRAME_PENDING, crsfFrameStatus());
+    expectTestChannels();
+}
+
+static void testByteStreamBadCrc(void)
+{
+    uint8_t frame[CRSF_RC_FRAME_SIZE];
+    reset();
+    buildRcFrame(frame, testChannels);
+    frame[CRSF_RC_FRAME_SIZE - 1] ^= 0x01;
+    feedBytes(frame, CRSF_RC_FRAME_SIZE);
+    EXPECT_EQ(0, framesArrived);
+    EXPECT_EQ(SERIAL_RX_FRAME_PENDING, crsfFrameStatus());
+    buildRcFrame(frame, testChannels);
+    frame[10] ^= 0x40;
+    feedBytes(frame, CRSF_RC_FRAME_SIZE);
+    EXPECT_EQ(0, framesArrived);
+    EXPECT_EQ(1500, crsfReadRawRC(&rxRuntimeConfig, 1));
+}
+
+static void testByteStreamShortFrame(void)
+{
+    uint8_t frame[CRSF_RC_FRAME_SIZE];
+    reset();
+    buildRcFrame(frame, testChannels);
+    frame[1] = CRSF_RC_FRAME_LENGTH - 4;
+    frame[CRSF_RC_FRAME_LENGTH - 3] = crsfCrc8(frame + 2, frame[1] - 1);
+    feedBytes(frame, frame[1] + 2);
+    EXPECT_EQ(0, framesArrived);
+    EXPECT_EQ(SERIAL_RX_FRAME_PENDING, crsfFrameStatus());
+    feedBytes(frame, buildRcFrame(frame, testChannels));
+    EXPECT_EQ(1, framesArrived);
+}
+
+static void testByteStreamResync(void)
+{
+    uint8_t frame[CRSF_RC_FRAME_SIZE];
+    const uint8_t noise[] = { 0x55, 0x16, 0x00 };
+    const uint8_t badLength[] = { CRSF_ADDRESS, 0x01, CRSF_ADDRESS, 0xFF };
+    reset();
+    buildRcFrame(frame, testChannels);
+    feedBytes(noise, 2);
+    feedBytes(badLength, sizeof(badLength));
+    feedBytes(frame, buildRcFrame(frame, testChannels));
+    EXPECT_EQ(1, framesArrived);
+    feedBytes(frame, 10);
+    fakeMicros += 5000;
+    feedBytes(frame, CRSF_RC_FRAME_SIZE);
+    EXPECT_EQ(2, framesArrived);
+    feedBytes(noise + 2, 1);
+    feedBytes(frame, CRSF_RC_FRAME_SIZE);
+    EXPECT_EQ(2, framesArrived);
+    fakeMicros += 5000;
+    feedBytes(frame, CRSF_RC_FRAME_SIZE);
+    EXPECT_EQ(3, framesArrived);
+    crsfFrameStatus();
+    expectTestChannels();
+}
+
+static void testIdleFrameBuffer(void)
+{
+    uint8_t buffer[64];
+    uint8_t length = 0;
+    reset();
+    buffer[length++] = 0x00;
+    buffer[length++] = 0x01;
+    buffer[length++] = 0x7F;
+    length += buildLinkFrame(buffer + length, 50);
+    length += buildRcFrame(buffer + length, testChannels);
+    crsfFrameReceive(buffer, length);
+    EXPECT_EQ(1, framesReceived);
+    EXPECT_EQ(50, crsfLinkStatistics.uplinkLinkQuality);
+    EXPECT_EQ(50 * 1023 / 100, rssi);
+    EXPECT_EQ(SERIAL_RX_FRAME_COMPLETE, crsfFrameStatus());
+    expectTestChannels();
+}
+
+static void testIdleFrameBufferRejects(void)
+{
+    uint8_t buffer[64];
+    uint8_t length;
+    reset();
+    length = buildRcFrame(buffer, testChannels);
+    buffer[length - 1] ^= 0xFF;
+    crsfFrameReceive(buffer, length);
+    EXPECT_EQ(0, framesReceived);
+    length = buildRcFrame(buffer, testChannels);
+    crsfFrameReceive(buffer, length - 1);
+    EXPECT_EQ(0, framesReceived);
+    crsfFrameReceive(buffer, 3);
+    EXPECT_EQ(0, framesReceived);
+    EXPECT_EQ(SERIAL_RX_FRAME_PENDING, crsfFrameStatus());
+}
+
+int main(void)
+{
+    RUN_TEST(testCrc8);
+    RUN_TEST(testByteStreamFrame);
+    RUN_TEST(testByteStreamBadCrc);
+    RUN_TEST(testByteStreamShortFrame);
+    RUN_TEST(testByteStreamResync);
+    RUN_TEST(testIdleFrameBuffer);
+    RUN_TEST(testIdleFrameBufferRejects);
+    return UNITTEST_RESULT();
+}
@@ -0,0 +1,81 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "drivers/dshot.h"
+
+#include "unittest.h"
+
+static uint16_t frameChecksum(uint16_t frame)
+{
+    return (frame ^ (frame >> 4) ^ (frame >> 8) ^ (frame >> 12)) & 0xf;
+}
+
+static void testEncodeFrameVectors(void)
+{
+    EXPECT_EQ(0x0000, dshotEncodeFrame(0, false));
+    EXPECT_EQ(0x0011, dshotEncodeFrame(0, true));
+    EXPECT_EQ(0x82c6, dshotEncodeFrame(1046, false));
+    EXPECT_EQ(0x82d7, dshotEncodeFrame(1046, true));
+    EXPECT_EQ(0x0606, dshotEncodeFrame(48, false));
+    EXPECT_EQ(0xffee, dshotEncodeFrame(2047, false));
+    EXPECT_EQ(0xffff, dshotEncodeFrame(2047, true));
+}
+
+static void testEncodeFrameChecksum(void)
+{
+    uint16_t value;
+    for (value = 0; value <= DSHOT_MAX_THROTTLE; value++) {
+        uint16_t frame = dshotEncodeFrame(value, false);
+        uint16_t telemetryFrame = dshotEncodeFrame(value, true);
+        EXPECT_EQ(value, frame >> 5);
+        EXPECT_EQ(0, (frame >> 4) & 1);
+        EXPECT_EQ(1, (telemetryFrame >> 4) & 1);
+        EXPECT_EQ(0, frameChecksum(frame));
+        EXPECT_EQ(0, frameChecksum(telemetryFrame));
+    }
+}
+
+static void testThrottleRange(void)
+{
+    EXPECT_EQ(0, dshotThrottle(900));
+    EXPECT_EQ(0, dshotThrottle(1000));
+    EXPECT_EQ(DSHOT_MIN_THROTTLE + 1, dshotThrottle(1001));
+    EXPECT_EQ(1047, dshotThrottle(1500));
+    EXPECT_EQ(2045, dshotThrottle(1999));
+    EXPECT_EQ(DSHOT_MAX_THROTTLE, dshotThrottle(2000));
+    EXPECT_EQ(DSHOT_MAX_THROTTLE, dshotThrottle(2100));
+}
+
+static void testBitTiming(void)
+{
+    EXPECT_EQ(DSHOT_BIT_PERIOD * 3 / 4, DSHOT_BIT_1);
+    EXPECT_TRUE(DSHOT_BIT_0 * 100 >= DSHOT_BIT_PERIOD * 30 && DSHOT_BIT_0 * 100 <= DSHOT_BIT_PERIOD * 40);
+    EXPECT_TRUE(DSHOT_BIT_PERIOD - DSHOT_BIT_1 > 0);
+}
+
+static void testFillBuffer(void)
+{
+    const uint16_t frame = 0x82c6;
+    const uint8_t stride = 3;
+    uint32_t buffer[DSHOT_FRAME_BITS * 3];
+    int i;
+    for (i = 0; i < DSHOT_FRAME_BITS * 3; i++)
+        buffer[i] = 0xdeadbeef;
+    dshotFillBuffer(&buffer[1], stride, frame);
+    for (i = 0; i < DSHOT_FRAME_BITS; i++) {
+        bool bit = (frame >> (DSHOT_FRAME_BITS - 1 - i)) & 1;
+        EXPECT_EQ(bit ? DSHOT_BIT_1 : DSHOT_BIT_0, buffer[i * stride + 1]);
+        EXPECT_EQ(0xdeadbeef, buffer[i * stride]);
+        EXPECT_EQ(0xdeadbeef, buffer[i * stride + 2]);
+    }
+}
+
+int main(void)
+{
+    RUN_TEST(testEncodeFrameVectors);
+    RUN_TEST(testEncodeFrameChecksum);
+    RUN_TEST(testThrottleRange);
+    RUN_TEST(testBitTiming);
+    RUN_TEST(testFillBuffer);
+    return UNITTEST_RESULT();
+}
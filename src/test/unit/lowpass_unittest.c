@@ -0,0 +1,50 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "flight/lowpass.h"
+
+#include "unittest.h"
+
+static void testFloatMatchesFixedStep(void)
+{
+    lowpass_t fixedFilter = { 0 }, floatFilter = { 0 };
+    int i;
+    lowpassFixed(&fixedFilter, 1500, 100);
+    lowpassFloat(&floatFilter, 1500, 100);
+    for (i = 0; i < 500; i++) {
+        int32_t in = i < 250 ? 1900 : 1100;
+        int32_t fixedOut = lowpassFixed(&fixedFilter, in, 100);
+        float floatOut = lowpassFloat(&floatFilter, in, 100);
+        EXPECT_TRUE(fabsf(floatOut - fixedOut) <= 1.0f);
+    }
+    EXPECT_TRUE(fabsf(lowpassFloat(&floatFilter, 1100, 100) - 1100) < 1.0f);
+}
+
+static void testFreqChangeReinitialises(void)
+{
+    lowpass_t filter = { 0 };
+    lowpassFloat(&filter, 1200, 100);
+    lowpassFloat(&filter, 1800, 100);
+    EXPECT_EQ(1700, lrintf(lowpassFloat(&filter, 1700, 200)));
+    EXPECT_EQ(200, filter.freq);
+}
+
+static void testUnityDcGain(void)
+{
+    lowpass_t filter = { 0 };
+    float out = 0;
+    int i;
+    lowpassFloat(&filter, 1000, 50);
+    for (i = 0; i < 2000; i++)
+        out = lowpassFloat(&filter, 2000, 50);
+    EXPECT_TRUE(fabsf(out - 2000) < 0.5f);
+}
+
+int main(void)
+{
+    RUN_TEST(testFloatMatchesFixedStep);
+    RUN_TEST(testFreqChangeReinitialises);
+    RUN_TEST(testUnityDcGain);
+    return UNITTEST_RESULT();
+}
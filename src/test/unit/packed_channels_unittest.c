@@ -0,0 +1,91 @@
+#include <stdint.h>
+
+#include "rx/packed_channels.h"
+
+#include "sbus_reference.h"
+#include "unittest.h"
+
+#define SBUS_CHANNEL_SCALE 40960
+#define SBUS_CHANNEL_OFFSET 880
+
+static void packChannel(uint8_t *packed, uint8_t channel, uint16_t value)
+{
+    uint16_t bit;
+    for (bit = 0; bit < 11; bit++) {
+        uint16_t pos = channel * 11 + bit;
+        if (value & (1 << bit))
+            packed[pos / 8] |= 1 << (pos % 8);
+        else
+            packed[pos / 8] &= ~(1 << (pos % 8));
+    }
+}
+
+static void testUnpackRawValues(void)
+{
+    uint8_t packed[22] = { 0 };
+    uint16_t channels[16];
+    uint8_t channel;
+    for (channel = 0; channel < 16; channel++)
+        packChannel(packed, channel, (channel * 137 + 5) & 0x7ff);
+    rxUnpack11BitChannels(packed, channels, 16, 1 << 16, 0);
+    for (channel = 0; channel < 16; channel++)
+        EXPECT_EQ((channel * 137 + 5) & 0x7ff, channels[channel]);
+}
+
+static void testMatchesBitfieldDecodeExhaustively(void)
+{
+    sbusReferenceFrame_t frame;
+    uint32_t reference[16];
+    uint16_t channels[16];
+    uint32_t seed = 1;
+    uint8_t channel;
+    uint16_t value;
+    int mismatches = 0;
+    int i;
+    for (channel = 0; channel < 16; channel++) {
+        for (value = 0; value < 2048; value++) {
+            for (i = 0; i < 25; i++) {
+                seed = seed * 1103515245 + 12345;
+                frame.bytes[i] = seed >> 16;
+            }
+            packChannel(frame.bytes + 1, channel, value);
+            sbusReferenceDecode(&frame, reference);
+            rxUnpack11BitChannels(frame.bytes + 1, channels, 16, SBUS_CHANNEL_SCALE, SBUS_CHANNEL_OFFSET);
+            for (i = 0; i < 16; i++) {
+                if (channels[i] != sbusReferenceScale(reference[i]))
+                    mismatches++;
+            }
+            EXPECT_EQ(value, reference[channel]);
+        }
+    }
+    EXPECT_EQ(0, mismatches);
+}
+
+static void testPartialGroupsAreDecoded(void)
+{
+    uint8_t count;
+    uint8_t channel;
+    for (count = 1; count <= 16; count++) {
+        uint8_t packed[22] = { 0 };
+        uint16_t channels[17];
+        uint16_t expected[16];
+        for (channel = 0; channel < count; channel++) {
+            expected[channel] = (channel * 733 + count * 97) & 0x7ff;
+            packChannel(packed, channel, expected[channel]);
+        }
+        for (channel = 0; channel < 17; channel++)
+            channels[channel] = 0xbeef;
+        rxUnpack11BitChannels(packed, channels, count, SBUS_CHANNEL_SCALE, SBUS_CHANNEL_OFFSET);
+        for (channel = 0; channel < count; channel++)
+            EXPECT_EQ(sbusReferenceScale(expected[channel]), channels[channel]);
+        EXPECT_EQ(0xbeef, channels[count]);
+    }
+}
+
+int main(void)
+{
+    RUN_TEST(testUnpackRawValues);
+    RUN_TEST(testMatchesBitfieldDecodeExhaustively);
+    RUN_TEST(testPartialGroupsAreDecoded);
+    return UNITTEST_RESULT();
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+// Stands in for src/main/platform.h when building firmware sources on
+// the host. Only the types and target defines the tested files reach.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SERIAL_PORT_COUNT 4
+
+typedef enum {
+    TEST_IRQn = 0
+} IRQn_Type;
+
+typedef struct {
+    uint32_t CCR;
+} DMA_Channel_TypeDef;
+
+typedef struct {
+    uint32_t SR;
+    uint32_t DR;
+} USART_TypeDef;
+
+typedef enum {
+    DISABLE = 0,
+    ENABLE = !DISABLE
+} FunctionalState;
+
+typedef struct {
+    uint32_t IDR;
+    uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef struct {
+    uint32_t SR1;
+    uint32_t DR;
+} I2C_TypeDef;
+
+typedef enum {
+    EXTI_Trigger_Rising = 0x08,
+    EXTI_Trigger_Falling = 0x0C,
+    EXTI_Trigger_Rising_Falling = 0x10
+} EXTITrigger_TypeDef;
+
+typedef enum {
+    Mode_AIN = 0x0,
+    Mode_IN_FLOATING = 0x04,
+    Mode_IPD = 0x28,
+    Mode_IPU = 0x48,
+    Mode_Out_OD = 0x14,
+    Mode_Out_PP = 0x10,
+    Mode_AF_OD = 0x1C,
+    Mode_AF_PP = 0x18
+} GPIO_Mode;
+
+typedef struct {
+    uint32_t CCR1;
+    uint32_t CCR2;
+    uint32_t CCR3;
+    uint32_t CCR4;
+    uint32_t DIER;
+} TIM_TypeDef;
+
+typedef struct {
+    uint16_t TIM_Channel;
+    uint16_t TIM_ICPolarity;
+    uint16_t TIM_ICSelection;
+    uint16_t TIM_ICPrescaler;
+    uint16_t TIM_ICFilter;
+} TIM_ICInitTypeDef;
+
+#define TIM_Channel_1 0x0000
+#define TIM_Channel_2 0x0004
+#define TIM_Channel_3 0x0008
+#define TIM_Channel_4 0x000C
+#define TIM_ICPolarity_Rising 0x0000
+#define TIM_ICPolarity_Falling 0x0002
+#define TIM_ICSelection_DirectTI 0x0001
+#define TIM_ICPSC_DIV1 0x0000
+#define TIM_DMA_CC1 0x0200
+
+typedef struct {
+    uint32_t CR;
+    uint32_t NDTR;
+} DMA_Stream_TypeDef;
+
+typedef struct {
+    uint32_t DMA_Channel;
+    uint32_t DMA_PeripheralBaseAddr;
+    uint32_t DMA_Memory0BaseAddr;
+    uint32_t DMA_DIR;
+    uint32_t DMA_BufferSize;
+    uint32_t DMA_PeripheralInc;
+    uint32_t DMA_MemoryInc;
+    uint32_t DMA_PeripheralDataSize;
+    uint32_t DMA_MemoryDataSize;
+    uint32_t DMA_Mode;
+    uint32_t DMA_Priority;
+} DMA_InitTypeDef;
+
+// Tests that reach timer or DMA code define these arrays.
+extern TIM_TypeDef testTimers[9];
+extern DMA_Stream_TypeDef testDmaStreams[2][8];
+
+#define TIM1 (&testTimers[1])
+#define TIM2 (&testTimers[2])
+#define TIM3 (&testTimers[3])
+#define TIM4 (&testTimers[4])
+#define TIM5 (&testTimers[5])
+#define TIM8 (&testTimers[8])
+#define DMA1_Stream0 (&testDmaStreams[0][0])
+#define DMA1_Stream1 (&testDmaStreams[0][1])
+#define DMA1_Stream2 (&testDmaStreams[0][2])
+#define DMA1_Stream3 (&testDmaStreams[0][3])
+#define DMA1_Stream4 (&testDmaStreams[0][4])
+#define DMA1_Stream5 (&testDmaStreams[0][5])
+#define DMA1_Stream6 (&testDmaStreams[0][6])
+#define DMA1_Stream7 (&testDmaStreams[0][7])
+#define DMA2_Stream0 (&testDmaStreams[1][0])
+#define DMA2_Stream1 (&testDmaStreams[1][1])
+#define DMA2_Stream2 (&testDmaStreams[1][2])
+#define DMA2_Stream3 (&testDmaStreams[1][3])
+#define DMA2_Stream4 (&testDmaStreams[1][4])
+#define DMA2_Stream5 (&testDmaStreams[1][5])
+#define DMA2_Stream6 (&testDmaStreams[1][6])
+#define DMA2_Stream7 (&testDmaStreams[1][7])
+
+#define DMA_Channel_2 0x04000000
+#define DMA_Channel_3 0x06000000
+#define DMA_Channel_5 0x0A000000
+#define DMA_Channel_6 0x0C000000
+#define DMA_Channel_7 0x0E000000
+#define DMA_SxCR_EN 0x00000001
+#define DMA_DIR_PeripheralToMemory 0x00000000
+#define DMA_PeripheralInc_Disable 0x00000000
+#define DMA_MemoryInc_Enable 0x00000400
+#define DMA_PeripheralDataSize_HalfWord 0x00000800
+#define DMA_MemoryDataSize_HalfWord 0x00002000
+#define DMA_Mode_Circular 0x00000100
+#define DMA_Priority_Low 0x00000000
+#define RCC_AHB1Periph_DMA1 0x00200000
+#define RCC_AHB1Periph_DMA2 0x00400000
+
+void RCC_AHB1PeriphClockCmd(uint32_t periph, FunctionalState state);
+void DMA_DeInit(DMA_Stream_TypeDef *stream);
+void DMA_StructInit(DMA_InitTypeDef *init);
+void DMA_Init(DMA_Stream_TypeDef *stream, DMA_InitTypeDef *init);
+void DMA_Cmd(DMA_Stream_TypeDef *stream, FunctionalState state);
+uint16_t DMA_GetCurrDataCounter(DMA_Stream_TypeDef *stream);
+void TIM_DMACmd(TIM_TypeDef *tim, uint16_t source, FunctionalState state);
+void TIM_ICStructInit(TIM_ICInitTypeDef *init);
+void TIM_ICInit(TIM_TypeDef *tim, TIM_ICInitTypeDef *init);
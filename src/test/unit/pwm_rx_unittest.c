@@ -0,0 +1,206 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+#include "build_config.h"
+#include "drivers/timer.h"
+#include "drivers/gpio.h"
+#include "drivers/dma.h"
+#include "drivers/pwm_rx.h"
+
+#include "unittest.h"
+
+#define PPM_DMA_RING_SIZE 128
+#define PPM_FRAME_US 22500
+#define PPM_STABLE_FRAMES 25
+
+void ppmProcessEdge(uint32_t currentTime);
+extern volatile uint16_t ppmDmaRing[PPM_DMA_RING_SIZE];
+
+TIM_TypeDef testTimers[9];
+DMA_Stream_TypeDef testDmaStreams[2][8];
+static timerCCHandlerRec_t *edgeCallback;
+static timerOvrHandlerRec_t *overflowCallback;
+
+void gpioInit(GPIO_TypeDef *gpio, gpio_config_t *config) { UNUSED(gpio); UNUSED(config); }
+void timerConfigure(const timerHardware_t *timHw, uint16_t period, uint8_t mhz) { UNUSED(timHw); UNUSED(period); UNUSED(mhz); }
+void timerChCCHandlerInit(timerCCHandlerRec_t *self, timerCCHandlerCallback *fn) { self->fn = fn; }
+void timerChOvrHandlerInit(timerOvrHandlerRec_t *self, timerOvrHandlerCallback *fn) { self->fn = fn; self->next = NULL; }
+void timerChConfigCallbacks(const timerHardware_t *channel, timerCCHandlerRec_t *edge, timerOvrHandlerRec_t *overflow)
+{
+    UNUSED(channel);
+    edgeCallback = edge;
+    overflowCallback = overflow;
+}
+volatile timCCR_t *timerChCCR(const timerHardware_t *timHw) { return &timHw->tim->CCR4; }
+void TIM_ICStructInit(TIM_ICInitTypeDef *init) { memset(init, 0, sizeof(*init)); }
+void TIM_ICInit(TIM_TypeDef *tim, TIM_ICInitTypeDef *init) { UNUSED(tim); UNUSED(init); }
+void TIM_DMACmd(TIM_TypeDef *tim, uint16_t source, FunctionalState state) { if (state) tim->DIER |= source; else tim->DIER &= ~source; }
+void RCC_AHB1PeriphClockCmd(uint32_t periph, FunctionalState state) { UNUSED(periph); UNUSED(state); }
+void DMA_DeInit(DMA_Stream_TypeDef *stream) { stream->CR = 0; }
+void DMA_StructInit(DMA_InitTypeDef *init) { memset(init, 0, sizeof(*init)); }
+void DMA_Init(DMA_Stream_TypeDef *stream, DMA_InitTypeDef *init) { stream->NDTR = init->DMA_BufferSize; }
+void DMA_Cmd(DMA_Stream_TypeDef *stream, FunctionalState state) { stream->CR = state ? DMA_SxCR_EN : 0; }
+uint16_t DMA_GetCurrDataCounter(DMA_Stream_TypeDef *stream) { return stream->NDTR; }
+
+static const timerHardware_t ppmPin = { TIM8, NULL, 0, TIM_Channel_4, 0, 0, Mode_IPD };
+
+static uint32_t edgeTime;
+static uint16_t dmaHead;
+static bool useDma;
+
+static void emitEdge(uint32_t delta)
+{
+    const uint32_t previous = edgeTime;
+    edgeTime += delta;
+    if (useDma) {
+        ppmDmaRing[dmaHead] = edgeTime & 0xFFFF;
+        dmaHead = (dmaHead + 1) % PPM_DMA_RING_SIZE;
+        DMA2_Stream7->NDTR = PPM_DMA_RING_SIZE - dmaHead;
+        return;
+    }
+    if ((previous ^ edgeTime) & 0xFFFF0000)
+        overflowCallback->fn(overflowCallback, 0xFFFF);
+    edgeCallback->fn(edgeCallback, edgeTime & 0xFFFF);
+}
+
+static void emitFrame(const uint16_t *pulses, uint8_t count)
+{
+    uint32_t used = 0;
+    uint8_t i;
+    for (i = 0; i < count; i++) {
+        emitEdge(pulses[i]);
+        used += pulses[i];
+    }
+    emitEdge(PPM_FRAME_US - used);
+    if (useDma)
+        ppmCaptureProcess();
+}
+
+static const uint16_t eightChannels[8] = { 1500, 1000, 2000, 1234, 1100, 1900, 1500, 1500 };
+
+static void expectChannels(const uint16_t *pulses, uint8_t count)
+{
+    uint8_t i;
+    for (i = 0; i < count; i++)
+        EXPECT_EQ(pulses[i], ppmRead(i));
+    EXPECT_EQ(PPM_RCVR_TIMEOUT, ppmRead(count));
+}
+
+// The first frame sets the channel count, the next PPM_STABLE_FRAMES
+// confirm it; the frame after that is the first one published.
+static void emitUnpublishedFrames(const uint16_t *pulses, uint8_t count)
+{
+    int frame;
+    resetPPMDataReceivedState();
+    for (frame = 0; frame < PPM_STABLE_FRAMES + 1; frame++)
+        emitFrame(pulses, count);
+    EXPECT_TRUE(!isPPMDataBeingReceived());
+}
+
+static void lockOn(const uint16_t *pulses, uint8_t count)
+{
+    ppmInConfig(&ppmPin);
+    emitEdge(PPM_FRAME_US);
+    emitUnpublishedFrames(pulses, count);
+}
+
+static void testFramesPublishedAfterStableCount(void)
+{
+    lockOn(eightChannels, 8);
+    emitFrame(eightChannels, 8);
+    EXPECT_TRUE(isPPMDataBeingReceived());
+    expectChannels(eightChannels, 8);
+    resetPPMDataReceivedState();
+    EXPECT_TRUE(!isPPMDataBeingReceived());
+}
+
+static void testTimerWrap(void)
+{
+    int frame;
+    edgeTime = 0xFFFF0000 - PPM_FRAME_US * 20;
+    lockOn(eightChannels, 8);
+    for (frame = 0; frame < 60; frame++)
+        emitFrame(eightChannels, 8);
+    EXPECT_TRUE(edgeTime < 0x10000000);
+    expectChannels(eightChannels, 8);
+}
+
+static void testGlitchDropsFrame(void)
+{
+    uint16_t glitched[8];
+    lockOn(eightChannels, 8);
+    emitFrame(eightChannels, 8);
+    memcpy(glitched, eightChannels, sizeof(glitched));
+    glitched[3] = 300;
+    glitched[4] = 2000;
+    resetPPMDataReceivedState();
+    emitFrame(glitched, 8);
+    EXPECT_TRUE(!isPPMDataBeingReceived());
+    EXPECT_EQ(1234, ppmRead(3));
+    emitFrame(eightChannels, 8);
+    EXPECT_TRUE(isPPMDataBeingReceived());
+    expectChannels(eightChannels, 8);
+}
+
+static void testChannelCountChange(void)
+{
+    lockOn(eightChannels, 8);
+    emitFrame(eightChannels, 8);
+    emitUnpublishedFrames(eightChannels, 6);
+    emitFrame(eightChannels, 6);
+    EXPECT_TRUE(isPPMDataBeingReceived());
+    expectChannels(eightChannels, 6);
+}
+
+static void testDmaStreamOwnedElsewhereKeepsIsr(void)
+{
+    EXPECT_TRUE(dmaReserve(DMA2_Stream7, OWNER_SERIAL_TX));
+    ppmInConfig(&ppmPin);
+    ppmCaptureDmaInit();
+    EXPECT_TRUE(edgeCallback != NULL);
+    EXPECT_EQ(0, DMA2_Stream7->CR);
+    EXPECT_EQ(OWNER_SERIAL_TX, dmaGetOwner(DMA2_Stream7));
+    testFramesPublishedAfterStableCount();
+    dmaRelease(DMA2_Stream7, OWNER_SERIAL_TX);
+}
+
+static void testDmaRingDecode(void)
+{
+    int frame;
+    useDma = true;
+    edgeTime = 0x12345678;
+    ppmInConfig(&ppmPin);
+    ppmCaptureDmaInit();
+    EXPECT_TRUE(edgeCallback == NULL);
+    EXPECT_TRUE(overflowCallback != NULL);
+    EXPECT_EQ(DMA_SxCR_EN, DMA2_Stream7->CR);
+    EXPECT_EQ(OWNER_PPMINPUT, dmaGetOwner(DMA2_Stream7));
+    EXPECT_TRUE(!dmaReserve(DMA2_Stream7, OWNER_SERIAL_TX));
+    emitEdge(PPM_FRAME_US);
+    emitUnpublishedFrames(eightChannels, 8);
+    for (frame = 0; frame < 200; frame++)
+        emitFrame(eightChannels, 8);
+    expectChannels(eightChannels, 8);
+    for (frame = 0; frame < 10; frame++) {
+        emitFrame(eightChannels, 8);
+        emitFrame(eightChannels, 8);
+        emitFrame(eightChannels, 8);
+    }
+    resetPPMDataReceivedState();
+    emitFrame(eightChannels, 8);
+    EXPECT_TRUE(isPPMDataBeingReceived());
+    expectChannels(eightChannels, 8);
+}
+
+int main(void)
+{
+    RUN_TEST(testFramesPublishedAfterStableCount);
+    RUN_TEST(testTimerWrap);
+    RUN_TEST(testGlitchDropsFrame);
+    RUN_TEST(testChannelCountChange);
+    RUN_TEST(testDmaStreamOwnedElsewhereKeepsIsr);
+    RUN_TEST(testDmaRingDecode);
+    return UNITTEST_RESULT();
+}
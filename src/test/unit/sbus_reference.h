@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+
+// The SBUS decode as it was before rxUnpack11BitChannels: a bitfield
+// struct copied channel by channel, scaled by float on every read.
+struct sbusReferenceFrame_s {
+    uint8_t syncByte;
+    unsigned int chan0 : 11;
+    unsigned int chan1 : 11;
+    unsigned int chan2 : 11;
+    unsigned int chan3 : 11;
+    unsigned int chan4 : 11;
+    unsigned int chan5 : 11;
+    unsigned int chan6 : 11;
+    unsigned int chan7 : 11;
+    unsigned int chan8 : 11;
+    unsigned int chan9 : 11;
+    unsigned int chan10 : 11;
+    unsigned int chan11 : 11;
+    unsigned int chan12 : 11;
+    unsigned int chan13 : 11;
+    unsigned int chan14 : 11;
+    unsigned int chan15 : 11;
+    uint8_t flags;
+    uint8_t endByte;
+} __attribute__ ((__packed__));
+
+typedef union {
+    uint8_t bytes[25];
+    struct sbusReferenceFrame_s frame;
+} sbusReferenceFrame_t;
+
+static inline void sbusReferenceDecode(const sbusReferenceFrame_t *sbusFrame, uint32_t *sbusChannelData)
+{
+    sbusChannelData[0] = sbusFrame->frame.chan0;
+    sbusChannelData[1] = sbusFrame->frame.chan1;
+    sbusChannelData[2] = sbusFrame->frame.chan2;
+    sbusChannelData[3] = sbusFrame->frame.chan3;
+    sbusChannelData[4] = sbusFrame->frame.chan4;
+    sbusChannelData[5] = sbusFrame->frame.chan5;
+    sbusChannelData[6] = sbusFrame->frame.chan6;
+    sbusChannelData[7] = sbusFrame->frame.chan7;
+    sbusChannelData[8] = sbusFrame->frame.chan8;
+    sbusChannelData[9] = sbusFrame->frame.chan9;
+    sbusChannelData[10] = sbusFrame->frame.chan10;
+    sbusChannelData[11] = sbusFrame->frame.chan11;
+    sbusChannelData[12] = sbusFrame->frame.chan12;
+    sbusChannelData[13] = sbusFrame->frame.chan13;
+    sbusChannelData[14] = sbusFrame->frame.chan14;
+    sbusChannelData[15] = sbusFrame->frame.chan15;
+}
+
+static inline uint16_t sbusReferenceScale(uint32_t value)
+{
+    return (0.625f * value) + 880;
+}
@@ -0,0 +1,113 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+#include "build_config.h"
+#include "common/utils.h"
+#include "drivers/serial.h"
+#include "drivers/serial_uart.h"
+#include "io/serial.h"
+#include "rx/rx.h"
+#include "rx/sumd.h"
+
+#include "unittest.h"
+
+#define SUMD_SYNCBYTE 0xA8
+#define SUMD_MAX_CHANNEL 16
+#define SUMD_FRAME_SIZE(channels) ((channels) * 2 + 5)
+
+void sumdFrameReceive(const uint8_t *frame, uint16_t length);
+uint16_t sumdReadRawRC(rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan);
+
+bool SKIP_RX = false;
+rxRuntimeConfig_t rxRuntimeConfig;
+static int framesReceived;
+
+uint32_t micros(void) { return 0; }
+void resetTimeSinceRxPulse(void) { }
+void rxFrameArrived(void) { }
+void serialRxFrameReceived(void) { framesReceived++; }
+serialPortConfig_t *findSerialPortConfig(serialPortFunction_e function) { UNUSED(function); return NULL; }
+serialPort_t *openSerialPort(serialPortIdentifier_e identifier, serialPortFunction_e function, serialReceiveCallbackPtr callback, uint32_t baudrate, portMode_t mode, portOptions_t options)
+{
+    UNUSED(identifier); UNUSED(function); UNUSED(callback); UNUSED(baudrate); UNUSED(mode); UNUSED(options);
+    return NULL;
+}
+bool uartSetRxFrameCallback(serialPort_t *instance, serialReceiveFrameCallbackPtr callback) { UNUSED(instance); UNUSED(callback); return false; }
+
+static uint16_t crc16(const uint8_t *data, uint16_t length)
+{
+    uint16_t crc = 0;
+    uint8_t bit;
+    while (length--) {
+        crc ^= *data++ << 8;
+        for (bit = 0; bit < 8; bit++)
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+static uint16_t buildFrame(uint8_t *frame, uint8_t channels, uint16_t firstValue)
+{
+    const uint16_t length = SUMD_FRAME_SIZE(channels);
+    uint16_t crc;
+    uint8_t i;
+    frame[0] = SUMD_SYNCBYTE;
+    frame[1] = 0x01;
+    frame[2] = channels;
+    for (i = 0; i < channels; i++) {
+        frame[3 + i * 2] = (firstValue + i) >> 8;
+        frame[4 + i * 2] = (firstValue + i) & 0xFF;
+    }
+    crc = crc16(frame, length - 2);
+    frame[length - 2] = crc >> 8;
+    frame[length - 1] = crc & 0xFF;
+    return length;
+}
+
+static void testValidFrame(void)
+{
+    uint8_t frame[SUMD_FRAME_SIZE(SUMD_MAX_CHANNEL)];
+    framesReceived = 0;
+    sumdFrameReceive(frame, buildFrame(frame, SUMD_MAX_CHANNEL, 12000));
+    EXPECT_EQ(1, framesReceived);
+    EXPECT_EQ(SERIAL_RX_FRAME_COMPLETE, sumdFrameStatus());
+    EXPECT_EQ(12000 / 8, sumdReadRawRC(&rxRuntimeConfig, 0));
+    EXPECT_EQ((12000 + 15) / 8, sumdReadRawRC(&rxRuntimeConfig, 15));
+}
+
+static void testBadCrcIgnored(void)
+{
+    uint8_t frame[SUMD_FRAME_SIZE(8)];
+    uint16_t length = buildFrame(frame, 8, 9600);
+    frame[length - 1] ^= 0xFF;
+    sumdFrameReceive(frame, length);
+    EXPECT_EQ(SERIAL_RX_FRAME_PENDING, sumdFrameStatus());
+}
+
+// frame[2] * 2 + 5 wraps an 8-bit length for counts of 126 and above.
+static void testOversizedChannelCountRejected(void)
+{
+    static const uint8_t counts[] = { 0, SUMD_MAX_CHANNEL + 1, 126, 130, 255 };
+    uint8_t frame[600];
+    uint8_t i;
+    memset(frame, 0, sizeof(frame));
+    for (i = 0; i < ARRAYLEN(counts); i++) {
+        framesReceived = 0;
+        frame[0] = SUMD_SYNCBYTE;
+        frame[1] = 0x01;
+        frame[2] = counts[i];
+        sumdFrameReceive(frame, sizeof(frame));
+        EXPECT_EQ(0, framesReceived);
+        EXPECT_EQ(SERIAL_RX_FRAME_PENDING, sumdFrameStatus());
+    }
+}
+
+int main(void)
+{
+    RUN_TEST(testValidFrame);
+    RUN_TEST(testBadCrcIgnored);
+    RUN_TEST(testOversizedChannelCountRejected);
+    return UNITTEST_RESULT();
+}
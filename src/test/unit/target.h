@@ -0,0 +1,5 @@
+#pragma once
+
+// src/main/platform.h ends by including target.h; on the host that
+// resolves here and pulls in the stub MCU types.
+#include "platform.h"
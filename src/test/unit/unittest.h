@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int unittestFailures;
+static int unittestChecks;
+
+#define EXPECT_TRUE(cond) do { \
+    unittestChecks++; \
+    if (!(cond)) { \
+        unittestFailures++; \
+        fprintf(stderr, "%s:%d: expected %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+#define EXPECT_EQ(expected, actual) do { \
+    long long unittestExpected = (long long)(expected); \
+    long long unittestActual = (long long)(actual); \
+    unittestChecks++; \
+    if (unittestExpected != unittestActual) { \
+        unittestFailures++; \
+        fprintf(stderr, "%s:%d: %s: expected %lld, got %lld\n", __FILE__, __LINE__, #actual, unittestExpected, unittestActual); \
+    } \
+} while (0)
+
+#define RUN_TEST(test) do { \
+    int unittestBefore = unittestFailures; \
+    test(); \
+    printf("%-48s %s\n", #test, unittestFailures == unittestBefore ? "ok" : "FAILED"); \
+} while (0)
+
+#define UNITTEST_RESULT() (printf("%d checks, %d failures\n", unittestChecks, unittestFailures), unittestFailures ? EXIT_FAILURE : EXIT_SUCCESS)